@@ -52,6 +52,11 @@ BitTorrent::Session *AddTorrentManager::btSession() const
 }
 
 bool AddTorrentManager::addTorrent(const QString &source, const BitTorrent::AddTorrentParams &params)
+{
+    return addTorrent(source, params, Net::RequestPriority::Interactive);
+}
+
+bool AddTorrentManager::addTorrent(const QString &source, const BitTorrent::AddTorrentParams &params, const Net::RequestPriority downloadPriority)
 {
     // `source`: .torrent file path,  magnet URI or URL
 
@@ -63,7 +68,7 @@ bool AddTorrentManager::addTorrent(const QString &source, const BitTorrent::AddT
         LogMsg(tr("Downloading torrent... Source: \"%1\"").arg(source));
         const auto *pref = Preferences::instance();
         // Launch downloader
-        Net::DownloadManager::instance()->download(Net::DownloadRequest(source).limit(pref->getTorrentFileSizeLimit())
+        Net::DownloadManager::instance()->download(Net::DownloadRequest(source).limit(pref->getTorrentFileSizeLimit()).priority(downloadPriority)
                 , pref->useProxyForGeneralPurposes(), this, &AddTorrentManager::onDownloadFinished);
         m_downloadedTorrents[source] = params;
         return true;
@@ -48,6 +48,7 @@ namespace BitTorrent
 
 namespace Net
 {
+    enum class RequestPriority;
     struct DownloadResult;
 }
 
@@ -63,6 +64,8 @@ public:
 
     BitTorrent::Session *btSession() const;
     bool addTorrent(const QString &source, const BitTorrent::AddTorrentParams &params = {});
+    // `downloadPriority` is used if torrent needs to be downloaded from URL
+    bool addTorrent(const QString &source, const BitTorrent::AddTorrentParams &params, Net::RequestPriority downloadPriority);
 
 signals:
     void torrentAdded(const QString &source, BitTorrent::Torrent *torrent);
@@ -0,0 +1,104 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "bandwidthrule.h"
+
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include "base/utils/string.h"
+#include "bandwidthscheduler.h"
+#include "torrent.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+const QString OPTION_CATEGORY = u"category"_s;
+const QString OPTION_TAG = u"tag"_s;
+const QString OPTION_DAYS = u"days"_s;
+const QString OPTION_STARTTIME = u"start_time"_s;
+const QString OPTION_ENDTIME = u"end_time"_s;
+const QString OPTION_UPLOADLIMIT = u"upload_limit"_s;
+const QString OPTION_DOWNLOADLIMIT = u"download_limit"_s;
+
+const QString TIME_FORMAT = u"HH:mm"_s;
+
+bool BitTorrent::BandwidthRule::isValid() const
+{
+    return (!category.isEmpty() || tag.isValid())
+            && startTime.isValid() && endTime.isValid()
+            && (uploadLimit >= 0) && (downloadLimit >= 0);
+}
+
+bool BitTorrent::BandwidthRule::isActive() const
+{
+    return BandwidthScheduler::isInSchedule(startTime, endTime, days);
+}
+
+bool BitTorrent::BandwidthRule::matches(const Torrent &torrent) const
+{
+    if (!category.isEmpty())
+    {
+        const QString torrentCategory = torrent.category();
+        if ((torrentCategory != category) && !torrentCategory.startsWith(category + u'/'))
+            return false;
+    }
+
+    if (tag.isValid() && !torrent.hasTag(tag))
+        return false;
+
+    return true;
+}
+
+BitTorrent::BandwidthRule BitTorrent::BandwidthRule::fromJSON(const QJsonObject &jsonObj)
+{
+    BandwidthRule rule;
+    rule.category = jsonObj.value(OPTION_CATEGORY).toString();
+    rule.tag = Tag(jsonObj.value(OPTION_TAG).toString());
+    rule.days = Utils::String::toEnum<Scheduler::Days>(jsonObj.value(OPTION_DAYS).toString(), Scheduler::Days::EveryDay);
+    if (const QJsonValue startTimeValue = jsonObj.value(OPTION_STARTTIME); startTimeValue.isString())
+        rule.startTime = QTime::fromString(startTimeValue.toString(), TIME_FORMAT);
+    if (const QJsonValue endTimeValue = jsonObj.value(OPTION_ENDTIME); endTimeValue.isString())
+        rule.endTime = QTime::fromString(endTimeValue.toString(), TIME_FORMAT);
+    rule.uploadLimit = jsonObj.value(OPTION_UPLOADLIMIT).toInt(0);
+    rule.downloadLimit = jsonObj.value(OPTION_DOWNLOADLIMIT).toInt(0);
+
+    return rule;
+}
+
+QJsonObject BitTorrent::BandwidthRule::toJSON() const
+{
+    return {
+        {OPTION_CATEGORY, category},
+        {OPTION_TAG, tag.toString()},
+        {OPTION_DAYS, Utils::String::fromEnum(days)},
+        {OPTION_STARTTIME, startTime.toString(TIME_FORMAT)},
+        {OPTION_ENDTIME, endTime.toString(TIME_FORMAT)},
+        {OPTION_UPLOADLIMIT, uploadLimit},
+        {OPTION_DOWNLOADLIMIT, downloadLimit}
+    };
+}
@@ -55,29 +55,24 @@ void BandwidthScheduler::start()
     m_timer.start(30s);
 }
 
-bool BandwidthScheduler::isTimeForAlternative() const
+bool BandwidthScheduler::isInSchedule(QTime startTime, QTime endTime, const Scheduler::Days days)
 {
-    const Preferences *const pref = Preferences::instance();
-
-    QTime start = pref->getSchedulerStartTime();
-    QTime end = pref->getSchedulerEndTime();
     const QTime now = QTime::currentTime();
-    const Scheduler::Days schedulerDays = pref->getSchedulerDays();
     const int day = QDate::currentDate().dayOfWeek();
-    bool alternative = false;
+    bool inSchedule = false;
 
-    if (start > end)
+    if (startTime > endTime)
     {
-        std::swap(start, end);
-        alternative = true;
+        std::swap(startTime, endTime);
+        inSchedule = true;
     }
 
-    if ((start <= now) && (end >= now))
+    if ((startTime <= now) && (endTime >= now))
     {
-        switch (schedulerDays)
+        switch (days)
         {
         case Scheduler::Days::EveryDay:
-            alternative = !alternative;
+            inSchedule = !inSchedule;
             break;
         case Scheduler::Days::Monday:
         case Scheduler::Days::Tuesday:
@@ -88,18 +83,18 @@ bool BandwidthScheduler::isTimeForAlternative() const
         case Scheduler::Days::Sunday:
             {
                 const int offset = static_cast<int>(Scheduler::Days::Monday) - 1;
-                const int dayOfWeek = static_cast<int>(schedulerDays) - offset;
+                const int dayOfWeek = static_cast<int>(days) - offset;
                 if (day == dayOfWeek)
-                    alternative = !alternative;
+                    inSchedule = !inSchedule;
             }
             break;
         case Scheduler::Days::Weekday:
             if ((day >= 1) && (day <= 5))
-                alternative = !alternative;
+                inSchedule = !inSchedule;
             break;
         case Scheduler::Days::Weekend:
             if ((day == 6) || (day == 7))
-                alternative = !alternative;
+                inSchedule = !inSchedule;
             break;
         default:
             Q_UNREACHABLE();
@@ -107,7 +102,13 @@ bool BandwidthScheduler::isTimeForAlternative() const
         }
     }
 
-    return alternative;
+    return inSchedule;
+}
+
+bool BandwidthScheduler::isTimeForAlternative() const
+{
+    const Preferences *const pref = Preferences::instance();
+    return isInSchedule(pref->getSchedulerStartTime(), pref->getSchedulerEndTime(), pref->getSchedulerDays());
 }
 
 void BandwidthScheduler::onTimeout()
@@ -32,6 +32,13 @@
 #include <QObject>
 #include <QTimer>
 
+class QTime;
+
+namespace Scheduler
+{
+    enum class Days : int;
+}
+
 class BandwidthScheduler : public QObject
 {
     Q_OBJECT
@@ -41,6 +48,8 @@ public:
     explicit BandwidthScheduler(QObject *parent = nullptr);
     void start();
 
+    static bool isInSchedule(QTime startTime, QTime endTime, Scheduler::Days days);
+
 signals:
     void bandwidthLimitRequested(bool alternative);
 
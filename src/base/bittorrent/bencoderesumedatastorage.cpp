@@ -151,7 +151,7 @@ BitTorrent::LoadResumeDataResult BitTorrent::BencodeResumeDataStorage::load(cons
     const QString idString = id.toString();
     const Path fastresumePath = path() / Path(idString + u".fastresume");
     const Path torrentFilePath = path() / Path(idString + u".torrent");
-    const qint64 torrentSizeLimit = Preferences::instance()->getTorrentFileSizeLimit();
+    const qint64 torrentSizeLimit = Preferences::instance()->snapshot()->torrentFileSizeLimit;
 
     const auto resumeDataReadResult = Utils::IO::readFile(fastresumePath, -1);
     if (!resumeDataReadResult)
@@ -228,11 +228,11 @@ void BitTorrent::BencodeResumeDataStorage::loadQueue(const Path &queueFilename)
 
 BitTorrent::LoadResumeDataResult BitTorrent::BencodeResumeDataStorage::loadTorrentResumeData(const QByteArray &data, const QByteArray &metadata) const
 {
-    const auto *pref = Preferences::instance();
+    const std::shared_ptr<const Preferences::Snapshot> pref = Preferences::instance()->snapshot();
 
     lt::error_code ec;
     const lt::bdecode_node resumeDataRoot = lt::bdecode(data, ec
-            , nullptr, pref->getBdecodeDepthLimit(), pref->getBdecodeTokenLimit());
+            , nullptr, pref->bdecodeDepthLimit, pref->bdecodeTokenLimit);
     if (ec)
         return nonstd::make_unexpected(tr("Cannot parse resume data: %1").arg(QString::fromStdString(ec.message())));
 
@@ -313,7 +313,7 @@ BitTorrent::LoadResumeDataResult BitTorrent::BencodeResumeDataStorage::loadTorre
     if (!metadata.isEmpty())
     {
         const lt::bdecode_node torrentInfoRoot = lt::bdecode(metadata, ec
-                , nullptr, pref->getBdecodeDepthLimit(), pref->getBdecodeTokenLimit());
+                , nullptr, pref->bdecodeDepthLimit, pref->bdecodeTokenLimit);
         if (ec)
             return nonstd::make_unexpected(tr("Cannot parse torrent info: %1").arg(QString::fromStdString(ec.message())));
 
@@ -322,9 +322,9 @@ BitTorrent::LoadResumeDataResult BitTorrent::BencodeResumeDataStorage::loadTorre
 
 #if LIBTORRENT_VERSION_NUM >= 20100
         const lt::load_torrent_limits limits {
-            .max_buffer_size = static_cast<int>(pref->getTorrentFileSizeLimit()),
-            .max_decode_depth = pref->getBdecodeDepthLimit(),
-            .max_decode_tokens = pref->getBdecodeTokenLimit()};
+            .max_buffer_size = static_cast<int>(pref->torrentFileSizeLimit),
+            .max_decode_depth = pref->bdecodeDepthLimit,
+            .max_decode_tokens = pref->bdecodeTokenLimit};
         const lt::add_torrent_params atp = lt::load_torrent_parsed(torrentInfoRoot, ec, limits);
         if (ec)
             return nonstd::make_unexpected(tr("Cannot parse torrent info: %1").arg(QString::fromStdString(ec.message())));
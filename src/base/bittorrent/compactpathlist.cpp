@@ -0,0 +1,238 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "compactpathlist.h"
+
+#include <algorithm>
+#include <utility>
+
+bool BitTorrent::CompactPathList::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+qsizetype BitTorrent::CompactPathList::size() const
+{
+    return m_entries.size();
+}
+
+void BitTorrent::CompactPathList::reserve(const qsizetype size)
+{
+    m_entries.reserve(size);
+}
+
+void BitTorrent::CompactPathList::clear()
+{
+    m_entries.clear();
+    m_names.clear();
+    m_unusedNamesSize = 0;
+    m_folders.clear();
+    m_folderUsages.clear();
+    m_unusedFoldersCount = 0;
+    m_folderIndexes.clear();
+}
+
+Path BitTorrent::CompactPathList::at(const qsizetype index) const
+{
+    Q_ASSERT((index >= 0) && (index < m_entries.size()));
+    if ((index < 0) || (index >= m_entries.size())) [[unlikely]]
+        return {};
+
+    const Entry &entry = m_entries[index];
+    const QStringView name = QStringView(m_names).sliced(entry.nameOffset, entry.nameLength);
+    if (entry.folderIndex < 0)
+        return Path(name.toString());
+
+    const QString &folder = m_folders[entry.folderIndex];
+    QString pathStr;
+    pathStr.reserve(folder.size() + 1 + name.size());
+    pathStr.append(folder).append(u'/').append(name);
+    return Path(pathStr);
+}
+
+PathList BitTorrent::CompactPathList::toList() const
+{
+    PathList paths;
+    paths.reserve(m_entries.size());
+    for (qsizetype i = 0; i < m_entries.size(); ++i)
+        paths.append(at(i));
+
+    return paths;
+}
+
+Path BitTorrent::CompactPathList::findRootFolder() const
+{
+    if (m_entries.isEmpty())
+        return {};
+
+    // if at least one file has no root folder, no common root folder exists
+    const bool hasFileWithoutFolder = std::ranges::any_of(m_entries, [](const Entry &entry)
+    {
+        return (entry.folderIndex < 0);
+    });
+    if (hasFileWithoutFolder)
+        return {};
+
+    // files share folders so it is enough to check each used folder once
+    QStringView rootFolder;
+    for (qsizetype i = 0; i < m_folders.size(); ++i)
+    {
+        if (m_folderUsages[i] == 0)
+            continue;
+
+        const QStringView folder = m_folders[i];
+        const qsizetype slashIndex = folder.indexOf(u'/');
+        const QStringView topFolder = (slashIndex >= 0) ? folder.first(slashIndex) : folder;
+        if (rootFolder.isNull())
+            rootFolder = topFolder;
+        else if (rootFolder != topFolder)
+            return {};
+    }
+
+    return Path(rootFolder.toString());
+}
+
+void BitTorrent::CompactPathList::append(const Path &path)
+{
+    m_entries.append(makeEntry(path));
+}
+
+void BitTorrent::CompactPathList::replace(const qsizetype index, const Path &path)
+{
+    Q_ASSERT((index >= 0) && (index < m_entries.size()));
+    if ((index < 0) || (index >= m_entries.size())) [[unlikely]]
+        return;
+
+    // new entry is made first so that the folder is reused if the file stays in it
+    const Entry oldEntry = std::exchange(m_entries[index], makeEntry(path));
+    releaseEntry(oldEntry);
+
+    // Renaming many files leaves a lot of stale names and folders behind
+    if (m_unusedNamesSize > (m_names.size() / 2))
+        compactNames();
+    if (m_unusedFoldersCount > (m_folders.size() / 2))
+        compactFolders();
+}
+
+qint64 BitTorrent::CompactPathList::memoryUsage() const
+{
+    qint64 usage = (m_entries.capacity() * sizeof(Entry))
+        + (m_names.capacity() * sizeof(QChar))
+        + (m_folders.capacity() * sizeof(QString))
+        + (m_folderUsages.capacity() * sizeof(qint32));
+    for (const QString &folder : m_folders)
+        usage += folder.capacity() * sizeof(QChar);
+    // each folder name is shared with the lookup table, only the table itself takes extra memory
+    usage += m_folderIndexes.capacity() * (sizeof(QString) + sizeof(qint32));
+
+    return usage;
+}
+
+BitTorrent::CompactPathList::Entry BitTorrent::CompactPathList::makeEntry(const Path &path)
+{
+    const QString pathStr = path.data();
+    const qsizetype slashIndex = pathStr.lastIndexOf(u'/');
+    const QStringView name = (slashIndex >= 0) ? QStringView(pathStr).sliced(slashIndex + 1) : QStringView(pathStr);
+
+    Entry entry {.nameOffset = static_cast<quint32>(m_names.size()), .nameLength = static_cast<quint32>(name.size())};
+    m_names.append(name);
+
+    if (slashIndex >= 0)
+    {
+        const QString folder = pathStr.first(slashIndex);
+        const auto folderIter = m_folderIndexes.constFind(folder);
+        if (folderIter != m_folderIndexes.cend())
+        {
+            entry.folderIndex = folderIter.value();
+            if (m_folderUsages[entry.folderIndex]++ == 0)
+                --m_unusedFoldersCount;
+        }
+        else
+        {
+            entry.folderIndex = static_cast<qint32>(m_folders.size());
+            m_folders.append(folder);
+            m_folderUsages.append(1);
+            m_folderIndexes.insert(folder, entry.folderIndex);
+        }
+    }
+
+    return entry;
+}
+
+void BitTorrent::CompactPathList::releaseEntry(const Entry &entry)
+{
+    m_unusedNamesSize += entry.nameLength;
+    if ((entry.folderIndex >= 0) && (--m_folderUsages[entry.folderIndex] == 0))
+        ++m_unusedFoldersCount;
+}
+
+void BitTorrent::CompactPathList::compactNames()
+{
+    QString names;
+    names.reserve(m_names.size() - m_unusedNamesSize);
+    for (Entry &entry : m_entries)
+    {
+        const auto nameOffset = static_cast<quint32>(names.size());
+        names.append(QStringView(m_names).sliced(entry.nameOffset, entry.nameLength));
+        entry.nameOffset = nameOffset;
+    }
+
+    m_names = std::move(names);
+    m_unusedNamesSize = 0;
+}
+
+void BitTorrent::CompactPathList::compactFolders()
+{
+    QList<qint32> newFolderIndexes(m_folders.size(), -1);
+    QList<QString> folders;
+    folders.reserve(m_folders.size() - m_unusedFoldersCount);
+    QList<qint32> folderUsages;
+    folderUsages.reserve(m_folders.size() - m_unusedFoldersCount);
+    m_folderIndexes.clear();
+    for (qsizetype i = 0; i < m_folders.size(); ++i)
+    {
+        if (m_folderUsages[i] == 0)
+            continue;
+
+        const auto folderIndex = static_cast<qint32>(folders.size());
+        newFolderIndexes[i] = folderIndex;
+        folders.append(m_folders[i]);
+        folderUsages.append(m_folderUsages[i]);
+        m_folderIndexes.insert(m_folders[i], folderIndex);
+    }
+
+    for (Entry &entry : m_entries)
+    {
+        if (entry.folderIndex >= 0)
+            entry.folderIndex = newFolderIndexes[entry.folderIndex];
+    }
+
+    m_folders = std::move(folders);
+    m_folderUsages = std::move(folderUsages);
+    m_unusedFoldersCount = 0;
+}
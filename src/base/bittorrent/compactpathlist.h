@@ -0,0 +1,84 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QtTypes>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "base/path.h"
+
+namespace BitTorrent
+{
+    // Memory efficient storage of torrent file paths.
+    // Parent folders are stored once for all the files they contain, file names are packed
+    // into a single buffer, and Path objects are only created when requested.
+    class CompactPathList
+    {
+    public:
+        bool isEmpty() const;
+        qsizetype size() const;
+        void reserve(qsizetype size);
+        void clear();
+
+        Path at(qsizetype index) const;
+        PathList toList() const;
+        // Same as Path::findRootFolder(toList()) but without building the paths
+        Path findRootFolder() const;
+
+        void append(const Path &path);
+        void replace(qsizetype index, const Path &path);
+
+        // Approximate amount of heap memory used to store the paths, in bytes
+        qint64 memoryUsage() const;
+
+    private:
+        struct Entry
+        {
+            qint32 folderIndex = -1;
+            quint32 nameOffset = 0;
+            quint32 nameLength = 0;
+        };
+
+        Entry makeEntry(const Path &path);
+        void releaseEntry(const Entry &entry);
+        void compactNames();
+        void compactFolders();
+
+        QList<Entry> m_entries;
+        QString m_names;
+        qsizetype m_unusedNamesSize = 0;
+        QList<QString> m_folders;
+        // number of entries in each folder, folders left without entries are removed on compaction
+        QList<qint32> m_folderUsages;
+        qsizetype m_unusedFoldersCount = 0;
+        QHash<QString, qint32> m_folderIndexes;
+    };
+}
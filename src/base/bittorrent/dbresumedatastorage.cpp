@@ -673,9 +673,9 @@ LoadResumeDataResult DBResumeDataStorage::parseQueryResultRow(const QSqlQuery &q
     }
 
     const QByteArray bencodedResumeData = query.value(DB_COLUMN_RESUMEDATA.name).toByteArray();
-    const auto *pref = Preferences::instance();
-    const int bdecodeDepthLimit = pref->getBdecodeDepthLimit();
-    const int bdecodeTokenLimit = pref->getBdecodeTokenLimit();
+    const std::shared_ptr<const Preferences::Snapshot> pref = Preferences::instance()->snapshot();
+    const int bdecodeDepthLimit = pref->bdecodeDepthLimit;
+    const int bdecodeTokenLimit = pref->bdecodeTokenLimit;
 
     lt::error_code ec;
     const lt::bdecode_node resumeDataRoot = lt::bdecode(bencodedResumeData, ec, nullptr, bdecodeDepthLimit, bdecodeTokenLimit);
@@ -698,7 +698,7 @@ LoadResumeDataResult DBResumeDataStorage::parseQueryResultRow(const QSqlQuery &q
 
 #if LIBTORRENT_VERSION_NUM >= 20100
         const lt::load_torrent_limits limits {
-            .max_buffer_size = static_cast<int>(pref->getTorrentFileSizeLimit()),
+            .max_buffer_size = static_cast<int>(pref->torrentFileSizeLimit),
             .max_decode_depth = bdecodeDepthLimit,
             .max_decode_tokens = bdecodeTokenLimit};
         const lt::add_torrent_params atp = lt::load_torrent_parsed(torrentInfoRoot, ec, limits);
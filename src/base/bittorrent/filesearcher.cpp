@@ -28,25 +28,112 @@
 
 #include "filesearcher.h"
 
+#include <vector>
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QPromise>
+#include <QSet>
+#include <QThreadPool>
 
 #include "base/bittorrent/common.h"
+#include "base/logger.h"
 
 namespace
 {
-    bool findInDir(const Path &dirPath, PathList &fileNames, const bool forceAppendExt)
+    // Directories are mostly on local disks but may also be on network storage, where listing is latency bound
+    const int MAX_LISTING_THREADS = 8;
+    // Directories containing fewer files are checked file by file since reading them entirely may cost more
+    const qsizetype MIN_FILES_TO_LIST_DIRECTORY = 8;
+
+    struct DirectoryListing
+    {
+        QSet<QString> entries;
+        // Allows to detect names that may still match on case-insensitive file systems
+        QSet<QString> caseFoldedEntries;
+    };
+
+    // Listings of directories keyed by directory path relative to the searched one
+    using DirectoryListings = QHash<Path, DirectoryListing>;
+
+    DirectoryListing listDirectory(const Path &dirPath)
     {
+        DirectoryListing listing;
+        QDirIterator iter {dirPath.data(), (QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot)};
+        while (iter.hasNext())
+        {
+            iter.next();
+            const QString fileName = iter.fileName();
+            listing.entries.insert(fileName);
+            listing.caseFoldedEntries.insert(fileName.toCaseFolded());
+        }
+
+        return listing;
+    }
+
+    // Each directory containing many of the files is read once instead of checking every file separately
+    DirectoryListings listDirectories(const Path &rootPath, const PathList &fileNames, QThreadPool &threadPool)
+    {
+        QHash<Path, qsizetype> filesCountByDir;
+        for (const Path &fileName : fileNames)
+            ++filesCountByDir[fileName.parentPath()];
+
+        QList<Path> dirPaths;
+        for (auto it = filesCountByDir.cbegin(); it != filesCountByDir.cend(); ++it)
+        {
+            if (it.value() >= MIN_FILES_TO_LIST_DIRECTORY)
+                dirPaths.append(it.key());
+        }
+
+        std::vector<DirectoryListing> dirListings(static_cast<std::size_t>(dirPaths.size()));
+        for (qsizetype i = 0; i < dirPaths.size(); ++i)
+        {
+            threadPool.start([&listing = dirListings[i], dirPath = (rootPath / dirPaths[i])]
+            {
+                listing = listDirectory(dirPath);
+            });
+        }
+        threadPool.waitForDone();
+
+        DirectoryListings listings;
+        listings.reserve(dirPaths.size());
+        for (qsizetype i = 0; i < dirPaths.size(); ++i)
+            listings.insert(dirPaths[i], std::move(dirListings[i]));
+
+        return listings;
+    }
+
+    bool findInDir(const Path &dirPath, PathList &fileNames, const bool forceAppendExt, QThreadPool &threadPool, qsizetype &listedDirsCount)
+    {
+        const DirectoryListings listings = listDirectories(dirPath, fileNames, threadPool);
+        listedDirsCount += listings.size();
+
+        const auto fileExists = [&dirPath, &listings](const Path &fileName)
+        {
+            const auto listingIter = listings.constFind(fileName.parentPath());
+            if (listingIter == listings.cend())
+                return (dirPath / fileName).exists();
+
+            const QString name = fileName.filename();
+            if (listingIter->entries.contains(name))
+                return true;
+
+            // Names differing in case only are left for the file system to decide
+            return listingIter->caseFoldedEntries.contains(name.toCaseFolded()) && (dirPath / fileName).exists();
+        };
+
         bool found = false;
         for (Path &fileName : fileNames)
         {
-            if ((dirPath / fileName).exists())
+            if (fileExists(fileName))
             {
                 found = true;
             }
             else
             {
                 const Path incompleteFilename = fileName + QB_EXT;
-                if ((dirPath / incompleteFilename).exists())
+                if (fileExists(incompleteFilename))
                 {
                     found = true;
                     fileName = incompleteFilename;
@@ -62,17 +149,32 @@ namespace
     }
 }
 
+FileSearcher::FileSearcher(QObject *parent)
+    : QObject(parent)
+    , m_threadPool {new QThreadPool(this)}
+{
+    m_threadPool->setMaxThreadCount(MAX_LISTING_THREADS);
+    m_threadPool->setObjectName("FileSearcher m_threadPool");
+}
+
 void FileSearcher::search(const PathList &originalFileNames, const Path &savePath
         , const Path &downloadPath, const bool forceAppendExt, QPromise<FileSearchResult> &promise)
 {
+    QElapsedTimer timer;
+    timer.start();
+
+    qsizetype listedDirsCount = 0;
     Path usedPath = savePath;
     PathList adjustedFileNames = originalFileNames;
-    const bool found = findInDir(usedPath, adjustedFileNames, (forceAppendExt && downloadPath.isEmpty()));
+    const bool found = findInDir(usedPath, adjustedFileNames, (forceAppendExt && downloadPath.isEmpty()), *m_threadPool, listedDirsCount);
     if (!found && !downloadPath.isEmpty())
     {
         usedPath = downloadPath;
-        findInDir(usedPath, adjustedFileNames, forceAppendExt);
+        findInDir(usedPath, adjustedFileNames, forceAppendExt, *m_threadPool, listedDirsCount);
     }
 
+    LogMsg(tr("Searched for existing files. Files: %1. Directories read: %2. Elapsed time: %3 ms")
+            .arg(QString::number(originalFileNames.size()), QString::number(listedDirsCount), QString::number(timer.elapsed())));
+
     promise.addResult(FileSearchResult {.savePath = usedPath, .fileNames = adjustedFileNames});
 }
@@ -33,6 +33,7 @@
 #include "base/path.h"
 
 template <typename T> class QPromise;
+class QThreadPool;
 
 struct FileSearchResult
 {
@@ -46,8 +47,11 @@ class FileSearcher final : public QObject
     Q_DISABLE_COPY_MOVE(FileSearcher)
 
 public:
-    using QObject::QObject;
+    explicit FileSearcher(QObject *parent = nullptr);
 
     void search(const PathList &originalFileNames, const Path &savePath
             , const Path &downloadPath, bool forceAppendExt, QPromise<FileSearchResult> &promise);
+
+private:
+    QThreadPool *m_threadPool = nullptr;
 };
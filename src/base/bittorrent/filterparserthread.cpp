@@ -28,15 +28,22 @@
 
 #include "filterparserthread.h"
 
+#include <algorithm>
 #include <cctype>
 
 #include <libtorrent/error_code.hpp>
 
+#include <QByteArrayView>
+#include <QCryptographicHash>
 #include <QDataStream>
+#include <QDateTime>
 #include <QFile>
+#include <QThreadPool>
 
 #include "base/global.h"
 #include "base/logger.h"
+#include "base/profile.h"
+#include "base/utils/io.h"
 
 namespace
 {
@@ -105,13 +112,91 @@ namespace
         return !ec;
     }
 
-    const int BUFFER_SIZE = 2 * 1024 * 1024; // 2 MiB
     const int MAX_LOGGED_ERRORS = 5;
+    const qsizetype MIN_CHUNK_SIZE = 4 * 1024 * 1024; // 4 MiB
+
+    const QString CACHE_FILENAME = u"ipfilter.cache"_s;
+    const qint64 MAX_CACHE_SIZE = 512 * 1024 * 1024; // 512 MiB
+    const int CACHE_VERSION = 1;
+    const qint64 FINGERPRINT_SIZE = 64 * 1024; // 64 KiB
+
+    // Splits data into about `count` chunks at line boundaries
+    QList<QByteArrayView> splitIntoChunks(const QByteArrayView data, const qsizetype count)
+    {
+        QList<QByteArrayView> chunks;
+        chunks.reserve(count);
+
+        qsizetype begin = 0;
+        for (qsizetype i = 1; (i <= count) && (begin < data.size()); ++i)
+        {
+            qsizetype end = data.size();
+            if (i < count)
+            {
+                const qsizetype newLinePos = data.indexOf('\n', std::max(begin, (data.size() / count * i)));
+                if (newLinePos != -1)
+                    end = newLinePos + 1;
+            }
+
+            chunks.append(data.sliced(begin, (end - begin)));
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    template <typename Range>
+    void addBlockedRanges(lt::ip_filter &filter, const std::vector<Range> &ranges)
+    {
+        for (const Range &range : ranges)
+        {
+            if (range.flags == lt::ip_filter::blocked)
+                filter.add_rule(range.first, range.last, lt::ip_filter::blocked);
+        }
+    }
+
+    void mergeFilter(lt::ip_filter &filter, const lt::ip_filter &other)
+    {
+        const auto [v4Ranges, v6Ranges] = other.export_filter();
+        addBlockedRanges(filter, v4Ranges);
+        addBlockedRanges(filter, v6Ranges);
+    }
+
+    // Identifies filter file content without reading the whole file
+    QByteArray makeCacheKey(const Path &filePath)
+    {
+        QFile file {filePath.data()};
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+
+        const qint64 fileSize = file.size();
+        const QDateTime lastModified = file.fileTime(QFileDevice::FileModificationTime);
+
+        QCryptographicHash hash {QCryptographicHash::Sha256};
+        hash.addData(QByteArray::number(CACHE_VERSION));
+        hash.addData(filePath.data().toUtf8());
+        hash.addData(QByteArray::number(fileSize));
+        hash.addData(QByteArray::number(lastModified.toMSecsSinceEpoch()));
+        hash.addData(file.read(FINGERPRINT_SIZE));
+        if (fileSize > FINGERPRINT_SIZE)
+        {
+            file.seek(std::max(FINGERPRINT_SIZE, (fileSize - FINGERPRINT_SIZE)));
+            hash.addData(file.read(FINGERPRINT_SIZE));
+        }
+
+        return hash.result();
+    }
+
+    Path cacheFilePath()
+    {
+        return specialFolderLocation(SpecialFolder::Cache) / Path(CACHE_FILENAME);
+    }
 }
 
 FilterParserThread::FilterParserThread(QObject *parent)
     : QThread(parent)
+    , m_threadPool {new QThreadPool(this)}
 {
+    m_threadPool->setObjectName("FilterParserThread m_threadPool");
 }
 
 FilterParserThread::~FilterParserThread()
@@ -120,357 +205,271 @@ FilterParserThread::~FilterParserThread()
     wait();
 }
 
-// Parser for eMule ip filter in DAT format
-int FilterParserThread::parseDATFilterFile()
+struct FilterParserThread::ParsedChunk
 {
-    int ruleCount = 0;
-    QFile file {m_filePath.data()};
-    if (!file.exists()) return ruleCount;
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
-        return ruleCount;
-    }
-
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QList
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
-    int parseErrorCount = 0;
-    const auto addLog = [&parseErrorCount](const QString &msg)
+    struct Error
     {
-        if (parseErrorCount <= MAX_LOGGED_ERRORS)
-            LogMsg(msg, Log::CRITICAL);
+        int line = 0;
+        QString message;  // expects line number as `%1`
     };
 
-    while (true)
+    void addError(const int line, const QString &message)
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
-            break;
+        if (errorCount++ < MAX_LOGGED_ERRORS)
+            errors.append({line, message});
+    }
 
-        for (start = 0; start < dataSize; ++start)
+    void addRule(const int line, const lt::address &first, const lt::address &last)
+    {
+        try
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
-            {
-                for (int i = start; i < dataSize; ++i)
-                {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
-            }
-
-            if (endOfLine == -1)
-            {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
-                break;
-            }
-
-            ++nbLine;
-
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-            {
-                start = endOfLine;
-                continue;
-            }
-
-            // Each line should follow this format:
-            // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
-            // The 3rd entry is access level and if above 127 the IP range isn't blocked.
-            const int firstComma = findAndNullDelimiter(buffer.data(), ',', start, endOfLine);
-            if (firstComma != -1)
-                findAndNullDelimiter(buffer.data(), ',', firstComma + 1, endOfLine);
-
-            // Check if there is an access value (apparently not mandatory)
-            if (firstComma != -1)
-            {
-                // There is possibly one
-                const long int nbAccess = strtol(buffer.data() + firstComma + 1, nullptr, 10);
-                // Ignoring this rule because access value is too high
-                if (nbAccess > 127L)
-                {
-                    start = endOfLine;
-                    continue;
-                }
-            }
-
-            // IP Range should be split by a dash
-            const int endOfIPRange = ((firstComma == -1) ? (endOfLine - 1) : (firstComma - 1));
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', start, endOfIPRange);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+            filter.add_rule(first, last, lt::ip_filter::blocked);
+            ++ruleCount;
+        }
+        catch (const std::exception &e)
+        {
+            addError(line, FilterParserThread::tr("IP filter exception thrown for line %1. Exception is: %2")
+                    .arg(u"%1"_s, QString::fromLocal8Bit(e.what())));
+        }
+    }
 
-            lt::address startAddr;
-            int newStart = trim(buffer.data(), start, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    lt::ip_filter filter;
+    int ruleCount = 0;
+    int lineCount = 0;
+    int errorCount = 0;
+    QList<Error> errors;
+};
 
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfIPRange);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+// Parser for eMule ip filter in DAT format
+void FilterParserThread::parseDATLine(char *const line, const int lineEnd, const int lineNum, ParsedChunk &chunk)
+{
+    if ((line[0] == '#') || ((line[0] == '/') && (line[1] == '/')))
+        return;
+
+    // Each line should follow this format:
+    // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
+    // The 3rd entry is access level and if above 127 the IP range isn't blocked.
+    const int firstComma = findAndNullDelimiter(line, ',', 0, lineEnd);
+    if (firstComma != -1)
+        findAndNullDelimiter(line, ',', firstComma + 1, lineEnd);
+
+    // Check if there is an access value (apparently not mandatory)
+    if (firstComma != -1)
+    {
+        // There is possibly one
+        const long int nbAccess = strtol(line + firstComma + 1, nullptr, 10);
+        // Ignoring this rule because access value is too high
+        if (nbAccess > 127L)
+            return;
+    }
 
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    // IP Range should be split by a dash
+    const int endOfIPRange = ((firstComma == -1) ? (lineEnd - 1) : (firstComma - 1));
+    const int delimIP = findAndNullDelimiter(line, '-', 0, endOfIPRange);
+    if (delimIP == -1)
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed."));
+        return;
+    }
 
-            if (startAddr > endAddr)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP is lower than Start IP!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    lt::address startAddr;
+    int newStart = trim(line, 0, delimIP - 1);
+    if (!parseIPAddress(line + newStart, startAddr))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. Start IP of the range is malformed."));
+        return;
+    }
 
-            start = endOfLine;
+    lt::address endAddr;
+    newStart = trim(line, delimIP + 1, endOfIPRange);
+    if (!parseIPAddress(line + newStart, endAddr))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. End IP of the range is malformed."));
+        return;
+    }
 
-            // Now Add to the filter
-            try
-            {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
-                ++ruleCount;
-            }
-            catch (const std::exception &e)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
-            }
-        }
+    if ((startAddr.is_v4() != endAddr.is_v4())
+        || (startAddr.is_v6() != endAddr.is_v6()))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!"));
+        return;
+    }
 
-        if (start >= dataSize)
-            offset = 0;
+    if (startAddr > endAddr)
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. End IP is lower than Start IP!"));
+        return;
     }
 
-    if (parseErrorCount > MAX_LOGGED_ERRORS)
-        LogMsg(tr("%1 extra IP filter parsing errors occurred.", "513 extra IP filter parsing errors occurred.")
-               .arg(parseErrorCount - MAX_LOGGED_ERRORS), Log::CRITICAL);
-    return ruleCount;
+    chunk.addRule(lineNum, startAddr, endAddr);
 }
 
 // Parser for PeerGuardian ip filter in p2p format
-int FilterParserThread::parseP2PFilterFile()
+void FilterParserThread::parseP2PLine(char *const line, const int lineEnd, const int lineNum, ParsedChunk &chunk)
 {
-    int ruleCount = 0;
-    QFile file {m_filePath.data()};
-    if (!file.exists()) return ruleCount;
+    if ((line[0] == '#') || ((line[0] == '/') && (line[1] == '/')))
+        return;
+
+    // Each line should follow this format:
+    // for IPv4: Some:Org:Label:1.0.0.0-1.255.255.255
+    // for IPv6: My:Company:Label:2001:db8::1-2001:db8::ff
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    const int delimIP = findAndNullDelimiter(line, '-', 0, lineEnd, true);
+    if (delimIP == -1)
     {
-        LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
-        return ruleCount;
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed."));
+        return;
     }
 
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QList
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
-    int parseErrorCount = 0;
-    const auto addLog = [&parseErrorCount](const QString &msg)
+    lt::address wholeAddr;
+    const int wholeStart = trim(line, 0, (delimIP - 1));
+    if (parseIPAddress((line + wholeStart), wholeAddr))
     {
-        if (parseErrorCount <= MAX_LOGGED_ERRORS)
-            LogMsg(msg, Log::CRITICAL);
-    };
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed."));
+        return;
+    }
 
-    while (true)
+    int partsDelimiter = -1;
+    int searchStart = 0;
+
+    while (searchStart < delimIP)
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
+        const int nextColon = findAndNullDelimiter(line, ':', searchStart, delimIP, false);
+        if (nextColon == -1)
             break;
 
-        for (start = 0; start < dataSize; ++start)
+        lt::address testAddr;
+        const int testStart = trim(line, (nextColon + 1), (delimIP - 1));
+
+        if (parseIPAddress((line + testStart), testAddr))
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
-            {
-                for (int i = start; i < dataSize; ++i)
-                {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
-            }
+            // We found valid IP
+            partsDelimiter = nextColon;
+            break;
+        }
 
-            if (endOfLine == -1)
-            {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
-                break;
-            }
+        // Cleanup for next iteration
+        line[nextColon] = ':';
+        searchStart = nextColon + 1;
+    }
 
-            ++nbLine;
+    if (partsDelimiter == -1)
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed."));
+        return;
+    }
 
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-                {
-                start = endOfLine;
-                continue;
-            }
+    lt::address startAddr;
+    int newStart = trim(line, partsDelimiter + 1, delimIP - 1);
+    if (!parseIPAddress(line + newStart, startAddr))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. Start IP of the range is malformed."));
+        return;
+    }
 
-            // Each line should follow this format:
-            // for IPv4: Some:Org:Label:1.0.0.0-1.255.255.255
-            // for IPv6: My:Company:Label:2001:db8::1-2001:db8::ff
+    lt::address endAddr;
+    newStart = trim(line, delimIP + 1, lineEnd);
+    if (!parseIPAddress(line + newStart, endAddr))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. End IP of the range is malformed."));
+        return;
+    }
 
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', start, endOfLine, true);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    if ((startAddr.is_v4() != endAddr.is_v4())
+        || (startAddr.is_v6() != endAddr.is_v6()))
+    {
+        chunk.addError(lineNum, tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!"));
+        return;
+    }
 
-            lt::address wholeAddr;
-            const int wholeStart = trim(buffer.data(), start, (delimIP - 1));
-            if (parseIPAddress((buffer.data() + wholeStart), wholeAddr))
-            {
-                 ++parseErrorCount;
-                 addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                 start = endOfLine;
-                 continue;
-            }
+    chunk.addRule(lineNum, startAddr, endAddr);
+}
 
-            int partsDelimiter = -1;
-            int searchStart = start;
+void FilterParserThread::parseChunk(const QByteArrayView data, const LineParser parseLine, ParsedChunk &chunk) const
+{
+    // Lines are copied into a writable buffer since parsers split them in place
+    std::vector<char> buffer;
+    qsizetype start = 0;
+    while ((start < data.size()) && !m_abort)
+    {
+        qsizetype end = data.indexOf('\n', start);
+        if (end == -1)
+            end = data.size();
 
-            while (searchStart < delimIP)
-            {
-                const int nextColon = findAndNullDelimiter(buffer.data(), ':', searchStart, delimIP, false);
-                if (nextColon == -1)
-                    break;
+        QByteArrayView line = data.sliced(start, (end - start));
+        if (line.endsWith('\r'))
+            line.chop(1);
 
-                lt::address testAddr;
-                const int testStart = trim(buffer.data(), (nextColon + 1), (delimIP - 1));
+        buffer.assign(line.begin(), line.end());
+        buffer.push_back('\0');
+        // Comment detection peeks at the second character
+        buffer.push_back('\0');
 
-                if (parseIPAddress((buffer.data() + testStart), testAddr))
-                {
-                    // We found valid IP
-                    partsDelimiter = nextColon;
-                    break;
-                }
+        ++chunk.lineCount;
+        parseLine(buffer.data(), static_cast<int>(line.size()), chunk.lineCount, chunk);
 
-                // Cleanup for next iteration
-                buffer[nextColon] = ':';
-                searchStart = nextColon + 1;
-            }
+        start = end + 1;
+    }
+}
 
-            if (partsDelimiter == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+int FilterParserThread::parseTextFilterFile(const LineParser parseLine)
+{
+    QFile file {m_filePath.data()};
+    if (!file.exists()) return 0;
 
-            lt::address startAddr;
-            int newStart = trim(buffer.data(), partsDelimiter + 1, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
+        return 0;
+    }
 
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfLine);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    const qint64 fileSize = file.size();
+    if (fileSize <= 0)
+        return 0;
 
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    QByteArray fileData;
+    QByteArrayView data;
+    if (const uchar *mappedData = file.map(0, fileSize))
+    {
+        data = QByteArrayView(mappedData, fileSize);
+    }
+    else
+    {
+        // mapping isn't supported by every file system
+        fileData = file.readAll();
+        data = fileData;
+    }
+
+    const QList<QByteArrayView> chunksData = splitIntoChunks(data
+            , std::clamp<qsizetype>((data.size() / MIN_CHUNK_SIZE), 1, m_threadPool->maxThreadCount()));
+    std::vector<ParsedChunk> chunks(chunksData.size());
+    for (qsizetype i = 0; i < chunksData.size(); ++i)
+    {
+        m_threadPool->start([this, parseLine, chunkData = chunksData[i], &chunk = chunks[i]]
+        {
+            parseChunk(chunkData, parseLine, chunk);
+        });
+    }
+    m_threadPool->waitForDone();
 
-            start = endOfLine;
+    if (m_abort)
+        return 0;
 
-            try
-            {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
-                ++ruleCount;
-            }
-            catch (const std::exception &e)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
-            }
+    int ruleCount = 0;
+    int parseErrorCount = 0;
+    int lineOffset = 0;
+    for (const ParsedChunk &chunk : chunks)
+    {
+        for (const ParsedChunk::Error &error : chunk.errors)
+        {
+            if (++parseErrorCount <= MAX_LOGGED_ERRORS)
+                LogMsg(error.message.arg(lineOffset + error.line), Log::CRITICAL);
         }
+        parseErrorCount += (chunk.errorCount - chunk.errors.size());
 
-        if (start >= dataSize)
-            offset = 0;
+        mergeFilter(m_filter, chunk.filter);
+        ruleCount += chunk.ruleCount;
+        lineOffset += chunk.lineCount;
     }
 
     if (parseErrorCount > MAX_LOGGED_ERRORS)
@@ -657,21 +656,30 @@ lt::ip_filter FilterParserThread::IPfilter()
 void FilterParserThread::run()
 {
     qDebug("Processing filter file");
+    const QByteArray cacheKey = makeCacheKey(m_filePath);
     int ruleCount = 0;
-    if (m_filePath.hasExtension(u".p2p"_s))
+    if (cacheKey.isEmpty() || !loadCachedFilter(cacheKey, ruleCount))
     {
-        // PeerGuardian p2p file
-        ruleCount = parseP2PFilterFile();
-    }
-    else if (m_filePath.hasExtension(u".p2b"_s))
-    {
-        // PeerGuardian p2b file
-        ruleCount = parseP2BFilterFile();
-    }
-    else if (m_filePath.hasExtension(u".dat"_s))
-    {
-        // eMule DAT format
-        ruleCount = parseDATFilterFile();
+        if (m_filePath.hasExtension(u".p2p"_s))
+        {
+            // PeerGuardian p2p file
+            ruleCount = parseTextFilterFile(&FilterParserThread::parseP2PLine);
+        }
+        else if (m_filePath.hasExtension(u".p2b"_s))
+        {
+            // PeerGuardian p2b file
+            ruleCount = parseP2BFilterFile();
+        }
+        else if (m_filePath.hasExtension(u".dat"_s))
+        {
+            // eMule DAT format
+            ruleCount = parseTextFilterFile(&FilterParserThread::parseDATLine);
+        }
+
+        if (m_abort) return;
+
+        if (!cacheKey.isEmpty() && (ruleCount > 0))
+            storeCachedFilter(cacheKey, ruleCount);
     }
 
     if (m_abort) return;
@@ -688,6 +696,87 @@ void FilterParserThread::run()
     qDebug("IP Filter thread: finished parsing, filter applied");
 }
 
+// Cache stores the resulting blocked ranges so unchanged filter files don't need to be parsed again
+bool FilterParserThread::loadCachedFilter(const QByteArray &cacheKey, int &ruleCount)
+{
+    const auto readResult = Utils::IO::readFile(cacheFilePath(), MAX_CACHE_SIZE);
+    if (!readResult)
+        return false;
+
+    QDataStream stream {readResult.value()};
+    QByteArray storedKey;
+    qint32 storedRuleCount = 0;
+    stream >> storedKey >> storedRuleCount;
+    if ((stream.status() != QDataStream::Ok) || (storedKey != cacheKey))
+        return false;
+
+    lt::ip_filter filter;
+
+    quint32 v4Count = 0;
+    stream >> v4Count;
+    for (quint32 i = 0; (i < v4Count) && (stream.status() == QDataStream::Ok); ++i)
+    {
+        quint32 first = 0;
+        quint32 last = 0;
+        stream >> first >> last;
+        filter.add_rule(lt::address_v4(first), lt::address_v4(last), lt::ip_filter::blocked);
+    }
+
+    quint32 v6Count = 0;
+    stream >> v6Count;
+    for (quint32 i = 0; (i < v6Count) && (stream.status() == QDataStream::Ok); ++i)
+    {
+        lt::address_v6::bytes_type first;
+        lt::address_v6::bytes_type last;
+        stream.readRawData(reinterpret_cast<char *>(first.data()), first.size());
+        stream.readRawData(reinterpret_cast<char *>(last.data()), last.size());
+        filter.add_rule(lt::address_v6(first), lt::address_v6(last), lt::ip_filter::blocked);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        LogMsg(tr("Cached IP filter is corrupted. Parsing IP filter file again."), Log::WARNING);
+        return false;
+    }
+
+    m_filter = std::move(filter);
+    ruleCount = storedRuleCount;
+    return true;
+}
+
+void FilterParserThread::storeCachedFilter(const QByteArray &cacheKey, const int ruleCount) const
+{
+    const auto [v4Ranges, v6Ranges] = m_filter.export_filter();
+
+    QByteArray data;
+    QDataStream stream {&data, QIODevice::WriteOnly};
+    stream << cacheKey << static_cast<qint32>(ruleCount);
+
+    const auto v4Blocked = std::ranges::count(v4Ranges, lt::ip_filter::blocked, &lt::ip_range<lt::address_v4>::flags);
+    stream << static_cast<quint32>(v4Blocked);
+    for (const lt::ip_range<lt::address_v4> &range : v4Ranges)
+    {
+        if (range.flags == lt::ip_filter::blocked)
+            stream << static_cast<quint32>(range.first.to_uint()) << static_cast<quint32>(range.last.to_uint());
+    }
+
+    const auto v6Blocked = std::ranges::count(v6Ranges, lt::ip_filter::blocked, &lt::ip_range<lt::address_v6>::flags);
+    stream << static_cast<quint32>(v6Blocked);
+    for (const lt::ip_range<lt::address_v6> &range : v6Ranges)
+    {
+        if (range.flags != lt::ip_filter::blocked)
+            continue;
+
+        const lt::address_v6::bytes_type first = range.first.to_bytes();
+        const lt::address_v6::bytes_type last = range.last.to_bytes();
+        stream.writeRawData(reinterpret_cast<const char *>(first.data()), first.size());
+        stream.writeRawData(reinterpret_cast<const char *>(last.data()), last.size());
+    }
+
+    if (const auto result = Utils::IO::saveToFile(cacheFilePath(), data); !result)
+        LogMsg(tr("Failed to save IP filter cache. Error: \"%1\"").arg(result.error()), Log::WARNING);
+}
+
 int FilterParserThread::findAndNullDelimiter(char *const data, const char delimiter, const int start, const int end, const bool reverse)
 {
     if (!reverse)
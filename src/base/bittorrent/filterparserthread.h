@@ -28,13 +28,17 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <libtorrent/ip_filter.hpp>
 
 #include <QThread>
 
 #include "base/path.h"
 
+class QByteArrayView;
 class QDataStream;
+class QThreadPool;
 
 class FilterParserThread final : public QThread
 {
@@ -55,14 +59,22 @@ protected:
     void run() override;
 
 private:
-    int findAndNullDelimiter(char *data, char delimiter, int start, int end, bool reverse = false);
-    int trim(char *data, int start, int end);
-    int parseDATFilterFile();
-    int parseP2PFilterFile();
+    struct ParsedChunk;
+    using LineParser = void (*)(char *line, int lineEnd, int lineNum, ParsedChunk &chunk);
+
+    static int findAndNullDelimiter(char *data, char delimiter, int start, int end, bool reverse = false);
+    static int trim(char *data, int start, int end);
+    static void parseDATLine(char *line, int lineEnd, int lineNum, ParsedChunk &chunk);
+    static void parseP2PLine(char *line, int lineEnd, int lineNum, ParsedChunk &chunk);
+    void parseChunk(QByteArrayView data, LineParser parseLine, ParsedChunk &chunk) const;
+    int parseTextFilterFile(LineParser parseLine);
     int getlineInStream(QDataStream &stream, std::string &name, char delim);
     int parseP2BFilterFile();
+    bool loadCachedFilter(const QByteArray &cacheKey, int &ruleCount);
+    void storeCachedFilter(const QByteArray &cacheKey, int ruleCount) const;
 
-    bool m_abort = false;
+    std::atomic_bool m_abort = false;
     Path m_filePath;
+    QThreadPool *m_threadPool = nullptr;
     lt::ip_filter m_filter;
 };
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include <libtorrent/version.hpp>
 
 #include <QtContainerFwd>
@@ -43,8 +45,11 @@
 #include "trackerentry.h"
 #include "trackerentrystatus.h"
 
+class QByteArray;
 class QString;
 
+template <typename T> class QFuture;
+
 namespace BitTorrent
 {
     class InfoHash;
@@ -52,6 +57,8 @@ namespace BitTorrent
     class TorrentDescriptor;
     class TorrentID;
     class TorrentInfo;
+    class TransferHistory;
+    struct BandwidthRule;
     struct CacheStatus;
     struct SessionStatus;
 
@@ -257,6 +264,8 @@ namespace BitTorrent
         virtual void setAltGlobalSpeedLimitEnabled(bool enabled) = 0;
         virtual bool isBandwidthSchedulerEnabled() const = 0;
         virtual void setBandwidthSchedulerEnabled(bool enabled) = 0;
+        virtual QList<BandwidthRule> bandwidthRules() const = 0;
+        virtual void setBandwidthRules(const QList<BandwidthRule> &rules) = 0;
 
         virtual bool isPerformanceWarningEnabled() const = 0;
         virtual void setPerformanceWarningEnabled(bool enable) = 0;
@@ -264,6 +273,14 @@ namespace BitTorrent
         virtual void setSaveResumeDataInterval(int value) = 0;
         virtual std::chrono::minutes saveStatisticsInterval() const = 0;
         virtual void setSaveStatisticsInterval(std::chrono::minutes value) = 0;
+        // Series: "session" (all traffic), "payload" and "category:<name>" (payload, if enabled)
+        virtual const TransferHistory &transferHistory() const = 0;
+        virtual bool isTransferHistoryByCategoryEnabled() const = 0;
+        virtual void setTransferHistoryByCategoryEnabled(bool enabled) = 0;
+        // Session counters and gauges in Prometheus text exposition format
+        virtual QByteArray metrics() const = 0;
+        virtual bool isMetricsByCategoryEnabled() const = 0;
+        virtual void setMetricsByCategoryEnabled(bool enabled) = 0;
         virtual int shutdownTimeout() const = 0;
         virtual void setShutdownTimeout(int value) = 0;
         virtual int port() const = 0;
@@ -471,6 +488,8 @@ namespace BitTorrent
 
         virtual bool isKnownTorrent(const InfoHash &infoHash) const = 0;
         virtual bool addTorrent(const TorrentDescriptor &torrentDescr, const AddTorrentParams &params = {}) = 0;
+        // Adds many torrents at once. Resulting future provides info hashes of the torrents that were actually added.
+        virtual QFuture<QList<InfoHash>> addTorrents(const QList<std::pair<TorrentDescriptor, AddTorrentParams>> &torrents) = 0;
         virtual bool removeTorrent(const TorrentID &id, TorrentRemoveOption deleteOption = TorrentRemoveOption::KeepContent) = 0;
         virtual bool downloadMetadata(const TorrentDescriptor &torrentDescr) = 0;
         virtual bool cancelDownloadMetadata(const TorrentID &id) = 0;
@@ -33,6 +33,7 @@
 #include <concepts>
 #include <cstdint>
 #include <ctime>
+#include <iterator>
 #include <ranges>
 #include <string>
 
@@ -92,6 +93,7 @@
 #include "base/utils/io.h"
 #include "base/utils/net.h"
 #include "base/utils/number.h"
+#include "base/utils/prometheus.h"
 #include "base/utils/random.h"
 #include "base/utils/string.h"
 #include "base/version.h"
@@ -119,9 +121,17 @@ using namespace std::chrono_literals;
 using namespace BitTorrent;
 
 const Path CATEGORIES_FILE_NAME {u"categories.json"_s};
+const Path BANDWIDTH_RULES_FILE_NAME {u"bandwidth_rules.json"_s};
 const Path ADDITIONAL_TRACKERS_FROM_URL_FILE_NAME {u"additional_trackers_from_url.txt"_s};
+const Path TRANSFER_HISTORY_FILE_NAME {u"transfer_history.dat"_s};
+const QString TRANSFER_HISTORY_SESSION_SERIES = u"session"_s;
+const QString TRANSFER_HISTORY_PAYLOAD_SERIES = u"payload"_s;
+const QString TRANSFER_HISTORY_CATEGORY_PREFIX = u"category:"_s;
 const int MAX_PROCESSING_RESUMEDATA_COUNT = 50;
 const std::chrono::seconds FREEDISKSPACE_CHECK_TIMEOUT = 30s;
+const int MAX_BULK_ADD_IN_PROGRESS = 100;
+const int BULK_ADD_PROGRESS_STEP = 1000;
+const qsizetype BULK_ADD_MIN_CHUNK_SIZE = 64;
 
 namespace
 {
@@ -372,8 +382,97 @@ namespace
         return hasMetadata ? getInfoHash(*addTorrentParams.ti) : InfoHash(addTorrentParams.info_hash);
     }
  #endif
+
+    PathList initFilePaths(const TorrentInfo &torrentInfo, const TorrentContentLayout contentLayout)
+    {
+        PathList filePaths = torrentInfo.filePaths();
+        if (contentLayout != TorrentContentLayout::Original)
+        {
+            const Path originalRootFolder = Path::findRootFolder(filePaths);
+            const auto originalContentLayout = (originalRootFolder.isEmpty()
+                    ? TorrentContentLayout::NoSubfolder : TorrentContentLayout::Subfolder);
+            if (contentLayout != originalContentLayout)
+            {
+                if (contentLayout == TorrentContentLayout::NoSubfolder)
+                    Path::stripRootFolder(filePaths);
+                else
+                    Path::addRootFolder(filePaths, filePaths.at(0).removedExtension());
+            }
+        }
+
+        return filePaths;
+    }
+
+    void filterFileNames(const Utils::WildcardMatcher &matcher, const PathList &files, QList<DownloadPriority> &priorities)
+    {
+        priorities.resize(files.count(), DownloadPriority::Normal);
+        if (matcher.isEmpty())
+            return;
+
+        // Torrents usually contain many files per folder, so folder verdicts are cached
+        // to test each distinct path component only once
+        QHash<Path, bool> excludedFolders;
+        const auto isFilenameExcluded = [&matcher, &excludedFolders](const Path &filePath)
+        {
+            if (matcher.match(filePath.filename()))
+                return true;
+
+            bool excluded = false;
+            QList<Path> uncachedFolders;
+            for (Path folder = filePath.parentPath(); !folder.isEmpty(); folder = folder.parentPath())
+            {
+                if (const auto iter = excludedFolders.constFind(folder); iter != excludedFolders.cend())
+                {
+                    excluded = iter.value();
+                    break;
+                }
+
+                uncachedFolders.append(folder);
+            }
+
+            // folder is excluded if either its name or any of its parent folders is excluded
+            for (auto iter = uncachedFolders.crbegin(); iter != uncachedFolders.crend(); ++iter)
+            {
+                excluded = excluded || matcher.match(iter->filename());
+                excludedFolders.insert(*iter, excluded);
+            }
+
+            return excluded;
+        };
+
+        for (qsizetype i = 0; i < priorities.size(); ++i)
+        {
+            if (priorities[i] == BitTorrent::DownloadPriority::Ignored)
+                continue;
+
+            if (isFilenameExcluded(files.at(i)))
+                priorities[i] = BitTorrent::DownloadPriority::Ignored;
+        }
+    }
 }
 
+struct BitTorrent::SessionImpl::BulkAddContext
+{
+    struct Item
+    {
+        TorrentDescriptor torrentDescr;
+        AddTorrentParams params;
+    };
+
+    std::vector<Item> items;
+    std::atomic_int pendingChunks = 0;
+    qsizetype total = 0;
+    qsizetype nextIndex = 0;
+    qsizetype inProgress = 0;
+    qsizetype added = 0;
+    qsizetype failed = 0;
+    qsizetype skipped = 0;
+    qsizetype loggedProgressSteps = 0;
+    QList<InfoHash> addedInfoHashes;
+    QPromise<QList<InfoHash>> promise;
+    QElapsedTimer timer;
+};
+
 struct BitTorrent::SessionImpl::ResumeSessionContext final : public QObject
 {
     using QObject::QObject;
@@ -555,6 +654,8 @@ SessionImpl::SessionImpl(QObject *parent)
     , m_isPerformanceWarningEnabled(BITTORRENT_SESSION_KEY(u"PerformanceWarning"_s), false)
     , m_saveResumeDataInterval(BITTORRENT_SESSION_KEY(u"SaveResumeDataInterval"_s), 60)
     , m_saveStatisticsInterval(BITTORRENT_SESSION_KEY(u"SaveStatisticsInterval"_s), 15)
+    , m_isTransferHistoryByCategoryEnabled(BITTORRENT_SESSION_KEY(u"TransferHistoryByCategory"_s), false)
+    , m_isMetricsByCategoryEnabled(BITTORRENT_SESSION_KEY(u"MetricsByCategory"_s), false)
     , m_shutdownTimeout(BITTORRENT_SESSION_KEY(u"ShutdownTimeout"_s), -1)
     , m_port(BITTORRENT_SESSION_KEY(u"Port"_s), -1)
     , m_sslEnabled(BITTORRENT_SESSION_KEY(u"SSL/Enabled"_s), false)
@@ -604,8 +705,11 @@ SessionImpl::SessionImpl(QObject *parent)
     , m_startPaused {BITTORRENT_SESSION_KEY(u"StartPaused"_s)}
     , m_seedingLimitTimer {new QTimer(this)}
     , m_resumeDataTimer {new QTimer(this)}
+    , m_bandwidthRulesTimer {new QTimer(this)}
     , m_ioThread {new QThread}
+    , m_bulkIOThread {new QThread}
     , m_asyncWorker {new QThreadPool(this)}
+    , m_bulkAddThreadPool {new QThreadPool(this)}
     , m_recentErroredTorrentsTimer {new QTimer(this)}
     , m_freeDiskSpaceChecker {new FreeDiskSpaceChecker(savePath())}
     , m_freeDiskSpaceCheckingTimer {new QTimer(this)}
@@ -620,6 +724,7 @@ SessionImpl::SessionImpl(QObject *parent)
     // It is required to perform async access to libtorrent sequentially
     m_asyncWorker->setMaxThreadCount(1);
     m_asyncWorker->setObjectName("SessionImpl m_asyncWorker");
+    m_bulkAddThreadPool->setObjectName("SessionImpl m_bulkAddThreadPool");
 
     m_alerts.reserve(1024);
 
@@ -637,6 +742,9 @@ SessionImpl::SessionImpl(QObject *parent)
     connect(m_recentErroredTorrentsTimer, &QTimer::timeout
         , this, [this]() { m_recentErroredTorrents.clear(); });
 
+    m_bandwidthRulesTimer->setInterval(5s);
+    connect(m_bandwidthRulesTimer, &QTimer::timeout, this, &SessionImpl::applyBandwidthRules);
+
     m_seedingLimitTimer->setInterval(10s);
     connect(m_seedingLimitTimer, &QTimer::timeout, this, [this]
     {
@@ -654,6 +762,7 @@ SessionImpl::SessionImpl(QObject *parent)
         enableBandwidthScheduler();
 
     loadCategories();
+    loadBandwidthRules();
 
     const QStringList storedTags = m_storedTags.get();
     for (const QString &tagStr : storedTags)
@@ -665,7 +774,7 @@ SessionImpl::SessionImpl(QObject *parent)
     updateShareLimitsTimer();
     populateAdditionalTrackers();
     if (isExcludedFileNamesEnabled())
-        populateExcludedFileNamesRegExpList();
+        populateExcludedFileNamesMatcher();
 
     connect(Net::ProxyConfigurationManager::instance()
         , &Net::ProxyConfigurationManager::proxyConfigurationChanged
@@ -675,7 +784,10 @@ SessionImpl::SessionImpl(QObject *parent)
     connect(m_ioThread.get(), &QThread::finished, m_freeDiskSpaceChecker, &QObject::deleteLater);
     m_freeDiskSpaceCheckingTimer->setInterval(FREEDISKSPACE_CHECK_TIMEOUT);
     m_freeDiskSpaceCheckingTimer->setSingleShot(true);
-    connect(m_freeDiskSpaceCheckingTimer, &QTimer::timeout, m_freeDiskSpaceChecker, &FreeDiskSpaceChecker::check);
+    connect(m_freeDiskSpaceCheckingTimer, &QTimer::timeout, this, [this]
+    {
+        invokeIOJob(m_freeDiskSpaceChecker, m_ioJobCounters, [checker = m_freeDiskSpaceChecker] { checker->check(); });
+    });
     connect(m_freeDiskSpaceChecker, &FreeDiskSpaceChecker::checked, this, [this](const qint64 value)
     {
         m_freeDiskSpace = value;
@@ -688,17 +800,20 @@ SessionImpl::SessionImpl(QObject *parent)
     connect(m_ioThread.get(), &QThread::finished, m_fileSearcher, &QObject::deleteLater);
 
     m_torrentContentRemover = new TorrentContentRemover;
-    m_torrentContentRemover->moveToThread(m_ioThread.get());
-    connect(m_ioThread.get(), &QThread::finished, m_torrentContentRemover, &QObject::deleteLater);
+    m_torrentContentRemover->moveToThread(m_bulkIOThread.get());
+    connect(m_bulkIOThread.get(), &QThread::finished, m_torrentContentRemover, &QObject::deleteLater);
     connect(m_torrentContentRemover, &TorrentContentRemover::jobFinished, this, &SessionImpl::torrentContentRemovingFinished);
 
     m_ioThread->setObjectName("SessionImpl m_ioThread");
     m_ioThread->start();
+    m_bulkIOThread->setObjectName("SessionImpl m_bulkIOThread");
+    m_bulkIOThread->start(QThread::LowPriority);
 
-    QMetaObject::invokeMethod(m_freeDiskSpaceChecker, &FreeDiskSpaceChecker::check);
+    invokeIOJob(m_freeDiskSpaceChecker, m_ioJobCounters, [checker = m_freeDiskSpaceChecker] { checker->check(); });
 
     initMetrics();
     loadStatistics();
+    loadTransferHistory();
 
     // initialize PortForwarder instance
     new PortForwarderImpl(this);
@@ -739,6 +854,7 @@ SessionImpl::~SessionImpl()
     saveResumeData();
 
     saveStatistics();
+    saveTransferHistory();
 
     // We must delete FilterParserThread
     // before we delete lt::session
@@ -753,6 +869,9 @@ SessionImpl::~SessionImpl()
     m_asyncWorker->clear();
     m_asyncWorker->waitForDone();
 
+    m_bulkAddThreadPool->clear();
+    m_bulkAddThreadPool->waitForDone();
+
     auto *nativeSessionProxy = new lt::session_proxy(m_nativeSession->abort());
     delete m_nativeSession;
 
@@ -1142,6 +1261,14 @@ bool SessionImpl::removeCategory(const QString &name)
         // update stored categories
         storeCategories();
         emit categoryRemoved(name);
+
+        const QString seriesName = TRANSFER_HISTORY_CATEGORY_PREFIX + name;
+        const QStringList seriesNames = m_transferHistory.seriesNames();
+        for (const QString &series : seriesNames)
+        {
+            if ((series == seriesName) || series.startsWith(seriesName + u'/'))
+                m_transferHistory.removeSeries(series);
+        }
     }
 
     return result;
@@ -2594,6 +2721,7 @@ bool SessionImpl::removeTorrent(const TorrentID &id, const TorrentRemoveOption d
 
     LogMsg(tr("Torrent removed. Torrent: \"%1\"").arg(torrentName));
     delete torrent;
+    applyBandwidthRulesDeferred();
     return true;
 }
 
@@ -2761,7 +2889,8 @@ LoadTorrentParams SessionImpl::initLoadTorrentParams(const AddTorrentParams &add
 }
 
 // Add a torrent to the BitTorrent session
-bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorrentParams &addTorrentParams)
+bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorrentParams &addTorrentParams
+        , const AddTorrentCallback &callback)
 {
     Q_ASSERT(isRestored());
 
@@ -2846,22 +2975,7 @@ bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorr
 
         filePaths = addTorrentParams.filePaths;
         if (filePaths.isEmpty())
-        {
-            filePaths = torrentInfo.filePaths();
-            if (loadTorrentParams.contentLayout != TorrentContentLayout::Original)
-            {
-                const Path originalRootFolder = Path::findRootFolder(filePaths);
-                const auto originalContentLayout = (originalRootFolder.isEmpty()
-                        ? TorrentContentLayout::NoSubfolder : TorrentContentLayout::Subfolder);
-                if (loadTorrentParams.contentLayout != originalContentLayout)
-                {
-                    if (loadTorrentParams.contentLayout == TorrentContentLayout::NoSubfolder)
-                        Path::stripRootFolder(filePaths);
-                    else
-                        Path::addRootFolder(filePaths, filePaths.at(0).removedExtension());
-                }
-            }
-        }
+            filePaths = initFilePaths(torrentInfo, loadTorrentParams.contentLayout);
 
         // if torrent name wasn't explicitly set we handle the case of
         // initial renaming of torrent content and rename torrent accordingly
@@ -2997,7 +3111,7 @@ bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorr
         return findIncompleteFiles(actualSavePath, actualDownloadPath, filePaths);
     };
 
-    resolveFileNames().then(this, [this, id, loadTorrentParams = std::move(loadTorrentParams)](const FileSearchResult &result) mutable
+    resolveFileNames().then(this, [this, id, callback, loadTorrentParams = std::move(loadTorrentParams)](const FileSearchResult &result) mutable
     {
         lt::add_torrent_params &p = loadTorrentParams.ltAddTorrentParams;
 
@@ -3011,7 +3125,7 @@ bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorr
         }
 
         m_nativeSession->async_add_torrent(p);
-        m_addTorrentAlertHandlers.append([this, loadTorrentParams = std::move(loadTorrentParams)](const lt::add_torrent_alert *alert) mutable
+        m_addTorrentAlertHandlers.append([this, callback, loadTorrentParams = std::move(loadTorrentParams)](const lt::add_torrent_alert *alert) mutable
         {
             if (alert->error)
             {
@@ -3049,18 +3163,148 @@ bool SessionImpl::addTorrent_impl(const TorrentDescriptor &source, const AddTorr
                         exportTorrentFile(torrent, torrentExportDirectory());
                 }
             }
+
+            if (callback)
+                callback(!alert->error);
         });
     });
 
     return true;
 }
 
+QFuture<QList<InfoHash>> SessionImpl::addTorrents(const QList<std::pair<TorrentDescriptor, AddTorrentParams>> &torrents)
+{
+    if (!isRestored() || torrents.isEmpty())
+        return QtFuture::makeReadyValueFuture(QList<InfoHash>());
+
+    auto context = std::make_shared<BulkAddContext>();
+    context->total = torrents.size();
+    context->items.reserve(torrents.size());
+    context->timer.start();
+
+    QFuture<QList<InfoHash>> future = context->promise.future();
+    context->promise.start();
+
+    QSet<InfoHash> batchInfoHashes;
+    batchInfoHashes.reserve(torrents.size());
+    for (const auto &[torrentDescr, params] : torrents)
+    {
+        const InfoHash infoHash = torrentDescr.infoHash();
+        if (batchInfoHashes.contains(infoHash))
+        {
+            ++context->skipped;
+            continue;
+        }
+        batchInfoHashes.insert(infoHash);
+
+        if (findTorrent(infoHash))
+        {
+            // let regular handling of duplicates merge trackers and notify about it
+            addTorrent_impl(torrentDescr, params);
+            ++context->skipped;
+            continue;
+        }
+
+        context->items.push_back({torrentDescr, params});
+    }
+
+    LogMsg(tr("Adding torrents in bulk. Torrents: %1. Duplicates skipped: %2").arg(context->total).arg(context->skipped));
+
+    const auto itemsCount = static_cast<qsizetype>(context->items.size());
+    if ((itemsCount == 0) || !isExcludedFileNamesEnabled() || m_excludedFileNamesMatcher.isEmpty())
+    {
+        processBulkAddTorrents(context);
+        return future;
+    }
+
+    // Prepare file lists and apply filename filter in parallel
+    const qsizetype chunkSize = std::max(BULK_ADD_MIN_CHUNK_SIZE
+            , ((itemsCount / m_bulkAddThreadPool->maxThreadCount()) + 1));
+    context->pendingChunks = static_cast<int>((itemsCount + chunkSize - 1) / chunkSize);
+    for (qsizetype begin = 0; begin < itemsCount; begin += chunkSize)
+    {
+        const qsizetype end = std::min((begin + chunkSize), itemsCount);
+        m_bulkAddThreadPool->start([this, context, begin, end
+                , matcher = m_excludedFileNamesMatcher, defaultContentLayout = torrentContentLayout()]
+        {
+            for (qsizetype i = begin; i < end; ++i)
+            {
+                auto &[torrentDescr, params] = context->items[i];
+                if (!torrentDescr.info() || !params.filePriorities.isEmpty())
+                    continue;
+
+                if (params.filePaths.isEmpty())
+                    params.filePaths = initFilePaths(*torrentDescr.info(), params.contentLayout.value_or(defaultContentLayout));
+                filterFileNames(matcher, params.filePaths, params.filePriorities);
+            }
+
+            if (--context->pendingChunks == 0)
+                QMetaObject::invokeMethod(this, [this, context] { processBulkAddTorrents(context); }, Qt::QueuedConnection);
+        });
+    }
+
+    return future;
+}
+
+void SessionImpl::processBulkAddTorrents(const std::shared_ptr<BulkAddContext> &context)
+{
+    // Limit the number of torrents being added at once so that
+    // neither I/O jobs nor libtorrent alert queue get flooded
+    const auto itemsCount = static_cast<qsizetype>(context->items.size());
+    while ((context->inProgress < MAX_BULK_ADD_IN_PROGRESS) && (context->nextIndex < itemsCount))
+    {
+        const BulkAddContext::Item item = std::exchange(context->items[context->nextIndex++], {});
+        const InfoHash infoHash = item.torrentDescr.infoHash();
+        const bool accepted = addTorrent_impl(item.torrentDescr, item.params, [this, context, infoHash](const bool added)
+        {
+            --context->inProgress;
+            if (added)
+            {
+                ++context->added;
+                context->addedInfoHashes.append(infoHash);
+            }
+            else
+            {
+                ++context->failed;
+            }
+
+            processBulkAddTorrents(context);
+        });
+
+        if (accepted)
+            ++context->inProgress;
+        else
+            ++context->skipped;
+    }
+
+    // Several torrents can be processed at once (e.g. skipped ones),
+    // so log each progress step that has been passed since the last time
+    const qsizetype processed = context->added + context->failed + context->skipped;
+    const qsizetype progressSteps = processed / BULK_ADD_PROGRESS_STEP;
+    if (progressSteps > context->loggedProgressSteps)
+    {
+        context->loggedProgressSteps = progressSteps;
+        if (processed < context->total)
+            LogMsg(tr("Adding torrents in bulk. Processed: %1/%2").arg(processed).arg(context->total));
+    }
+
+    if ((context->inProgress == 0) && (context->nextIndex == itemsCount))
+    {
+        LogMsg(tr("Finished adding torrents in bulk. Added: %1. Failed: %2. Skipped: %3. Elapsed time: %4 ms")
+                .arg(QString::number(context->added), QString::number(context->failed)
+                        , QString::number(context->skipped), QString::number(context->timer.elapsed())));
+
+        context->promise.addResult(std::exchange(context->addedInfoHashes, {}));
+        context->promise.finish();
+    }
+}
+
 QFuture<FileSearchResult> SessionImpl::findIncompleteFiles(const Path &savePath, const Path &downloadPath, const PathList &filePaths) const
 {
     QPromise<FileSearchResult> promise;
     QFuture<FileSearchResult> future = promise.future();
     promise.start();
-    QMetaObject::invokeMethod(m_fileSearcher, [=, this, promise = std::move(promise)]() mutable
+    invokeIOJob(m_fileSearcher, m_ioJobCounters, [=, this, promise = std::move(promise)]() mutable
     {
         m_fileSearcher->search(filePaths, savePath, downloadPath, isAppendExtensionEnabled(), promise);
         promise.finish();
@@ -3380,7 +3624,7 @@ void SessionImpl::setSavePath(const Path &path)
 
     m_freeDiskSpace = -1;
     m_freeDiskSpaceCheckingTimer->stop();
-    QMetaObject::invokeMethod(m_freeDiskSpaceChecker, [checker = m_freeDiskSpaceChecker, pathToCheck = m_savePath]
+    invokeIOJob(m_freeDiskSpaceChecker, m_ioJobCounters, [checker = m_freeDiskSpaceChecker, pathToCheck = m_savePath]
     {
         checker->setPathToCheck(pathToCheck);
         checker->check();
@@ -3687,6 +3931,22 @@ void SessionImpl::setBandwidthSchedulerEnabled(const bool enabled)
     }
 }
 
+QList<BandwidthRule> SessionImpl::bandwidthRules() const
+{
+    return m_bandwidthRules;
+}
+
+void SessionImpl::setBandwidthRules(const QList<BandwidthRule> &rules)
+{
+    if (rules == m_bandwidthRules)
+        return;
+
+    m_bandwidthRules = rules;
+    storeBandwidthRules();
+    updateBandwidthRulesTimer();
+    applyBandwidthRules();
+}
+
 bool SessionImpl::isPerformanceWarningEnabled() const
 {
     return m_isPerformanceWarningEnabled;
@@ -3734,6 +3994,33 @@ void SessionImpl::setSaveStatisticsInterval(const std::chrono::minutes timeInMin
     m_saveStatisticsInterval = timeInMinutes.count();
 }
 
+const TransferHistory &SessionImpl::transferHistory() const
+{
+    return m_transferHistory;
+}
+
+bool SessionImpl::isTransferHistoryByCategoryEnabled() const
+{
+    return m_isTransferHistoryByCategoryEnabled;
+}
+
+void SessionImpl::setTransferHistoryByCategoryEnabled(const bool enabled)
+{
+    if (enabled == m_isTransferHistoryByCategoryEnabled)
+        return;
+
+    m_isTransferHistoryByCategoryEnabled = enabled;
+    if (!enabled)
+    {
+        const QStringList seriesNames = m_transferHistory.seriesNames();
+        for (const QString &series : seriesNames)
+        {
+            if (series.startsWith(TRANSFER_HISTORY_CATEGORY_PREFIX))
+                m_transferHistory.removeSeries(series);
+        }
+    }
+}
+
 int SessionImpl::shutdownTimeout() const
 {
     return m_shutdownTimeout;
@@ -4095,7 +4382,7 @@ void SessionImpl::updateTrackersFromURL()
     else
     {
         const Path path = specialFolderLocation(SpecialFolder::Data) / ADDITIONAL_TRACKERS_FROM_URL_FILE_NAME;
-        Net::DownloadManager::instance()->download(Net::DownloadRequest(url).saveToFile(true).destFileName(path)
+        Net::DownloadManager::instance()->download(Net::DownloadRequest(url).saveToFile(true).destFileName(path).priority(Net::RequestPriority::Background)
                 , Preferences::instance()->useProxyForGeneralPurposes(), this, [this](const Net::DownloadResult &result)
         {
             if (result.status == Net::DownloadStatus::Success)
@@ -4153,9 +4440,9 @@ void SessionImpl::setExcludedFileNamesEnabled(const bool enabled)
     m_isExcludedFileNamesEnabled = enabled;
 
     if (enabled)
-        populateExcludedFileNamesRegExpList();
+        populateExcludedFileNamesMatcher();
     else
-        m_excludedFileNamesRegExpList.clear();
+        m_excludedFileNamesMatcher = {};
 }
 
 QStringList SessionImpl::excludedFileNames() const
@@ -4168,23 +4455,13 @@ void SessionImpl::setExcludedFileNames(const QStringList &excludedFileNames)
     if (excludedFileNames != m_excludedFileNames)
     {
         m_excludedFileNames = excludedFileNames;
-        populateExcludedFileNamesRegExpList();
+        populateExcludedFileNamesMatcher();
     }
 }
 
-void SessionImpl::populateExcludedFileNamesRegExpList()
+void SessionImpl::populateExcludedFileNamesMatcher()
 {
-    const QStringList excludedNames = excludedFileNames();
-
-    m_excludedFileNamesRegExpList.clear();
-    m_excludedFileNamesRegExpList.reserve(excludedNames.size());
-
-    for (const QString &str : excludedNames)
-    {
-        const QString pattern = QRegularExpression::wildcardToRegularExpression(str);
-        const QRegularExpression re {pattern, QRegularExpression::CaseInsensitiveOption};
-        m_excludedFileNamesRegExpList.append(re);
-    }
+    m_excludedFileNamesMatcher = Utils::WildcardMatcher(excludedFileNames());
 }
 
 void SessionImpl::applyFilenameFilter(const PathList &files, QList<DownloadPriority> &priorities)
@@ -4192,30 +4469,7 @@ void SessionImpl::applyFilenameFilter(const PathList &files, QList<DownloadPrior
     if (!isExcludedFileNamesEnabled())
         return;
 
-    const auto isFilenameExcluded = [patterns = m_excludedFileNamesRegExpList](const Path &fileName)
-    {
-        return std::ranges::any_of(patterns, [&fileName](const QRegularExpression &re)
-        {
-            Path path = fileName;
-            while (!re.match(path.filename()).hasMatch())
-            {
-                path = path.parentPath();
-                if (path.isEmpty())
-                    return false;
-            }
-            return true;
-        });
-    };
-
-    priorities.resize(files.count(), DownloadPriority::Normal);
-    for (qsizetype i = 0; i < priorities.size(); ++i)
-    {
-        if (priorities[i] == BitTorrent::DownloadPriority::Ignored)
-            continue;
-
-        if (isFilenameExcluded(files.at(i)))
-            priorities[i] = BitTorrent::DownloadPriority::Ignored;
-    }
+    filterFileNames(m_excludedFileNamesMatcher, files, priorities);
 }
 
 void SessionImpl::setBannedIPs(const QStringList &newList)
@@ -5335,16 +5589,19 @@ void SessionImpl::handleTorrentSavePathChanged(TorrentImpl *const torrent)
 
 void SessionImpl::handleTorrentCategoryChanged(TorrentImpl *const torrent, const QString &oldCategory)
 {
+    applyBandwidthRulesDeferred();
     emit torrentCategoryChanged(torrent, oldCategory);
 }
 
 void SessionImpl::handleTorrentTagAdded(TorrentImpl *const torrent, const Tag &tag)
 {
+    applyBandwidthRulesDeferred();
     emit torrentTagAdded(torrent, tag);
 }
 
 void SessionImpl::handleTorrentTagRemoved(TorrentImpl *const torrent, const Tag &tag)
 {
+    applyBandwidthRulesDeferred();
     emit torrentTagRemoved(torrent, tag);
 }
 
@@ -5404,12 +5661,16 @@ void SessionImpl::handleTorrentStopped(TorrentImpl *const torrent)
         updatedTrackers.emplace(status.url, status);
     emit trackerEntryStatusesUpdated(torrent, updatedTrackers);
 
+    applyBandwidthRulesDeferred();
+
     LogMsg(tr("Torrent stopped. Torrent: \"%1\"").arg(torrent->name()));
     emit torrentStopped(torrent);
 }
 
 void SessionImpl::handleTorrentStarted(TorrentImpl *const torrent)
 {
+    applyBandwidthRulesDeferred();
+
     LogMsg(tr("Torrent resumed. Torrent: \"%1\"").arg(torrent->name()));
     emit torrentStarted(torrent);
 }
@@ -5693,6 +5954,133 @@ void SessionImpl::loadCategories()
     m_categories = expandCategories(m_categories);
 }
 
+void SessionImpl::storeBandwidthRules() const
+{
+    QJsonArray jsonArr;
+    for (const BandwidthRule &rule : asConst(m_bandwidthRules))
+        jsonArr.append(rule.toJSON());
+
+    const Path path = specialFolderLocation(SpecialFolder::Config) / BANDWIDTH_RULES_FILE_NAME;
+    const QByteArray data = QJsonDocument(jsonArr).toJson();
+    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(path, data);
+    if (!result)
+    {
+        LogMsg(tr("Failed to save bandwidth rules. File: \"%1\". Error: \"%2\"")
+               .arg(path.toString(), result.error()), Log::WARNING);
+    }
+}
+
+void SessionImpl::loadBandwidthRules()
+{
+    m_bandwidthRules.clear();
+
+    const Path path = specialFolderLocation(SpecialFolder::Config) / BANDWIDTH_RULES_FILE_NAME;
+    if (!path.exists())
+        return;
+
+    const int fileMaxSize = 1024 * 1024;
+    const auto readResult = Utils::IO::readFile(path, fileMaxSize);
+    if (!readResult)
+    {
+        LogMsg(tr("Failed to load bandwidth rules. %1").arg(readResult.error().message), Log::WARNING);
+        return;
+    }
+
+    QJsonParseError jsonError;
+    const QJsonDocument jsonDoc = QJsonDocument::fromJson(readResult.value(), &jsonError);
+    if (jsonError.error != QJsonParseError::NoError)
+    {
+        LogMsg(tr("Failed to parse bandwidth rules. File: \"%1\". Error: \"%2\"")
+               .arg(path.toString(), jsonError.errorString()), Log::WARNING);
+        return;
+    }
+
+    if (!jsonDoc.isArray())
+    {
+        LogMsg(tr("Failed to load bandwidth rules. File: \"%1\". Error: \"Invalid data format\"")
+               .arg(path.toString()), Log::WARNING);
+        return;
+    }
+
+    const QJsonArray jsonArr = jsonDoc.array();
+    for (const QJsonValue &jsonVal : jsonArr)
+    {
+        const BandwidthRule rule = BandwidthRule::fromJSON(jsonVal.toObject());
+        if (rule.isValid())
+            m_bandwidthRules.append(rule);
+    }
+
+    updateBandwidthRulesTimer();
+}
+
+void SessionImpl::updateBandwidthRulesTimer()
+{
+    if (m_bandwidthRules.isEmpty())
+        m_bandwidthRulesTimer->stop();
+    else if (!m_bandwidthRulesTimer->isActive())
+        m_bandwidthRulesTimer->start();
+}
+
+void SessionImpl::applyBandwidthRulesDeferred()
+{
+    if (m_bandwidthRulesApplyScheduled)
+        return;
+    if (m_bandwidthRules.isEmpty() && !m_hasScheduledRateLimits)
+        return;
+
+    m_bandwidthRulesApplyScheduled = true;
+    QMetaObject::invokeMethod(this, &SessionImpl::applyBandwidthRules, Qt::QueuedConnection);
+}
+
+void SessionImpl::applyBandwidthRules()
+{
+    m_bandwidthRulesApplyScheduled = false;
+
+    QList<const BandwidthRule *> activeRules;
+    for (const BandwidthRule &rule : asConst(m_bandwidthRules))
+    {
+        if (rule.isActive())
+            activeRules.append(&rule);
+    }
+
+    if (activeRules.isEmpty() && !m_hasScheduledRateLimits)
+        return;
+
+    // Each torrent is governed by the first matching rule only.
+    // The rule limits are shared equally by its running torrents.
+    std::vector<QList<TorrentImpl *>> ruleTorrents(activeRules.size());
+    std::vector<int> runningTorrentsCounts(activeRules.size(), 0);
+    for (TorrentImpl *torrent : asConst(m_torrents))
+    {
+        const auto ruleIter = std::ranges::find_if(activeRules, [torrent](const BandwidthRule *rule)
+        {
+            return rule->matches(*torrent);
+        });
+        if (ruleIter == activeRules.cend())
+        {
+            torrent->setScheduledRateLimits(0, 0);
+            continue;
+        }
+
+        const auto ruleIndex = std::distance(activeRules.cbegin(), ruleIter);
+        ruleTorrents[ruleIndex].append(torrent);
+        if (!torrent->isStopped())
+            ++runningTorrentsCounts[ruleIndex];
+    }
+
+    for (qsizetype i = 0; i < activeRules.size(); ++i)
+    {
+        const BandwidthRule *rule = activeRules[i];
+        const int divisor = std::max(1, runningTorrentsCounts[i]);
+        const int uploadLimit = (rule->uploadLimit > 0) ? std::max(1, (rule->uploadLimit / divisor)) : 0;
+        const int downloadLimit = (rule->downloadLimit > 0) ? std::max(1, (rule->downloadLimit / divisor)) : 0;
+        for (TorrentImpl *torrent : asConst(ruleTorrents[i]))
+            torrent->setScheduledRateLimits(uploadLimit, downloadLimit);
+    }
+
+    m_hasScheduledRateLimits = !activeRules.isEmpty();
+}
+
 void SessionImpl::configureDeferred()
 {
     if (m_deferredConfigureScheduled)
@@ -5830,6 +6218,9 @@ void SessionImpl::readAlerts()
 {
     fetchPendingAlerts();
 
+    QElapsedTimer processingTimer;
+    processingTimer.start();
+
     Q_ASSERT(m_loadedTorrents.isEmpty());
 
     if (!isRestored())
@@ -5854,6 +6245,9 @@ void SessionImpl::readAlerts()
 
     // Some torrents may become "finished" after different alerts handling.
     processPendingFinishedTorrents();
+
+    m_processedAlertsCount += static_cast<qint64>(m_alerts.size());
+    m_alertProcessingTime += processingTimer.nsecsElapsed();
 }
 
 void SessionImpl::handleAddTorrentAlert(const lt::add_torrent_alert *alert)
@@ -6008,6 +6402,8 @@ TorrentImpl *SessionImpl::createTorrent(const lt::torrent_handle &nativeHandle,
         m_seedingLimitTimer->start();
     }
 
+    applyBandwidthRulesDeferred();
+
     // Torrent could have error just after adding to libtorrent
     if (torrent->hasError())
         LogMsg(tr("Torrent errored. Torrent: \"%1\". Error: \"%2\"").arg(torrent->name(), torrent->error()), Log::WARNING);
@@ -6292,6 +6688,8 @@ void SessionImpl::handleSessionStatsAlert(const lt::session_stats_alert *alert)
     m_statsLastTimestamp = alert->timestamp();
 
     const auto stats = alert->counters();
+    m_statsCounters.assign(stats.begin(), stats.end());
+    m_isMetricsDirty = true;
 
     m_status.hasIncomingConnections = static_cast<bool>(stats[m_metricIndices.net.hasIncomingConnections]);
 
@@ -6322,6 +6720,10 @@ void SessionImpl::handleSessionStatsAlert(const lt::session_stats_alert *alert)
     m_status.trackerDownloadRate = calcRate(m_status.trackerDownload, trackerDownload);
     m_status.trackerUploadRate = calcRate(m_status.trackerUpload, trackerUpload);
 
+    recordTransferHistory(interval
+        , {.download = std::max<qint64>(0, (totalDownload - m_status.totalDownload)), .upload = std::max<qint64>(0, (totalUpload - m_status.totalUpload))}
+        , {.download = std::max<qint64>(0, (totalPayloadDownload - m_status.totalPayloadDownload)), .upload = std::max<qint64>(0, (totalPayloadUpload - m_status.totalPayloadUpload))});
+
     m_status.totalPayloadDownload = totalPayloadDownload;
     m_status.totalPayloadUpload = totalPayloadUpload;
     m_status.ipOverheadDownload = ipOverheadDownload;
@@ -6339,6 +6741,16 @@ void SessionImpl::handleSessionStatsAlert(const lt::session_stats_alert *alert)
 
     m_status.queuedTrackerAnnounces = stats[m_metricIndices.tracker.numQueuedTrackerAnnounces];
 
+    const auto averageJobTime = [](const IOJobCounters &counters) -> qint64
+    {
+        const qint64 finishedJobs = counters.finishedJobs;
+        return (finishedJobs > 0) ? (counters.totalJobTime / finishedJobs) : 0;
+    };
+    m_status.ioQueuedJobs = m_ioJobCounters.queuedJobs;
+    m_status.ioAverageJobTime = averageJobTime(m_ioJobCounters);
+    m_status.bulkIOQueuedJobs = m_bulkIOJobCounters.queuedJobs;
+    m_status.bulkIOAverageJobTime = averageJobTime(m_bulkIOJobCounters);
+
     if (totalDownload > m_status.totalDownload)
     {
         m_status.totalDownload = totalDownload;
@@ -6360,6 +6772,7 @@ void SessionImpl::handleSessionStatsAlert(const lt::session_stats_alert *alert)
         if (m_statisticsLastUpdateTimer.hasExpired(saveInterval.count()))
         {
             saveStatistics();
+            saveTransferHistory();
         }
     }
 
@@ -6674,6 +7087,166 @@ void SessionImpl::saveStatistics() const
     m_isStatisticsDirty = false;
 }
 
+QByteArray SessionImpl::metrics() const
+{
+    if (!m_isMetricsDirty)
+        return m_metrics;
+
+    using Utils::Prometheus::MetricType;
+    Utils::Prometheus::TextWriter writer;
+
+    static const std::vector<lt::stats_metric> statsMetrics = lt::session_stats_metrics();
+    for (const lt::stats_metric &metric : statsMetrics)
+    {
+        if ((metric.value_index < 0) || (static_cast<std::size_t>(metric.value_index) >= m_statsCounters.size()))
+            continue;
+
+        const bool isCounter = (metric.type == lt::metric_type_t::counter);
+        QByteArray name = "qbittorrent_libtorrent_" + Utils::Prometheus::sanitizeName(metric.name);
+        if (isCounter)
+            name += "_total";
+        writer.addMetric(name, (isCounter ? MetricType::Counter : MetricType::Gauge), metric.name);
+        writer.addSample(name, m_statsCounters[metric.value_index]);
+    }
+
+    writer.addMetric("qbittorrent_alerts_processed_total", MetricType::Counter, "Number of processed libtorrent alerts");
+    writer.addSample("qbittorrent_alerts_processed_total", m_processedAlertsCount);
+    writer.addMetric("qbittorrent_alert_processing_seconds_total", MetricType::Counter, "Time spent processing libtorrent alerts");
+    writer.addSample("qbittorrent_alert_processing_seconds_total", (m_alertProcessingTime / 1e9));
+    writer.addMetric("qbittorrent_resume_data_queue_depth", MetricType::Gauge, "Number of outstanding resume data requests");
+    writer.addSample("qbittorrent_resume_data_queue_depth", qint64 {m_numResumeData});
+    writer.addMetric("qbittorrent_io_queued_jobs", MetricType::Gauge, "Number of queued I/O jobs");
+    writer.addSample("qbittorrent_io_queued_jobs", m_status.ioQueuedJobs, {{u"queue"_s, u"io"_s}});
+    writer.addSample("qbittorrent_io_queued_jobs", m_status.bulkIOQueuedJobs, {{u"queue"_s, u"bulk"_s}});
+
+    struct CategoryStatistics
+    {
+        qint64 torrents = 0;
+        qint64 downloadRate = 0;
+        qint64 uploadRate = 0;
+        qint64 downloaded = 0;
+        qint64 uploaded = 0;
+    };
+
+    const bool isByCategory = isMetricsByCategoryEnabled();
+    QHash<TorrentState, qint64> stateCounts;
+    QMap<QString, CategoryStatistics> categoryStatistics;
+    for (const TorrentImpl *torrent : asConst(m_torrents))
+    {
+        ++stateCounts[torrent->state()];
+
+        if (isByCategory)
+        {
+            CategoryStatistics &statistics = categoryStatistics[torrent->category()];
+            ++statistics.torrents;
+            statistics.downloadRate += torrent->downloadPayloadRate();
+            statistics.uploadRate += torrent->uploadPayloadRate();
+            statistics.downloaded += torrent->totalDownload();
+            statistics.uploaded += torrent->totalUpload();
+        }
+    }
+
+    writer.addMetric("qbittorrent_torrents", MetricType::Gauge, "Number of torrents by state");
+    for (int i = static_cast<int>(TorrentState::Unknown); i <= static_cast<int>(TorrentState::Error); ++i)
+    {
+        const auto state = static_cast<TorrentState>(i);
+        writer.addSample("qbittorrent_torrents", stateCounts.value(state), {{u"state"_s, torrentStateToString(state)}});
+    }
+
+    if (isByCategory)
+    {
+        const auto addCategoryMetric = [&writer, &categoryStatistics](const char *name, const char *help, qint64 CategoryStatistics::*field)
+        {
+            writer.addMetric(name, MetricType::Gauge, help);
+            for (auto it = categoryStatistics.cbegin(); it != categoryStatistics.cend(); ++it)
+                writer.addSample(name, it.value().*field, {{u"category"_s, it.key()}});
+        };
+
+        addCategoryMetric("qbittorrent_category_torrents", "Number of torrents in category", &CategoryStatistics::torrents);
+        addCategoryMetric("qbittorrent_category_download_rate_bytes", "Payload download rate of torrents in category", &CategoryStatistics::downloadRate);
+        addCategoryMetric("qbittorrent_category_upload_rate_bytes", "Payload upload rate of torrents in category", &CategoryStatistics::uploadRate);
+        addCategoryMetric("qbittorrent_category_downloaded_bytes", "Payload downloaded by torrents in category", &CategoryStatistics::downloaded);
+        addCategoryMetric("qbittorrent_category_uploaded_bytes", "Payload uploaded by torrents in category", &CategoryStatistics::uploaded);
+    }
+
+    m_metrics = writer.data();
+    m_isMetricsDirty = false;
+    return m_metrics;
+}
+
+bool SessionImpl::isMetricsByCategoryEnabled() const
+{
+    return m_isMetricsByCategoryEnabled;
+}
+
+void SessionImpl::setMetricsByCategoryEnabled(const bool enabled)
+{
+    if (enabled == m_isMetricsByCategoryEnabled)
+        return;
+
+    m_isMetricsByCategoryEnabled = enabled;
+    m_isMetricsDirty = true;
+}
+
+void SessionImpl::recordTransferHistory(const qint64 interval, const TransferHistory::Counters &totalBytes, const TransferHistory::Counters &payloadBytes)
+{
+    const qint64 endTime = QDateTime::currentMSecsSinceEpoch();
+    const qint64 startTime = endTime - (interval / 1000);
+    m_transferHistory.record(TRANSFER_HISTORY_SESSION_SERIES, startTime, endTime, totalBytes);
+    m_transferHistory.record(TRANSFER_HISTORY_PAYLOAD_SERIES, startTime, endTime, payloadBytes);
+
+    if (!isTransferHistoryByCategoryEnabled())
+        return;
+
+    // Torrents provide only rates so amounts are estimated from them
+    QHash<QString, TransferHistory::Counters> categoryBytes;
+    for (const TorrentImpl *torrent : asConst(m_torrents))
+    {
+        const QString category = torrent->category();
+        if (category.isEmpty())
+            continue;
+
+        TransferHistory::Counters &bytes = categoryBytes[category];
+        bytes.download += (static_cast<qint64>(torrent->downloadPayloadRate()) * interval) / lt::microseconds(1s).count();
+        bytes.upload += (static_cast<qint64>(torrent->uploadPayloadRate()) * interval) / lt::microseconds(1s).count();
+    }
+
+    for (auto it = categoryBytes.cbegin(); it != categoryBytes.cend(); ++it)
+        m_transferHistory.record((TRANSFER_HISTORY_CATEGORY_PREFIX + it.key()), startTime, endTime, it.value());
+}
+
+void SessionImpl::saveTransferHistory() const
+{
+    const Path path = specialFolderLocation(SpecialFolder::Data) / TRANSFER_HISTORY_FILE_NAME;
+    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(path, m_transferHistory.serialize());
+    if (!result)
+    {
+        LogMsg(tr("Failed to save transfer history. File: \"%1\". Error: \"%2\"")
+               .arg(path.toString(), result.error()), Log::WARNING);
+    }
+}
+
+void SessionImpl::loadTransferHistory()
+{
+    const Path path = specialFolderLocation(SpecialFolder::Data) / TRANSFER_HISTORY_FILE_NAME;
+    if (!path.exists())
+        return;
+
+    const int fileMaxSize = 64 * 1024 * 1024;
+    const auto readResult = Utils::IO::readFile(path, fileMaxSize);
+    if (!readResult)
+    {
+        LogMsg(tr("Failed to load transfer history. %1").arg(readResult.error().message), Log::WARNING);
+        return;
+    }
+
+    if (!m_transferHistory.deserialize(readResult.value()))
+    {
+        LogMsg(tr("Failed to load transfer history. File: \"%1\". Error: \"Invalid data format\"")
+               .arg(path.toString()), Log::WARNING);
+    }
+}
+
 void SessionImpl::loadStatistics()
 {
     const std::unique_ptr<QSettings> settings = Profile::instance()->applicationSettings(u"qBittorrent-data"_s);
@@ -6740,7 +7313,7 @@ void SessionImpl::handleRemovedTorrent(const TorrentID &torrentID, const QString
     if ((removingTorrentDataIter->removeOption == TorrentRemoveOption::RemoveContent)
             && !removingTorrentDataIter->contentStoragePath.isEmpty())
     {
-        QMetaObject::invokeMethod(m_torrentContentRemover, [this, jobData = *removingTorrentDataIter]
+        invokeIOJob(m_torrentContentRemover, m_bulkIOJobCounters, [this, jobData = *removingTorrentDataIter]
         {
             m_torrentContentRemover->performJob(jobData.name, jobData.contentStoragePath
                     , jobData.fileNames, m_torrentContentRemoveOption);
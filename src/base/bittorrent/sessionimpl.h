@@ -29,8 +29,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -51,12 +53,15 @@
 #include "base/path.h"
 #include "base/settingvalue.h"
 #include "base/utils/thread.h"
+#include "base/utils/wildcardmatcher.h"
 #include "addtorrentparams.h"
+#include "bandwidthrule.h"
 #include "cachestatus.h"
 #include "categoryoptions.h"
 #include "session.h"
 #include "sessionstatus.h"
 #include "torrentinfo.h"
+#include "transferhistory.h"
 
 class QString;
 class QTimer;
@@ -233,6 +238,8 @@ namespace BitTorrent
         void setAltGlobalSpeedLimitEnabled(bool enabled) override;
         bool isBandwidthSchedulerEnabled() const override;
         void setBandwidthSchedulerEnabled(bool enabled) override;
+        QList<BandwidthRule> bandwidthRules() const override;
+        void setBandwidthRules(const QList<BandwidthRule> &rules) override;
 
         bool isPerformanceWarningEnabled() const override;
         void setPerformanceWarningEnabled(bool enable) override;
@@ -240,6 +247,12 @@ namespace BitTorrent
         void setSaveResumeDataInterval(int value) override;
         std::chrono::minutes saveStatisticsInterval() const override;
         void setSaveStatisticsInterval(std::chrono::minutes value) override;
+        const TransferHistory &transferHistory() const override;
+        bool isTransferHistoryByCategoryEnabled() const override;
+        void setTransferHistoryByCategoryEnabled(bool enabled) override;
+        QByteArray metrics() const override;
+        bool isMetricsByCategoryEnabled() const override;
+        void setMetricsByCategoryEnabled(bool enabled) override;
         int shutdownTimeout() const override;
         void setShutdownTimeout(int value) override;
         int port() const override;
@@ -447,6 +460,7 @@ namespace BitTorrent
 
         bool isKnownTorrent(const InfoHash &infoHash) const override;
         bool addTorrent(const TorrentDescriptor &torrentDescr, const AddTorrentParams &params = {}) override;
+        QFuture<QList<InfoHash>> addTorrents(const QList<std::pair<TorrentDescriptor, AddTorrentParams>> &torrents) override;
         bool removeTorrent(const TorrentID &id, TorrentRemoveOption deleteOption = TorrentRemoveOption::KeepContent) override;
         bool downloadMetadata(const TorrentDescriptor &torrentDescr) override;
         bool cancelDownloadMetadata(const TorrentID &id) override;
@@ -512,6 +526,29 @@ namespace BitTorrent
             m_asyncWorker->start(std::forward<Func>(func));
         }
 
+        // Counts jobs queued to an object that lives in one of the I/O threads
+        struct IOJobCounters
+        {
+            std::atomic<qint64> queuedJobs = 0;
+            std::atomic<qint64> finishedJobs = 0;
+            std::atomic<qint64> totalJobTime = 0;  // in milliseconds, including time spent in queue
+        };
+
+        template <typename Func>
+        void invokeIOJob(QObject *context, IOJobCounters &counters, Func &&func) const
+        {
+            QElapsedTimer jobTimer;
+            jobTimer.start();
+            ++counters.queuedJobs;
+            QMetaObject::invokeMethod(context, [&counters, jobTimer, func = std::forward<Func>(func)]() mutable
+            {
+                func();
+                counters.totalJobTime += jobTimer.elapsed();
+                ++counters.finishedJobs;
+                --counters.queuedJobs;
+            });
+        }
+
         bool isAddTrackersFromURLEnabled() const override;
         void setAddTrackersFromURLEnabled(bool enabled) override;
         QString additionalTrackersURL() const override;
@@ -570,14 +607,20 @@ namespace BitTorrent
         void enableIPFilter();
         void disableIPFilter();
         void processTorrentShareLimits(TorrentImpl *torrent);
-        void populateExcludedFileNamesRegExpList();
+        void populateExcludedFileNamesMatcher();
         void prepareStartup();
         void handleLoadedResumeData(ResumeSessionContext *context);
         void processNextResumeData(ResumeSessionContext *context);
         void endStartup(ResumeSessionContext *context);
 
         LoadTorrentParams initLoadTorrentParams(const AddTorrentParams &addTorrentParams);
-        bool addTorrent_impl(const TorrentDescriptor &source, const AddTorrentParams &addTorrentParams);
+        struct BulkAddContext;
+        // is called once torrent is either added or failed to be added to libtorrent session
+        using AddTorrentCallback = std::function<void (bool added)>;
+
+        bool addTorrent_impl(const TorrentDescriptor &source, const AddTorrentParams &addTorrentParams
+                , const AddTorrentCallback &callback = {});
+        void processBulkAddTorrents(const std::shared_ptr<BulkAddContext> &context);
 
         void updateShareLimitsTimer();
         void exportTorrentFile(const Torrent *torrent, const Path &folderPath);
@@ -641,10 +684,18 @@ namespace BitTorrent
         void loadCategories();
         void storeCategories() const;
         void upgradeCategories();
+        void loadBandwidthRules();
+        void storeBandwidthRules() const;
+        void updateBandwidthRulesTimer();
+        void applyBandwidthRules();
+        void applyBandwidthRulesDeferred();
         DownloadPathOption resolveCategoryDownloadPathOption(const QString &categoryName, const std::optional<DownloadPathOption> &option) const;
 
         void saveStatistics() const;
         void loadStatistics();
+        void recordTransferHistory(qint64 interval, const TransferHistory::Counters &totalBytes, const TransferHistory::Counters &payloadBytes);
+        void saveTransferHistory() const;
+        void loadTransferHistory();
 
         void updateTrackerEntryStatuses(lt::torrent_handle torrentHandle);
 
@@ -744,6 +795,8 @@ namespace BitTorrent
         CachedSettingValue<bool> m_isPerformanceWarningEnabled;
         CachedSettingValue<int> m_saveResumeDataInterval;
         CachedSettingValue<int> m_saveStatisticsInterval;
+        CachedSettingValue<bool> m_isTransferHistoryByCategoryEnabled;
+        CachedSettingValue<bool> m_isMetricsByCategoryEnabled;
         CachedSettingValue<int> m_shutdownTimeout;
         CachedSettingValue<int> m_port;
         CachedSettingValue<bool> m_sslEnabled;
@@ -809,11 +862,19 @@ namespace BitTorrent
         int m_numResumeData = 0;
         QList<TrackerEntry> m_additionalTrackerEntries;
         QList<TrackerEntry> m_additionalTrackerEntriesFromURL;
-        QList<QRegularExpression> m_excludedFileNamesRegExpList;
+        Utils::WildcardMatcher m_excludedFileNamesMatcher;
 
         // Statistics
         mutable QElapsedTimer m_statisticsLastUpdateTimer;
         mutable bool m_isStatisticsDirty = false;
+        TransferHistory m_transferHistory;
+
+        // Snapshot of libtorrent counters taken on the last stats alert
+        std::vector<qint64> m_statsCounters;
+        qint64 m_processedAlertsCount = 0;
+        qint64 m_alertProcessingTime = 0;  // nanoseconds
+        mutable QByteArray m_metrics;
+        mutable bool m_isMetricsDirty = true;
         qint64 m_previouslyUploaded = 0;
         qint64 m_previouslyDownloaded = 0;
 
@@ -825,11 +886,22 @@ namespace BitTorrent
         // IP filtering
         QPointer<FilterParserThread> m_filterParser;
         QPointer<BandwidthScheduler> m_bwScheduler;
+        QList<BandwidthRule> m_bandwidthRules;
+        QTimer *m_bandwidthRulesTimer = nullptr;
+        bool m_hasScheduledRateLimits = false;
+        bool m_bandwidthRulesApplyScheduled = false;
         // Tracker
         QPointer<Tracker> m_tracker;
 
+        // Counters are declared before the threads so they outlive the jobs running there
+        mutable IOJobCounters m_ioJobCounters;
+        mutable IOJobCounters m_bulkIOJobCounters;
+        // Latency-sensitive I/O (file search on add, free disk space checks)
         Utils::Thread::UniquePtr m_ioThread;
+        // Bulk I/O (content removal) that must not delay the above
+        Utils::Thread::UniquePtr m_bulkIOThread;
         QThreadPool *m_asyncWorker = nullptr;
+        QThreadPool *m_bulkAddThreadPool = nullptr;
         ResumeDataStorage *m_resumeDataStorage = nullptr;
         FileSearcher *m_fileSearcher = nullptr;
         TorrentContentRemover *m_torrentContentRemover = nullptr;
@@ -75,5 +75,11 @@ namespace BitTorrent
         qint64 peersCount = 0;
 
         qint64 queuedTrackerAnnounces = 0;
+
+        // Session's own I/O jobs, average job time is in milliseconds and includes time spent in queue
+        qint64 ioQueuedJobs = 0;
+        qint64 ioAverageJobTime = 0;
+        qint64 bulkIOQueuedJobs = 0;
+        qint64 bulkIOAverageJobTime = 0;
     };
 }
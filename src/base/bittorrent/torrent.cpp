@@ -33,6 +33,7 @@
 
 #include <QHash>
 
+#include "base/global.h"
 #include "infohash.h"
 
 namespace BitTorrent
@@ -42,6 +43,51 @@ namespace BitTorrent
         return ::qHash(static_cast<std::underlying_type_t<TorrentState>>(key), seed);
     }
 
+    QString torrentStateToString(const TorrentState state)
+    {
+        switch (state)
+        {
+        case TorrentState::Error:
+            return u"error"_s;
+        case TorrentState::MissingFiles:
+            return u"missingFiles"_s;
+        case TorrentState::Uploading:
+            return u"uploading"_s;
+        case TorrentState::StoppedUploading:
+            return u"stoppedUP"_s;
+        case TorrentState::QueuedUploading:
+            return u"queuedUP"_s;
+        case TorrentState::StalledUploading:
+            return u"stalledUP"_s;
+        case TorrentState::CheckingUploading:
+            return u"checkingUP"_s;
+        case TorrentState::ForcedUploading:
+            return u"forcedUP"_s;
+        case TorrentState::Downloading:
+            return u"downloading"_s;
+        case TorrentState::DownloadingMetadata:
+            return u"metaDL"_s;
+        case TorrentState::ForcedDownloadingMetadata:
+            return u"forcedMetaDL"_s;
+        case TorrentState::StoppedDownloading:
+            return u"stoppedDL"_s;
+        case TorrentState::QueuedDownloading:
+            return u"queuedDL"_s;
+        case TorrentState::StalledDownloading:
+            return u"stalledDL"_s;
+        case TorrentState::CheckingDownloading:
+            return u"checkingDL"_s;
+        case TorrentState::ForcedDownloading:
+            return u"forcedDL"_s;
+        case TorrentState::CheckingResumeData:
+            return u"checkingResumeData"_s;
+        case TorrentState::Moving:
+            return u"moving"_s;
+        default:
+            return u"unknown"_s;
+        }
+    }
+
     // Torrent
 
     const qreal Torrent::MAX_RATIO = std::numeric_limits<qreal>::infinity();
@@ -111,6 +111,9 @@ namespace BitTorrent
 
     std::size_t qHash(TorrentState key, std::size_t seed = 0);
 
+    // Returns state name used by WebAPI
+    QString torrentStateToString(TorrentState state);
+
     class Torrent : public TorrentContentHandler
     {
         Q_OBJECT
@@ -225,6 +228,8 @@ namespace BitTorrent
 
         virtual PathList filePaths() const = 0;
         virtual PathList actualFilePaths() const = 0;
+        // Memory used to keep track of torrent files, in bytes
+        virtual qint64 filesMemoryUsage() const = 0;
 
         virtual TorrentInfo info() const = 0;
         virtual bool isFinished() const = 0;
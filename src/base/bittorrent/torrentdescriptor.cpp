@@ -75,12 +75,12 @@ namespace
 
     lt::load_torrent_limits loadTorrentLimits()
     {
-        const auto *pref = Preferences::instance();
+        const std::shared_ptr<const Preferences::Snapshot> pref = Preferences::instance()->snapshot();
 
         lt::load_torrent_limits limits;
-        limits.max_buffer_size = static_cast<int>(pref->getTorrentFileSizeLimit());
-        limits.max_decode_depth = pref->getBdecodeDepthLimit();
-        limits.max_decode_tokens = pref->getBdecodeTokenLimit();
+        limits.max_buffer_size = static_cast<int>(pref->torrentFileSizeLimit);
+        limits.max_decode_depth = pref->bdecodeDepthLimit;
+        limits.max_decode_tokens = pref->bdecodeTokenLimit;
 
         return limits;
     }
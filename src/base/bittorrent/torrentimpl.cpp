@@ -296,6 +296,15 @@ namespace
     {
         return ((value < 0) || (value == std::numeric_limits<int>::max())) ? 0 : value;
     }
+
+    int effectiveLimitValue(const int limit, const int scheduledLimit)
+    {
+        if (limit <= 0)
+            return scheduledLimit;
+        if (scheduledLimit <= 0)
+            return limit;
+        return std::min(limit, scheduledLimit);
+    }
 }
 
 // TorrentImpl
@@ -345,10 +354,10 @@ TorrentImpl::TorrentImpl(SessionImpl *session, const lt::torrent_handle &nativeH
         m_torrentInfo = TorrentInfo(*m_ltAddTorrentParams.ti);
 
         Q_ASSERT(m_filePaths.isEmpty());
-        Q_ASSERT(m_indexMap.isEmpty());
+        Q_ASSERT(m_indexMap.empty());
         const int filesCount = m_torrentInfo.filesCount();
         m_filePaths.reserve(filesCount);
-        m_indexMap.reserve(filesCount);
+        m_indexMap.assign(m_ltAddTorrentParams.ti->num_files(), -1);
         m_filePriorities.reserve(filesCount);
         const std::vector<lt::download_priority_t> filePriorities =
                 resized(m_ltAddTorrentParams.file_priorities, m_ltAddTorrentParams.ti->num_files()
@@ -357,10 +366,11 @@ TorrentImpl::TorrentImpl(SessionImpl *session, const lt::torrent_handle &nativeH
         m_completedFiles.fill(static_cast<bool>(m_ltAddTorrentParams.flags & lt::torrent_flags::seed_mode), filesCount);
         m_filesProgress.resize(filesCount);
 
+        const QList<lt::file_index_t> &nativeIndexes = m_torrentInfo.nativeIndexes();
         for (int i = 0; i < filesCount; ++i)
         {
-            const lt::file_index_t nativeIndex = m_torrentInfo.nativeIndexes().at(i);
-            m_indexMap[nativeIndex] = i;
+            const lt::file_index_t nativeIndex = nativeIndexes.at(i);
+            m_indexMap[LT::toUnderlyingType(nativeIndex)] = i;
 
             const auto fileIter = m_ltAddTorrentParams.renamed_files.find(nativeIndex);
             const Path filePath = ((fileIter != m_ltAddTorrentParams.renamed_files.end())
@@ -563,7 +573,7 @@ Path TorrentImpl::rootPath() const
     if (!hasMetadata())
         return {};
 
-    const Path relativeRootPath = Path::findRootFolder(filePaths());
+    const Path relativeRootPath = m_filePaths.findRootFolder();
     if (relativeRootPath.isEmpty())
         return {};
 
@@ -1093,12 +1103,12 @@ Path TorrentImpl::filePath(const int index) const
     Q_ASSERT(index >= 0);
     Q_ASSERT(index < m_filePaths.size());
 
-    return m_filePaths.value(index, {});
+    return m_filePaths.at(index);
 }
 
 Path TorrentImpl::actualFilePath(const int index) const
 {
-    const QList<lt::file_index_t> nativeIndexes = m_torrentInfo.nativeIndexes();
+    const QList<lt::file_index_t> &nativeIndexes = m_torrentInfo.nativeIndexes();
 
     Q_ASSERT(index >= 0);
     Q_ASSERT(index < nativeIndexes.size());
@@ -1121,7 +1131,7 @@ qlonglong TorrentImpl::fileSize(const int index) const
 
 PathList TorrentImpl::filePaths() const
 {
-    return m_filePaths;
+    return m_filePaths.toList();
 }
 
 PathList TorrentImpl::actualFilePaths() const
@@ -1144,6 +1154,17 @@ PathList TorrentImpl::actualFilePaths() const
     return paths;
 }
 
+qint64 TorrentImpl::filesMemoryUsage() const
+{
+    const auto containerSize = []<typename Container>(const Container &container) -> qint64
+    {
+        return static_cast<qint64>(container.capacity() * sizeof(typename Container::value_type));
+    };
+
+    return m_filePaths.memoryUsage() + containerSize(m_indexMap) + containerSize(m_filePriorities)
+        + containerSize(m_filesProgress) + (m_completedFiles.size() / 8);
+}
+
 QList<DownloadPriority> TorrentImpl::filePriorities() const
 {
     return m_filePriorities;
@@ -1885,7 +1906,7 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
     const std::shared_ptr<lt::torrent_info> metadata = std::const_pointer_cast<lt::torrent_info>(nativeTorrentInfo());
     m_torrentInfo = TorrentInfo(*metadata);
     m_filePriorities.reserve(filesCount());
-    const auto nativeIndexes = m_torrentInfo.nativeIndexes();
+    const QList<lt::file_index_t> &nativeIndexes = m_torrentInfo.nativeIndexes();
 
     p.file_priorities = resized(p.file_priorities, nativeTorrentInfo()->num_files()
             , LT::toNative(p.file_priorities.empty() ? DownloadPriority::Normal : DownloadPriority::Ignored));
@@ -1894,6 +1915,8 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
     m_filesProgress.resize(filesCount());
     updateProgress();
 
+    PathList filePaths;
+    filePaths.reserve(fileNames.size());
     for (qsizetype i = 0; i < fileNames.size(); ++i)
     {
         const auto nativeIndex = nativeIndexes.at(i);
@@ -1902,12 +1925,13 @@ void TorrentImpl::endReceivedMetadataHandling(const Path &savePath, const PathLi
         p.renamed_files[nativeIndex] = actualFilePath.toString().toStdString();
 
         const Path filePath = actualFilePath.removedExtension(QB_EXT);
+        filePaths.append(filePath);
         m_filePaths.append(filePath);
 
         m_filePriorities.append(LT::fromNative(p.file_priorities[LT::toUnderlyingType(nativeIndex)]));
     }
 
-    m_session->applyFilenameFilter(m_filePaths, m_filePriorities);
+    m_session->applyFilenameFilter(filePaths, m_filePriorities);
     for (qsizetype i = 0; i < m_filePriorities.size(); ++i)
         p.file_priorities[LT::toUnderlyingType(nativeIndexes[i])] = LT::toNative(m_filePriorities[i]);
 
@@ -1946,6 +1970,9 @@ void TorrentImpl::reload()
     {
         lt::add_torrent_params p = m_ltAddTorrentParams;
         p.flags |= lt::torrent_flags::update_subscribe;
+        // stored params hold user limits only so scheduled ones need to be applied again
+        p.upload_limit = effectiveLimitValue(m_uploadLimit, m_scheduledUploadLimit);
+        p.download_limit = effectiveLimitValue(m_downloadLimit, m_scheduledDownloadLimit);
 #if LIBTORRENT_VERSION_NUM < 20100
         p.flags |= lt::torrent_flags::override_trackers
                 | lt::torrent_flags::override_web_seeds;
@@ -2209,7 +2236,7 @@ void TorrentImpl::handleSaveResumeData(lt::add_torrent_params params)
 
     if ((m_maintenanceJob == MaintenanceJob::HandleMetadata) && params.ti)
     {
-        Q_ASSERT(m_indexMap.isEmpty());
+        Q_ASSERT(m_indexMap.empty());
 
         const auto isSeedMode = static_cast<bool>(m_ltAddTorrentParams.flags & lt::torrent_flags::seed_mode);
         m_ltAddTorrentParams = std::move(params);
@@ -2240,12 +2267,12 @@ void TorrentImpl::handleSaveResumeData(lt::add_torrent_params params)
             }
         }
 
-        const auto nativeIndexes = metadata.nativeIndexes();
-        m_indexMap.reserve(filePaths.size());
+        const QList<lt::file_index_t> &nativeIndexes = metadata.nativeIndexes();
+        m_indexMap.assign(m_ltAddTorrentParams.ti->num_files(), -1);
         for (qsizetype i = 0; i < filePaths.size(); ++i)
         {
             const auto nativeIndex = nativeIndexes.at(i);
-            m_indexMap[nativeIndex] = i;
+            m_indexMap[LT::toUnderlyingType(nativeIndex)] = i;
 
             if (const auto it = renamedFiles.find(nativeIndex); it != renamedFiles.cend())
                 filePaths[i] = Path(it->second);
@@ -2303,6 +2330,9 @@ void TorrentImpl::prepareResumeData(lt::add_torrent_params params)
 
     // We shouldn't save upload_mode flag to allow torrent operate normally on next run
     m_ltAddTorrentParams.flags &= ~lt::torrent_flags::upload_mode;
+    // Native limits may include the ones imposed by bandwidth rules
+    m_ltAddTorrentParams.upload_limit = m_uploadLimit;
+    m_ltAddTorrentParams.download_limit = m_downloadLimit;
 
     LoadTorrentParams resumeData
     {
@@ -2377,7 +2407,7 @@ void TorrentImpl::handleFileRenamed(const lt::file_index_t nativeFileIndex, cons
     }
     else
     {
-        m_filePaths[fileIndex] = newFilePath;
+        m_filePaths.replace(fileIndex, newFilePath);
 
         // Remove empty leftover folders
         // For example renaming "a/b/c" to "d/b/c", then folders "a/b" and "a" will
@@ -2560,7 +2590,7 @@ void TorrentImpl::adjustStorageLocation()
 
 void TorrentImpl::doRenameFile(const int index, const Path &path, const int folderRenameJobID)
 {
-    const QList<lt::file_index_t> nativeIndexes = m_torrentInfo.nativeIndexes();
+    const QList<lt::file_index_t> &nativeIndexes = m_torrentInfo.nativeIndexes();
 
     Q_ASSERT(index >= 0);
     Q_ASSERT(index < nativeIndexes.size());
@@ -2578,7 +2608,8 @@ lt::torrent_handle TorrentImpl::nativeHandle() const
 
 int TorrentImpl::fileIndexFromNative(const lt::file_index_t nativeFileIndex) const
 {
-    return m_indexMap.value(nativeFileIndex, -1);
+    const auto index = static_cast<std::size_t>(LT::toUnderlyingType(nativeFileIndex));
+    return (index < m_indexMap.size()) ? m_indexMap[index] : -1;
 }
 
 void TorrentImpl::setMetadata(const TorrentInfo &torrentInfo)
@@ -2714,7 +2745,7 @@ void TorrentImpl::updateProgress()
         int64_t size = m_torrentInfo.pieceLength(index);
         int64_t pieceOffset = index * pieceSize;
 
-        for (const int fileIndex : asConst(m_torrentInfo.fileIndicesForPiece(index)))
+        for (const int fileIndex : m_torrentInfo.pieceFileIndexes(index))
         {
             const int64_t fileOffsetInPiece = pieceOffset - m_torrentInfo.fileOffset(fileIndex);
             const int64_t add = std::min<int64_t>((m_torrentInfo.fileSize(fileIndex) - fileOffsetInPiece), size);
@@ -2737,7 +2768,7 @@ void TorrentImpl::setUploadLimit(const int limit)
         return;
 
     m_uploadLimit = cleanValue;
-    m_nativeHandle.set_upload_limit(m_uploadLimit);
+    m_nativeHandle.set_upload_limit(effectiveLimitValue(m_uploadLimit, m_scheduledUploadLimit));
     deferredRequestResumeData();
 }
 
@@ -2748,10 +2779,25 @@ void TorrentImpl::setDownloadLimit(const int limit)
         return;
 
     m_downloadLimit = cleanValue;
-    m_nativeHandle.set_download_limit(m_downloadLimit);
+    m_nativeHandle.set_download_limit(effectiveLimitValue(m_downloadLimit, m_scheduledDownloadLimit));
     deferredRequestResumeData();
 }
 
+void TorrentImpl::setScheduledRateLimits(const int uploadLimit, const int downloadLimit)
+{
+    if (uploadLimit != m_scheduledUploadLimit)
+    {
+        m_scheduledUploadLimit = uploadLimit;
+        m_nativeHandle.set_upload_limit(effectiveLimitValue(m_uploadLimit, m_scheduledUploadLimit));
+    }
+
+    if (downloadLimit != m_scheduledDownloadLimit)
+    {
+        m_scheduledDownloadLimit = downloadLimit;
+        m_nativeHandle.set_download_limit(effectiveLimitValue(m_downloadLimit, m_scheduledDownloadLimit));
+    }
+}
+
 void TorrentImpl::setSuperSeeding(const bool enable)
 {
     if (enable == superSeeding())
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <libtorrent/add_torrent_params.hpp>
 #include <libtorrent/fwd.hpp>
@@ -49,6 +50,7 @@
 
 #include "base/path.h"
 #include "base/tagset.h"
+#include "compactpathlist.h"
 #include "infohash.h"
 #include "speedmonitor.h"
 #include "sslparameters.h"
@@ -157,6 +159,7 @@ namespace BitTorrent
         qlonglong fileSize(int index) const override;
         PathList filePaths() const override;
         PathList actualFilePaths() const override;
+        qint64 filesMemoryUsage() const override;
         QList<DownloadPriority> filePriorities() const override;
 
         TorrentInfo info() const override;
@@ -260,6 +263,9 @@ namespace BitTorrent
 
         int fileIndexFromNative(lt::file_index_t nativeFileIndex) const;
 
+        // Limits imposed by bandwidth rules on top of the user defined ones
+        void setScheduledRateLimits(int uploadLimit, int downloadLimit);
+
         void handleStateUpdate(const lt::torrent_status &nativeStatus);
         void handleFastResumeRejected();
         void handleFileCompleted(lt::file_index_t nativeFileIndex);
@@ -332,8 +338,9 @@ namespace BitTorrent
         mutable lt::torrent_status m_nativeStatus;
         TorrentState m_state = TorrentState::Unknown;
         TorrentInfo m_torrentInfo;
-        PathList m_filePaths;
-        QHash<lt::file_index_t, int> m_indexMap;
+        CompactPathList m_filePaths;
+        // qBittorrent file indexes by native file indexes (-1 for pad files)
+        std::vector<int> m_indexMap;
         QList<DownloadPriority> m_filePriorities;
         QBitArray m_completedFiles;
         SpeedMonitor m_payloadRateMonitor;
@@ -389,6 +396,8 @@ namespace BitTorrent
 
         int m_downloadLimit = 0;
         int m_uploadLimit = 0;
+        int m_scheduledDownloadLimit = 0;
+        int m_scheduledUploadLimit = 0;
 
         QBitArray m_pieces;
         QList<std::int64_t> m_filesProgress;
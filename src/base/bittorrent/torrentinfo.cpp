@@ -28,6 +28,9 @@
 
 #include "torrentinfo.h"
 
+#include <mutex>
+#include <vector>
+
 #include <libtorrent/version.hpp>
 
 #include <QByteArray>
@@ -54,10 +57,19 @@ namespace
 
 using namespace BitTorrent;
 
+// Files of piece `i` are `fileIndexes[pieceOffsets[i]]` .. `fileIndexes[pieceOffsets[i + 1] - 1]`
+struct TorrentInfo::PieceFileMap
+{
+    std::once_flag builtFlag;
+    std::vector<int> pieceOffsets;
+    std::vector<int> fileIndexes;
+};
+
 const int TORRENTINFO_TYPEID = qRegisterMetaType<TorrentInfo>();
 
 TorrentInfo::TorrentInfo(const lt::torrent_info &nativeInfo)
     : m_nativeInfo {std::make_shared<const lt::torrent_info>(nativeInfo)}
+    , m_pieceFileMap {std::make_shared<PieceFileMap>()}
 {
     Q_ASSERT(m_nativeInfo->is_valid() && (m_nativeInfo->num_files() > 0));
 
@@ -76,6 +88,7 @@ TorrentInfo &TorrentInfo::operator=(const TorrentInfo &other)
     {
         m_nativeInfo = other.m_nativeInfo;
         m_nativeIndexes = other.m_nativeIndexes;
+        m_pieceFileMap = other.m_pieceFileMap;
     }
     return *this;
 }
@@ -205,11 +218,11 @@ QByteArray TorrentInfo::rawData() const
 
 PathList TorrentInfo::filesForPiece(const int pieceIndex) const
 {
-    // no checks here because fileIndicesForPiece() will return an empty list
-    const QList<int> fileIndices = fileIndicesForPiece(pieceIndex);
+    // no checks here because pieceFileIndexes() will return an empty span
+    const std::span<const int> fileIndices = pieceFileIndexes(pieceIndex);
 
     PathList res;
-    res.reserve(fileIndices.size());
+    res.reserve(static_cast<qsizetype>(fileIndices.size()));
     for (const int i : fileIndices)
         res.push_back(filePath(i));
 
@@ -217,22 +230,72 @@ PathList TorrentInfo::filesForPiece(const int pieceIndex) const
 }
 
 QList<int> TorrentInfo::fileIndicesForPiece(const int pieceIndex) const
+{
+    const std::span<const int> fileIndices = pieceFileIndexes(pieceIndex);
+    return QList<int>(fileIndices.begin(), fileIndices.end());
+}
+
+std::span<const int> TorrentInfo::pieceFileIndexes(const int pieceIndex) const
 {
     if (!isValid() || (pieceIndex < 0) || (pieceIndex >= piecesCount()))
         return {};
 
-    const std::vector<lt::file_slice> files = m_nativeInfo->map_block(
-                lt::piece_index_t {pieceIndex}, 0, m_nativeInfo->piece_size(lt::piece_index_t {pieceIndex}));
-    QList<int> res;
-    res.reserve(static_cast<decltype(res)::size_type>(files.size()));
-    for (const lt::file_slice &fileSlice : files)
-    {
-        const qsizetype index = m_nativeIndexes.indexOf(fileSlice.file_index);
-        if (index >= 0)
-            res.append(index);
-    }
+    const PieceFileMap &map = pieceFileMap();
+    const int first = map.pieceOffsets[pieceIndex];
+    const int last = map.pieceOffsets[pieceIndex + 1];
+    return std::span<const int>(map.fileIndexes).subspan(first, (last - first));
+}
 
-    return res;
+const TorrentInfo::PieceFileMap &TorrentInfo::pieceFileMap() const
+{
+    Q_ASSERT(isValid());
+
+    std::call_once(m_pieceFileMap->builtFlag, [this]
+    {
+        const lt::file_storage &files = getFileStorage(*m_nativeInfo);
+        const qlonglong pieceLength = m_nativeInfo->piece_length();
+        const int piecesCount = m_nativeInfo->num_pieces();
+
+        // Empty files don't occupy any piece, libtorrent doesn't map blocks to them either
+        const auto fileRange = [&files, pieceLength](const lt::file_index_t nativeIndex)
+        {
+            const qlonglong offset = files.file_offset(nativeIndex);
+            const qlonglong size = files.file_size(nativeIndex);
+            return std::pair(static_cast<int>(offset / pieceLength), static_cast<int>((offset + size - 1) / pieceLength));
+        };
+
+        // Count files of each piece first, then lay them out in a single array
+        std::vector<int> pieceOffsets(piecesCount + 1, 0);
+        for (const lt::file_index_t nativeIndex : asConst(m_nativeIndexes))
+        {
+            if (files.file_size(nativeIndex) <= 0)
+                continue;
+
+            const auto [firstPiece, lastPiece] = fileRange(nativeIndex);
+            for (int piece = firstPiece; piece <= lastPiece; ++piece)
+                ++pieceOffsets[piece + 1];
+        }
+        for (int piece = 0; piece < piecesCount; ++piece)
+            pieceOffsets[piece + 1] += pieceOffsets[piece];
+
+        std::vector<int> fileIndexes(pieceOffsets.back());
+        std::vector<int> fillPositions(pieceOffsets.begin(), (pieceOffsets.end() - 1));
+        for (int index = 0; index < m_nativeIndexes.size(); ++index)
+        {
+            const lt::file_index_t nativeIndex = m_nativeIndexes[index];
+            if (files.file_size(nativeIndex) <= 0)
+                continue;
+
+            const auto [firstPiece, lastPiece] = fileRange(nativeIndex);
+            for (int piece = firstPiece; piece <= lastPiece; ++piece)
+                fileIndexes[fillPositions[piece]++] = index;
+        }
+
+        m_pieceFileMap->pieceOffsets = std::move(pieceOffsets);
+        m_pieceFileMap->fileIndexes = std::move(fileIndexes);
+    });
+
+    return *m_pieceFileMap;
 }
 
 QList<QByteArray> TorrentInfo::pieceHashes() const
@@ -324,7 +387,7 @@ std::shared_ptr<lt::torrent_info> TorrentInfo::nativeInfo() const
     return std::make_shared<lt::torrent_info>(*m_nativeInfo);
 }
 
-QList<lt::file_index_t> TorrentInfo::nativeIndexes() const
+const QList<lt::file_index_t> &TorrentInfo::nativeIndexes() const
 {
     return m_nativeIndexes;
 }
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <memory>
+#include <span>
+
 #include <libtorrent/torrent_info.hpp>
 
 #include <QtContainerFwd>
@@ -72,6 +75,9 @@ namespace BitTorrent
         qlonglong fileOffset(int index) const;
         PathList filesForPiece(int pieceIndex) const;
         QList<int> fileIndicesForPiece(int pieceIndex) const;
+        // same as fileIndicesForPiece() but doesn't allocate, the returned span
+        // stays valid as long as any copy of this TorrentInfo exists
+        std::span<const int> pieceFileIndexes(int pieceIndex) const;
         QList<QByteArray> pieceHashes() const;
 
         using PieceRange = IndexRange<int>;
@@ -85,17 +91,23 @@ namespace BitTorrent
         bool matchesInfoHash(const InfoHash &otherInfoHash) const;
 
         std::shared_ptr<lt::torrent_info> nativeInfo() const;
-        QList<lt::file_index_t> nativeIndexes() const;
+        const QList<lt::file_index_t> &nativeIndexes() const;
 
     private:
         // returns file index or -1 if fileName is not found
         int fileIndex(const Path &filePath) const;
 
+        struct PieceFileMap;
+        const PieceFileMap &pieceFileMap() const;
+
         std::shared_ptr<const lt::torrent_info> m_nativeInfo;
 
         // internal indexes of files (payload only, excluding any .pad files)
         // by which they are addressed in libtorrent
         QList<lt::file_index_t> m_nativeIndexes;
+
+        // built on first use and shared between copies
+        std::shared_ptr<PieceFileMap> m_pieceFileMap;
     };
 }
 
@@ -0,0 +1,232 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "transferhistory.h"
+
+#include <algorithm>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QList>
+#include <QStringList>
+
+namespace
+{
+    const quint32 FILE_MAGIC = 0x71627468;  // "qbth"
+    const quint32 FILE_VERSION = 1;
+
+    const std::array<qint64, 3> BUCKET_SIZES {1, 60, 60 * 60};
+    const std::array<qint64, 3> BUCKET_COUNTS {60 * 60, 24 * 60, 30 * 24};
+
+    qint64 floorDiv(const qint64 value, const qint64 divisor)
+    {
+        const qint64 result = value / divisor;
+        return (((value % divisor) != 0) && ((value < 0) != (divisor < 0))) ? (result - 1) : result;
+    }
+
+    qint64 proportion(const qint64 value, const qint64 part, const qint64 whole)
+    {
+        // Avoid integer overflow on long periods
+        return static_cast<qint64>((static_cast<double>(value) * part) / whole);
+    }
+}
+
+qint64 BitTorrent::TransferHistory::resolutionSeconds(const Resolution resolution)
+{
+    return BUCKET_SIZES[static_cast<int>(resolution)];
+}
+
+BitTorrent::TransferHistory::Series BitTorrent::TransferHistory::createSeries()
+{
+    Series series;
+    for (std::size_t i = 0; i < series.size(); ++i)
+        series[i].buckets.resize(BUCKET_COUNTS[i]);
+    return series;
+}
+
+void BitTorrent::TransferHistory::addToRing(Ring &ring, const qint64 bucketSize, const qint64 startTime, const qint64 endTime, const Counters &bytes)
+{
+    const auto capacity = static_cast<qint64>(ring.buckets.size());
+    const qint64 bucketMSecs = bucketSize * 1000;
+    const qint64 endBucket = floorDiv(std::max(startTime, (endTime - 1)), bucketMSecs);
+
+    if (endBucket > ring.lastBucket)
+    {
+        const qint64 firstStaleBucket = std::max((ring.lastBucket + 1), (endBucket - capacity + 1));
+        for (qint64 bucket = firstStaleBucket; bucket <= endBucket; ++bucket)
+            ring.buckets[bucket % capacity] = {};
+        ring.lastBucket = endBucket;
+    }
+
+    const qint64 oldestBucket = ring.lastBucket - capacity + 1;
+    const qint64 duration = endTime - startTime;
+    if (duration <= 0)
+    {
+        if (endBucket >= oldestBucket)
+        {
+            Counters &counters = ring.buckets[endBucket % capacity];
+            counters.download += bytes.download;
+            counters.upload += bytes.upload;
+        }
+        return;
+    }
+
+    // Distribute cumulatively so that no bytes are lost to rounding
+    const qint64 startBucket = std::max(floorDiv(startTime, bucketMSecs), oldestBucket);
+    Counters distributed;
+    for (qint64 bucket = startBucket; bucket <= endBucket; ++bucket)
+    {
+        const qint64 periodEnd = std::min(endTime, ((bucket + 1) * bucketMSecs));
+        const qint64 elapsed = periodEnd - startTime;
+        const Counters cumulative {
+            .download = proportion(bytes.download, elapsed, duration),
+            .upload = proportion(bytes.upload, elapsed, duration)
+        };
+
+        Counters &counters = ring.buckets[bucket % capacity];
+        counters.download += cumulative.download - distributed.download;
+        counters.upload += cumulative.upload - distributed.upload;
+        distributed = cumulative;
+    }
+}
+
+void BitTorrent::TransferHistory::record(const QString &series, const qint64 startTime, const qint64 endTime, const Counters &bytes)
+{
+    if (endTime < startTime)
+        return;
+
+    auto seriesIter = m_series.find(series);
+    if (seriesIter == m_series.end())
+        seriesIter = m_series.insert(series, createSeries());
+
+    for (std::size_t i = 0; i < seriesIter->size(); ++i)
+        addToRing((*seriesIter)[i], BUCKET_SIZES[i], startTime, endTime, bytes);
+}
+
+QList<BitTorrent::TransferHistory::Sample> BitTorrent::TransferHistory::samples(const QString &series, const Resolution resolution, const qint64 since) const
+{
+    const auto seriesIter = m_series.constFind(series);
+    if (seriesIter == m_series.cend())
+        return {};
+
+    const Ring &ring = (*seriesIter)[static_cast<int>(resolution)];
+    if (ring.lastBucket < 0)
+        return {};
+
+    const qint64 bucketSize = resolutionSeconds(resolution);
+    const auto capacity = static_cast<qint64>(ring.buckets.size());
+    // Include the bucket containing `since`
+    const qint64 firstBucket = std::max((ring.lastBucket - capacity + 1), floorDiv(since, bucketSize));
+
+    QList<Sample> result;
+    result.reserve(std::max<qint64>(0, (ring.lastBucket - firstBucket + 1)));
+    for (qint64 bucket = firstBucket; bucket <= ring.lastBucket; ++bucket)
+    {
+        const Counters &counters = ring.buckets[bucket % capacity];
+        result.append(Sample {.time = (bucket * bucketSize)
+            , .rates = {.download = (counters.download / bucketSize), .upload = (counters.upload / bucketSize)}});
+    }
+
+    return result;
+}
+
+QStringList BitTorrent::TransferHistory::seriesNames() const
+{
+    return m_series.keys();
+}
+
+void BitTorrent::TransferHistory::removeSeries(const QString &series)
+{
+    m_series.remove(series);
+}
+
+void BitTorrent::TransferHistory::clear()
+{
+    m_series.clear();
+}
+
+QByteArray BitTorrent::TransferHistory::serialize() const
+{
+    QByteArray data;
+    QDataStream stream {&data, QIODevice::WriteOnly};
+    stream.setVersion(QDataStream::Qt_6_6);
+
+    stream << FILE_MAGIC << FILE_VERSION << static_cast<quint32>(m_series.size());
+    for (auto it = m_series.cbegin(); it != m_series.cend(); ++it)
+    {
+        stream << it.key();
+        for (const Ring &ring : it.value())
+        {
+            stream << ring.lastBucket << static_cast<quint32>(ring.buckets.size());
+            for (const Counters &counters : ring.buckets)
+                stream << counters.download << counters.upload;
+        }
+    }
+
+    return data;
+}
+
+bool BitTorrent::TransferHistory::deserialize(const QByteArray &data)
+{
+    QDataStream stream {data};
+    stream.setVersion(QDataStream::Qt_6_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 seriesCount = 0;
+    stream >> magic >> version >> seriesCount;
+    if ((stream.status() != QDataStream::Ok) || (magic != FILE_MAGIC) || (version != FILE_VERSION))
+        return false;
+
+    QHash<QString, Series> seriesHash;
+    for (quint32 seriesIndex = 0; seriesIndex < seriesCount; ++seriesIndex)
+    {
+        QString name;
+        stream >> name;
+
+        Series series = createSeries();
+        for (Ring &ring : series)
+        {
+            quint32 bucketCount = 0;
+            stream >> ring.lastBucket >> bucketCount;
+            if ((stream.status() != QDataStream::Ok) || (bucketCount != ring.buckets.size()))
+                return false;
+
+            for (Counters &counters : ring.buckets)
+                stream >> counters.download >> counters.upload;
+        }
+
+        if (stream.status() != QDataStream::Ok)
+            return false;
+
+        seriesHash.insert(name, std::move(series));
+    }
+
+    m_series = std::move(seriesHash);
+    return true;
+}
@@ -0,0 +1,94 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <QtContainerFwd>
+#include <QHash>
+#include <QString>
+
+class QByteArray;
+
+namespace BitTorrent
+{
+    // Keeps amounts of transferred data in fixed-size rings of 1 second, 1 minute and 1 hour buckets
+    // (covering last hour, day and month respectively) for a number of named series
+    class TransferHistory
+    {
+    public:
+        enum class Resolution
+        {
+            Second,
+            Minute,
+            Hour
+        };
+
+        struct Counters
+        {
+            qint64 download = 0;
+            qint64 upload = 0;
+        };
+
+        struct Sample
+        {
+            qint64 time = 0;  // start of the bucket, in seconds since epoch
+            Counters rates;  // in bytes per second
+        };
+
+        static qint64 resolutionSeconds(Resolution resolution);
+
+        // `startTime` and `endTime` are in milliseconds since epoch,
+        // `bytes` are spread over the buckets in proportion to their overlap with the period
+        void record(const QString &series, qint64 startTime, qint64 endTime, const Counters &bytes);
+        // the last sample may cover an incomplete period
+        QList<Sample> samples(const QString &series, Resolution resolution, qint64 since = 0) const;
+        QStringList seriesNames() const;
+        void removeSeries(const QString &series);
+        void clear();
+
+        QByteArray serialize() const;
+        bool deserialize(const QByteArray &data);
+
+    private:
+        struct Ring
+        {
+            qint64 lastBucket = -1;
+            std::vector<Counters> buckets;
+        };
+
+        using Series = std::array<Ring, 3>;
+
+        static Series createSeries();
+        static void addToRing(Ring &ring, qint64 bucketSize, qint64 startTime, qint64 endTime, const Counters &bytes);
+
+        QHash<QString, Series> m_series;
+    };
+}
@@ -32,20 +32,24 @@
 
 #include <QMetaObject>
 #include <QTcpSocket>
+#include <QThread>
 
 #include "constants.h"
 #include "environment.h"
 #include "irequesthandler.h"
 #include "requestparser.h"
+#include "responsewriterproxy.h"
 
-Http::Connection::Connection(QTcpSocket *socket, IRequestHandler *requestHandler, QObject *parent)
+Http::Connection::Connection(QTcpSocket *socket, IRequestHandler *requestHandler, QObject *requestHandlerContext, QObject *parent)
     : QObject(parent)
     , m_socket {socket}
     , m_requestHandler {requestHandler}
+    , m_requestHandlerContext {requestHandlerContext}
     , m_responseWriter {ResponseWriterImpl(socket)}
 {
     Q_ASSERT(socket);
     Q_ASSERT(requestHandler);
+    Q_ASSERT(requestHandlerContext);
 
     m_socket->setParent(this);
     connect(m_socket, &QAbstractSocket::disconnected, this, &Connection::closed);
@@ -128,9 +132,27 @@ bool Http::Connection::processRequest()
             const Environment env {m_socket->localAddress(), m_socket->localPort(), m_socket->peerAddress(), m_socket->peerPort()};
 
             m_responseWriter.prepare(result.request);
-            m_requestHandler->processRequest(result.request, env, m_responseWriter);
-            if (!m_responseWriter.isFinished())
+
+            if (m_requestHandlerContext->thread() == thread())
+            {
+                m_requestHandler->processRequest(result.request, env, m_responseWriter);
+                if (!m_responseWriter.isFinished())
+                    m_isProcessingRequest = true;
+            }
+            else
+            {
+                // Request handler is invoked in its own thread while response is still serialized and sent by this one
                 m_isProcessingRequest = true;
+
+                auto *responseWriterProxy = new ResponseWriterProxy(&m_responseWriter);
+                responseWriterProxy->moveToThread(m_requestHandlerContext->thread());
+                QMetaObject::invokeMethod(m_requestHandlerContext
+                        , [requestHandler = m_requestHandler, responseWriterProxy, request = result.request, env]
+                {
+                    requestHandler->processRequest(request, env, *responseWriterProxy);
+                    responseWriterProxy->deleteWhenResponded();
+                });
+            }
         }
         return true;
 
@@ -175,7 +197,9 @@ void Http::Connection::abort(const ResponseStatus &responseStatus)
 
 bool Http::Connection::hasExpired(const qint64 timeout) const
 {
-    return (m_socket->bytesAvailable() == 0)
+    // streamed responses are long-lived by design
+    return !m_responseWriter.isStreaming()
+        && (m_socket->bytesAvailable() == 0)
         && (m_socket->bytesToWrite() == 0)
         && m_idleTimer.hasExpired(timeout);
 }
@@ -47,7 +47,8 @@ namespace Http
         Q_DISABLE_COPY_MOVE(Connection)
 
     public:
-        Connection(QTcpSocket *socket, IRequestHandler *requestHandler, QObject *parent = nullptr);
+        // `requestHandler` is invoked in the thread `requestHandlerContext` belongs to
+        Connection(QTcpSocket *socket, IRequestHandler *requestHandler, QObject *requestHandlerContext, QObject *parent = nullptr);
 
         bool hasExpired(qint64 timeout) const;
 
@@ -61,6 +62,7 @@ namespace Http
 
         QTcpSocket *m_socket = nullptr;
         IRequestHandler *m_requestHandler = nullptr;
+        QObject *m_requestHandlerContext = nullptr;
         QByteArray m_receivedData;
         QElapsedTimer m_idleTimer;
         bool m_isProcessingRequest = false;
@@ -71,6 +71,8 @@ namespace Http
     inline const QString CONTENT_TYPE_JPEG = u"image/jpeg"_s;
     inline const QString CONTENT_TYPE_JS = u"text/javascript"_s;
     inline const QString CONTENT_TYPE_JSON = u"application/json"_s;
+    inline const QString CONTENT_TYPE_EVENT_STREAM = u"text/event-stream"_s;
+    inline const QString CONTENT_TYPE_PROMETHEUS = u"text/plain; version=0.0.4; charset=utf-8"_s;
     inline const QString CONTENT_TYPE_GIF = u"image/gif"_s;
     inline const QString CONTENT_TYPE_PNG = u"image/png"_s;
     inline const QString CONTENT_TYPE_WEBP = u"image/webp"_s;
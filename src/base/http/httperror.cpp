@@ -76,6 +76,11 @@ UnsupportedMediaTypeHTTPError::UnsupportedMediaTypeHTTPError(const QString &mess
 {
 }
 
+TooManyRequestsHTTPError::TooManyRequestsHTTPError(const QString &message)
+    : HTTPError({.code = 429, .text = u"Too Many Requests"_s}, message)
+{
+}
+
 InternalServerErrorHTTPError::InternalServerErrorHTTPError(const QString &message)
     : HTTPError({.code = 500, .text = u"Internal Server Error"_s}, message)
 {
@@ -84,6 +84,12 @@ public:
     explicit UnsupportedMediaTypeHTTPError(const QString &message = {});
 };
 
+class TooManyRequestsHTTPError : public HTTPError
+{
+public:
+    explicit TooManyRequestsHTTPError(const QString &message = {});
+};
+
 class InternalServerErrorHTTPError : public HTTPError
 {
 public:
@@ -38,6 +38,8 @@ namespace Http
     {
     public:
         virtual ~IRequestHandler() = default;
+        // Response may also be set after returning, `responseWriter` is destroyed only once it has responded
+        // unless the connection is closed meanwhile
         virtual void processRequest(const Request &request, const Environment &env, ResponseWriter &responseWriter) = 0;
     };
 }
@@ -0,0 +1,110 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "responsestream.h"
+
+#include <utility>
+
+#include <QMutexLocker>
+#include <QObject>
+
+void Http::ResponseStream::write(const QByteArray &data)
+{
+    if (data.isEmpty())
+        return;
+
+    const QMutexLocker locker {&m_mutex};
+    if (m_isClosed)
+        return;
+
+    m_buffer.append(data);
+    notifyWriter();
+}
+
+void Http::ResponseStream::close()
+{
+    const QMutexLocker locker {&m_mutex};
+    if (m_isClosed)
+        return;
+
+    m_isClosed = true;
+    notifyWriter();
+}
+
+bool Http::ResponseStream::isClosed() const
+{
+    const QMutexLocker locker {&m_mutex};
+    return m_isClosed;
+}
+
+qint64 Http::ResponseStream::pendingDataSize() const
+{
+    const QMutexLocker locker {&m_mutex};
+    return m_buffer.size() + m_unsentDataSize;
+}
+
+void Http::ResponseStream::attach(QObject *writer, std::function<void ()> dataHandler)
+{
+    Q_ASSERT(writer);
+
+    const QMutexLocker locker {&m_mutex};
+    m_writer = writer;
+    m_dataHandler = std::move(dataHandler);
+    if (!m_buffer.isEmpty() || m_isClosed)
+        notifyWriter();
+}
+
+void Http::ResponseStream::detach()
+{
+    const QMutexLocker locker {&m_mutex};
+    m_writer = nullptr;
+    m_dataHandler = {};
+    m_buffer.clear();
+    m_unsentDataSize = 0;
+    m_isClosed = true;
+}
+
+Http::ResponseStream::TakenData Http::ResponseStream::takeData()
+{
+    const QMutexLocker locker {&m_mutex};
+    return {.data = std::exchange(m_buffer, {}), .isClosed = m_isClosed};
+}
+
+void Http::ResponseStream::setUnsentDataSize(const qint64 size)
+{
+    const QMutexLocker locker {&m_mutex};
+    m_unsentDataSize = size;
+}
+
+void Http::ResponseStream::notifyWriter()
+{
+    // Writer can't be destroyed meanwhile since it has to call `detach()` first, which requires the lock.
+    // Queued invocation is used so writer is always notified in its own thread and never reentrantly.
+    if (m_writer)
+        QMetaObject::invokeMethod(m_writer, m_dataHandler, Qt::QueuedConnection);
+}
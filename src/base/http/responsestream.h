@@ -0,0 +1,79 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <functional>
+
+#include <QByteArray>
+#include <QMutex>
+
+class QObject;
+
+namespace Http
+{
+    // Response body of unknown length (e.g. server-sent events) that is produced
+    // by request handler and sent by ResponseWriter, possibly from different threads.
+    // Shared between both parties, so it remains valid for either of them regardless of the other.
+    class ResponseStream final
+    {
+        Q_DISABLE_COPY_MOVE(ResponseStream)
+
+    public:
+        ResponseStream() = default;
+
+        // To be used by data producer
+        void write(const QByteArray &data);
+        void close();
+        bool isClosed() const;
+        // Size of data that is written but not yet sent to peer
+        qint64 pendingDataSize() const;
+
+        // To be used by ResponseWriter
+        struct TakenData
+        {
+            QByteArray data;
+            bool isClosed = false;
+        };
+
+        void attach(QObject *writer, std::function<void ()> dataHandler);
+        void detach();
+        TakenData takeData();
+        void setUnsentDataSize(qint64 size);
+
+    private:
+        void notifyWriter();
+
+        mutable QMutex m_mutex;
+        QByteArray m_buffer;
+        qint64 m_unsentDataSize = 0;
+        bool m_isClosed = false;
+        QObject *m_writer = nullptr;
+        std::function<void ()> m_dataHandler;
+    };
+}
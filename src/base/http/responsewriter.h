@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QObject>
 
 #include "base/pathfwd.h"
@@ -36,6 +38,8 @@
 
 namespace Http
 {
+    class ResponseStream;
+
     class ResponseWriter : public QObject
     {
         Q_OBJECT
@@ -52,6 +56,10 @@ namespace Http
         // Support Range requests.
         virtual void streamFile(const Path &filePath, const HeaderMap &headers) = 0;
 
+        // Send response content of unknown length as it is written to the returned stream.
+        // Connection is closed once the stream is closed by either party.
+        virtual std::shared_ptr<ResponseStream> openStream(const HeaderMap &headers) = 0;
+
         virtual bool isFinished() const = 0;
 
     signals:
@@ -47,6 +47,7 @@
 #include "base/path.h"
 #include "base/utils/gzip.h"
 #include "constants.h"
+#include "responsestream.h"
 
 const qint64 CHUNK_SIZE = 256 * 1024;
 const qint64 MAX_BUFFER_SIZE = 1024 * 1024;
@@ -279,7 +280,9 @@ Http::ResponseWriterImpl::ResponseWriterImpl(QAbstractSocket *socket, QObject *p
 
 Http::ResponseWriterImpl::~ResponseWriterImpl()
 {
-    if (m_isWritingContent)
+    if (m_stream)
+        m_stream->detach();
+    else if (m_isWritingContent)
         m_asyncWorker->abort();
 }
 
@@ -377,6 +380,69 @@ void Http::ResponseWriterImpl::streamFile(const Path &filePath, const HeaderMap
     m_isWritingContent = true;
 }
 
+std::shared_ptr<Http::ResponseStream> Http::ResponseWriterImpl::openStream(const HeaderMap &headers)
+{
+    auto stream = std::make_shared<ResponseStream>();
+    startStream(headers, stream);
+    return stream;
+}
+
+void Http::ResponseWriterImpl::startStream(const HeaderMap &headers, std::shared_ptr<ResponseStream> stream)
+{
+    Q_ASSERT(stream);
+    Q_ASSERT(!m_isFinished && !m_isWritingContent);
+    if (m_isFinished || m_isWritingContent) [[unlikely]]
+    {
+        stream->detach();
+        return;
+    }
+
+    // Content length is unknown, so the end of content is indicated by closing the connection
+    HeaderMap responseHeaders = headers;
+    responseHeaders.insert(HEADER_CONNECTION, u"close"_s);
+    responseHeaders.insert(HEADER_CACHE_CONTROL, u"no-cache"_s);
+    m_socket->write(serializeResponseHead({.code = 200, .text = u"OK"_s}, responseHeaders));
+
+    m_isWritingContent = true;
+    m_stream = std::move(stream);
+
+    if (m_request.method == HEADER_REQUEST_METHOD_HEAD)
+    {
+        m_stream->close();
+        processStream();
+        return;
+    }
+
+    connect(m_socket, &QAbstractSocket::bytesWritten, this, [this]
+    {
+        if (m_stream)
+            m_stream->setUnsentDataSize(m_socket->bytesToWrite());
+    });
+    m_stream->attach(this, [this] { processStream(); });
+}
+
+void Http::ResponseWriterImpl::processStream()
+{
+    if (!m_stream || !m_socket)
+        return;
+
+    const auto [data, isClosed] = m_stream->takeData();
+    if (!data.isEmpty())
+    {
+        if (m_socket->write(data) < 0)
+            m_socket->close();
+        m_stream->setUnsentDataSize(m_socket->bytesToWrite());
+    }
+
+    if (isClosed)
+    {
+        m_stream->detach();
+        m_stream.reset();
+        m_socket->disconnectFromHost();
+        finish();
+    }
+}
+
 void Http::ResponseWriterImpl::finish()
 {
     if (m_isFinished)
@@ -392,6 +458,11 @@ bool Http::ResponseWriterImpl::isFinished() const
     return m_isFinished;
 }
 
+bool Http::ResponseWriterImpl::isStreaming() const
+{
+    return static_cast<bool>(m_stream);
+}
+
 void Http::ResponseWriterImpl::writeData(const QByteArray &data)
 {
     Q_ASSERT(!data.isEmpty());
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QObject>
 #include <QPointer>
 
@@ -61,11 +63,18 @@ namespace Http
         // Support Range requests.
         void streamFile(const Path &filePath, const HeaderMap &headers) override;
 
+        // Send response content of unknown length as it is written to the returned stream.
+        // Connection is closed once the stream is closed by either party.
+        std::shared_ptr<ResponseStream> openStream(const HeaderMap &headers) override;
+        void startStream(const HeaderMap &headers, std::shared_ptr<ResponseStream> stream);
+
         bool isFinished() const override;
+        bool isStreaming() const;
 
     private:
         void writeData(const QByteArray &data);
         void finish();
+        void processStream();
 
         QPointer<QAbstractSocket> m_socket;
         Request m_request;
@@ -75,6 +84,8 @@ namespace Http
         QThread *m_workerThread = nullptr;
         bool m_isAsyncWorkerFinished = false;
 
+        std::shared_ptr<ResponseStream> m_stream;
+
         bool m_isWritingContent = false;
         bool m_isFinished = false;
     };
@@ -0,0 +1,117 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "responsewriterproxy.h"
+
+#include "base/global.h"
+#include "base/path.h"
+#include "responsestream.h"
+#include "responsewriterimpl.h"
+
+Http::ResponseWriterProxy::ResponseWriterProxy(ResponseWriterImpl *responseWriter)
+{
+    Q_ASSERT(responseWriter);
+
+    // Queued connections are used since `responseWriter` belongs to another thread.
+    // They are automatically broken if `responseWriter` is destroyed (e.g. connection is closed) meanwhile.
+    connect(this, &ResponseWriterProxy::responseSet, responseWriter, &ResponseWriterImpl::setResponse, Qt::QueuedConnection);
+    connect(this, &ResponseWriterProxy::fileStreamRequested, responseWriter, &ResponseWriterImpl::streamFile, Qt::QueuedConnection);
+    connect(this, &ResponseWriterProxy::streamOpened, responseWriter, &ResponseWriterImpl::startStream, Qt::QueuedConnection);
+}
+
+Http::ResponseWriterProxy::~ResponseWriterProxy()
+{
+    // Don't leave the connection waiting for response forever
+    if (!m_isResponseSet && !m_isFileStreamRequested && !m_isStreamOpened) [[unlikely]]
+        emit responseSet({.status = {.code = 500, .text = u"Internal Server Error"_s}});
+}
+
+void Http::ResponseWriterProxy::setResponse(const Response &response)
+{
+    Q_ASSERT(!m_isResponseSet && !m_isFileStreamRequested && !m_isStreamOpened);
+    if (m_isResponseSet || m_isFileStreamRequested) [[unlikely]]
+        return;
+
+    m_isResponseSet = true;
+    emit responseSet(response);
+
+    if (m_deleteWhenResponded)
+        deleteLater();
+}
+
+void Http::ResponseWriterProxy::streamFile(const Path &filePath, const HeaderMap &headers)
+{
+    Q_ASSERT(!m_isResponseSet && !m_isFileStreamRequested && !m_isStreamOpened);
+    if (m_isResponseSet || m_isFileStreamRequested) [[unlikely]]
+        return;
+
+    m_isFileStreamRequested = true;
+    emit fileStreamRequested(filePath, headers);
+
+    if (m_deleteWhenResponded)
+        deleteLater();
+}
+
+std::shared_ptr<Http::ResponseStream> Http::ResponseWriterProxy::openStream(const HeaderMap &headers)
+{
+    auto stream = std::make_shared<ResponseStream>();
+
+    Q_ASSERT(!m_isResponseSet && !m_isFileStreamRequested && !m_isStreamOpened);
+    if (m_isResponseSet || m_isFileStreamRequested || m_isStreamOpened) [[unlikely]]
+    {
+        stream->close();
+        return stream;
+    }
+
+    // Stream can be written to right away, data is kept until `responseWriter` picks it up
+    m_isStreamOpened = true;
+    emit streamOpened(headers, stream);
+
+    if (m_deleteWhenResponded)
+        deleteLater();
+
+    return stream;
+}
+
+bool Http::ResponseWriterProxy::isFinished() const
+{
+    return m_isResponseSet;
+}
+
+void Http::ResponseWriterProxy::deleteWhenResponded()
+{
+    if (hasResponded())
+        delete this;
+    else
+        m_deleteWhenResponded = true;
+}
+
+bool Http::ResponseWriterProxy::hasResponded() const
+{
+    return m_isResponseSet || m_isFileStreamRequested || m_isStreamOpened;
+}
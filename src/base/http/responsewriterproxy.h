@@ -0,0 +1,74 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "headermap.h"
+#include "response.h"
+#include "responsewriter.h"
+
+namespace Http
+{
+    class ResponseWriterImpl;
+
+    // Forwards response to ResponseWriterImpl that belongs to another thread
+    class ResponseWriterProxy final : public ResponseWriter
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(ResponseWriterProxy)
+
+    public:
+        // Should be created in the thread `responseWriter` belongs to
+        explicit ResponseWriterProxy(ResponseWriterImpl *responseWriter);
+        ~ResponseWriterProxy() override;
+
+        void setResponse(const Response &response) override;
+        void streamFile(const Path &filePath, const HeaderMap &headers) override;
+        std::shared_ptr<ResponseStream> openStream(const HeaderMap &headers) override;
+
+        bool isFinished() const override;
+
+        // Request handler may respond later, in such case the proxy is destroyed once it responds
+        void deleteWhenResponded();
+
+    signals:
+        void responseSet(const Http::Response &response);
+        void fileStreamRequested(const Path &filePath, const Http::HeaderMap &headers);
+        void streamOpened(const Http::HeaderMap &headers, std::shared_ptr<Http::ResponseStream> stream);
+
+    private:
+        bool hasResponded() const;
+
+        bool m_isResponseSet = false;
+        bool m_isFileStreamRequested = false;
+        bool m_isStreamOpened = false;
+        bool m_deleteWhenResponded = false;
+    };
+}
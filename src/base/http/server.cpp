@@ -40,8 +40,10 @@
 #include <QSslCertificate>
 #include <QSslCipher>
 #include <QSslKey>
+#include <QSet>
 #include <QSslSocket>
 #include <QStringList>
+#include <QThread>
 #include <QTimer>
 
 #include "base/global.h"
@@ -98,63 +100,87 @@ namespace
 
 using namespace Http;
 
-Server::Server(IRequestHandler *requestHandler, QObject *parent)
-    : QTcpServer(parent)
-    , m_requestHandler(requestHandler)
-    , m_sslConfig {QSslConfiguration::defaultConfiguration()}
+class Server::ConnectionGroup final : public QObject
 {
-    setProxy(QNetworkProxy::NoProxy);
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(ConnectionGroup)
 
-    m_sslConfig.setCiphers(safeCipherList());
-    m_sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
+public:
+    ConnectionGroup(IRequestHandler *requestHandler, QObject *requestHandlerContext, std::atomic_int *connectionCount, QObject *parent = nullptr);
+
+    void addConnection(qintptr socketDescriptor, bool isHttps, const QSslConfiguration &sslConfig);
+
+private:
+    void removeConnection(Connection *connection);
+    void dropTimedOutConnections();
 
-    auto *dropConnectionTimer = new QTimer(this);
-    connect(dropConnectionTimer, &QTimer::timeout, this, &Server::dropTimedOutConnection);
-    dropConnectionTimer->start(CONNECTIONS_SCAN_INTERVAL);
+    IRequestHandler *m_requestHandler = nullptr;
+    QObject *m_requestHandlerContext = nullptr;
+    std::atomic_int *m_connectionCount = nullptr;
+    QSet<Connection *> m_connections;  // for tracking persistent connections
+    QTimer *m_dropConnectionTimer = nullptr;
+};
+
+Server::ConnectionGroup::ConnectionGroup(IRequestHandler *requestHandler, QObject *requestHandlerContext
+        , std::atomic_int *connectionCount, QObject *parent)
+    : QObject(parent)
+    , m_requestHandler {requestHandler}
+    , m_requestHandlerContext {requestHandlerContext}
+    , m_connectionCount {connectionCount}
+    , m_dropConnectionTimer {new QTimer(this)}
+{
+    connect(m_dropConnectionTimer, &QTimer::timeout, this, &ConnectionGroup::dropTimedOutConnections);
 }
 
-void Server::incomingConnection(const qintptr socketDescriptor)
+void Server::ConnectionGroup::addConnection(const qintptr socketDescriptor, const bool isHttps, const QSslConfiguration &sslConfig)
 {
-    std::unique_ptr<QTcpSocket> serverSocket = isHttps() ? std::make_unique<QSslSocket>(this) : std::make_unique<QTcpSocket>(this);
+    // timer must be started from the thread it belongs to
+    if (!m_dropConnectionTimer->isActive())
+        m_dropConnectionTimer->start(CONNECTIONS_SCAN_INTERVAL);
+
+    std::unique_ptr<QTcpSocket> serverSocket = isHttps ? std::make_unique<QSslSocket>(this) : std::make_unique<QTcpSocket>(this);
     if (!serverSocket->setSocketDescriptor(socketDescriptor))
         return;
 
-    if (m_connections.size() >= CONNECTIONS_LIMIT)
+    if (m_connectionCount->fetch_add(1) >= CONNECTIONS_LIMIT)
     {
+        m_connectionCount->fetch_sub(1);
         qWarning("Too many connections. Exceeded CONNECTIONS_LIMIT (%d). Connection closed.", CONNECTIONS_LIMIT);
         return;
     }
 
     try
     {
-        if (isHttps())
+        if (isHttps)
         {
             auto *sslSocket = static_cast<QSslSocket *>(serverSocket.get());
-            sslSocket->setSslConfiguration(m_sslConfig);
+            sslSocket->setSslConfiguration(sslConfig);
             sslSocket->startServerEncryption();
         }
 
-        auto *connection = new Connection(serverSocket.release(), m_requestHandler, this);
+        auto *connection = new Connection(serverSocket.release(), m_requestHandler, m_requestHandlerContext, this);
         m_connections.insert(connection);
         connect(connection, &Connection::closed, this, [this, connection] { removeConnection(connection); });
     }
     catch (const std::bad_alloc &exception)
     {
         // drop the connection instead of throwing exception and crash
+        m_connectionCount->fetch_sub(1);
         qWarning("Failed to allocate memory for HTTP connection. Connection closed.");
         return;
     }
 }
 
-void Server::removeConnection(Connection *connection)
+void Server::ConnectionGroup::removeConnection(Connection *connection)
 {
-    m_connections.remove(connection);
+    if (m_connections.remove(connection))
+        m_connectionCount->fetch_sub(1);
     connection->deleteLater();
 }
 
-void Server::dropTimedOutConnection()
+void Server::ConnectionGroup::dropTimedOutConnections()
 {
-    m_connections.removeIf([](Connection *connection)
+    const qsizetype droppedCount = m_connections.removeIf([](Connection *connection)
     {
         if (!connection->hasExpired(KEEP_ALIVE_DURATION))
             return false;
@@ -162,6 +188,61 @@ void Server::dropTimedOutConnection()
         connection->deleteLater();
         return true;
     });
+    m_connectionCount->fetch_sub(static_cast<int>(droppedCount));
+}
+
+Server::Server(IRequestHandler *requestHandler, QObject *parent)
+    : Server(requestHandler, 0, parent)
+{
+}
+
+Server::Server(IRequestHandler *requestHandler, const int ioThreadCount, QObject *parent)
+    : QTcpServer(parent)
+    , m_requestHandler(requestHandler)
+    , m_sslConfig {QSslConfiguration::defaultConfiguration()}
+{
+    setProxy(QNetworkProxy::NoProxy);
+
+    m_sslConfig.setCiphers(safeCipherList());
+    m_sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    if (ioThreadCount <= 0)
+    {
+        m_connectionGroups.append(new ConnectionGroup(m_requestHandler, this, &m_connectionCount, this));
+        return;
+    }
+
+    m_ioThreads.reserve(ioThreadCount);
+    m_connectionGroups.reserve(ioThreadCount);
+    for (int i = 0; i < ioThreadCount; ++i)
+    {
+        auto *connectionGroup = new ConnectionGroup(m_requestHandler, this, &m_connectionCount);
+        auto &ioThread = m_ioThreads.emplace_back(new QThread);
+        connectionGroup->moveToThread(ioThread.get());
+        connect(ioThread.get(), &QThread::finished, connectionGroup, &QObject::deleteLater);
+        ioThread->setObjectName("Http::Server m_ioThread");
+        ioThread->start();
+
+        m_connectionGroups.append(connectionGroup);
+    }
+}
+
+Server::~Server()
+{
+    // connection groups that belong to I/O threads are deleted when their threads finish
+    m_ioThreads.clear();
+}
+
+void Server::incomingConnection(const qintptr socketDescriptor)
+{
+    ConnectionGroup *connectionGroup = m_connectionGroups[m_nextConnectionGroupIndex];
+    m_nextConnectionGroupIndex = (m_nextConnectionGroupIndex + 1) % m_connectionGroups.size();
+
+    QMetaObject::invokeMethod(connectionGroup
+            , [connectionGroup, socketDescriptor, isHttps = isHttps(), sslConfig = m_sslConfig]
+    {
+        connectionGroup->addConnection(socketDescriptor, isHttps, sslConfig);
+    });
 }
 
 bool Server::setupHttps(const QByteArray &certificates, const QByteArray &privateKey)
@@ -192,3 +273,5 @@ bool Server::isHttps() const
 {
     return m_https;
 }
+
+#include "server.moc"
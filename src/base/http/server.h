@@ -30,14 +30,18 @@
 
 #pragma once
 
-#include <QSet>
+#include <atomic>
+#include <vector>
+
+#include <QList>
 #include <QSslConfiguration>
 #include <QTcpServer>
 
+#include "base/utils/thread.h"
+
 namespace Http
 {
     class IRequestHandler;
-    class Connection;
 
     class Server final : public QTcpServer
     {
@@ -46,20 +50,26 @@ namespace Http
 
     public:
         explicit Server(IRequestHandler *requestHandler, QObject *parent = nullptr);
+        // Connections are distributed among `ioThreadCount` network threads which handle socket I/O,
+        // TLS, request parsing and response serialization. `requestHandler` is still invoked in the thread
+        // `Server` belongs to. If `ioThreadCount` is 0 everything is done in the thread `Server` belongs to.
+        Server(IRequestHandler *requestHandler, int ioThreadCount, QObject *parent = nullptr);
+        ~Server() override;
 
         bool setupHttps(const QByteArray &certificates, const QByteArray &privateKey);
         void disableHttps();
         bool isHttps() const;
 
-    private slots:
-        void dropTimedOutConnection();
-
     private:
+        class ConnectionGroup;
+
         void incomingConnection(qintptr socketDescriptor) override;
-        void removeConnection(Connection *connection);
 
         IRequestHandler *m_requestHandler = nullptr;
-        QSet<Connection *> m_connections;  // for tracking persistent connections
+        std::atomic_int m_connectionCount = 0;
+        std::vector<Utils::Thread::UniquePtr> m_ioThreads;
+        QList<ConnectionGroup *> m_connectionGroups;
+        qsizetype m_nextConnectionGroupIndex = 0;
 
         bool m_https = false;
         QSslConfiguration m_sslConfig;
@@ -0,0 +1,172 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "inotifywatcher.h"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <QFile>
+#include <QList>
+#include <QSocketNotifier>
+
+namespace
+{
+    const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_CREATE | IN_MOVE_SELF | IN_ONLYDIR;
+}
+
+InotifyWatcher::InotifyWatcher(QObject *parent)
+    : QObject(parent)
+    , m_fd {::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+{
+    if (m_fd < 0)
+        return;
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &InotifyWatcher::readEvents);
+}
+
+InotifyWatcher::~InotifyWatcher()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+}
+
+bool InotifyWatcher::isValid() const
+{
+    return (m_fd >= 0);
+}
+
+bool InotifyWatcher::addPath(const Path &path)
+{
+    if (!isValid())
+        return false;
+
+    const int wd = ::inotify_add_watch(m_fd, QFile::encodeName(path.data()).constData(), WATCH_MASK);
+    if (wd < 0)
+        return false;
+
+    // the same descriptor is returned if the directory is already watched (e.g. via another path)
+    if (const Path oldPath = m_pathByDescriptor.value(wd); !oldPath.isEmpty())
+        m_descriptorByPath.remove(oldPath);
+
+    m_pathByDescriptor[wd] = path;
+    m_descriptorByPath[path] = wd;
+    return true;
+}
+
+void InotifyWatcher::removePath(const Path &path)
+{
+    const int wd = m_descriptorByPath.take(path);
+    if (wd <= 0)
+        return;
+
+    m_pathByDescriptor.remove(wd);
+    ::inotify_rm_watch(m_fd, wd);
+}
+
+QList<Path> InotifyWatcher::paths() const
+{
+    return m_descriptorByPath.keys();
+}
+
+void InotifyWatcher::removeWatches(const Path &path)
+{
+    // Watches are bound to inodes so subdirectories would keep reporting events under stale paths
+    for (auto it = m_descriptorByPath.begin(); it != m_descriptorByPath.end();)
+    {
+        if ((it.key() == path) || it.key().hasAncestor(path))
+        {
+            m_pathByDescriptor.remove(it.value());
+            ::inotify_rm_watch(m_fd, it.value());
+            it = m_descriptorByPath.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void InotifyWatcher::readEvents()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+
+    while (true)
+    {
+        const ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (const char *ptr = buffer; ptr < (buffer + length);)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+            ptr += (sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                emit overflowed();
+                continue;
+            }
+
+            const Path dirPath = m_pathByDescriptor.value(event->wd);
+            if (dirPath.isEmpty())
+                continue; // watch was already removed
+
+            if (event->mask & (IN_IGNORED | IN_MOVE_SELF))
+            {
+                // directory was moved, removed or unmounted so its path is no longer valid
+                removeWatches(dirPath);
+                emit directoryRemoved(dirPath);
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const Path path = dirPath / Path(QFile::decodeName(event->name));
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    emit directoryCreated(path);
+                }
+                else if ((event->mask & IN_MOVED_FROM) && m_descriptorByPath.contains(path))
+                {
+                    // it will be watched again under new path if it is moved within watched directories
+                    removeWatches(path);
+                    emit directoryRemoved(path);
+                }
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                emit fileWritten(path);
+            }
+        }
+    }
+}
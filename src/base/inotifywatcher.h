@@ -0,0 +1,72 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QtContainerFwd>
+#include <QHash>
+#include <QObject>
+
+#include "base/path.h"
+
+class QSocketNotifier;
+
+// Linux specific directory watcher which reports individual entries instead of "directory changed"
+class InotifyWatcher final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(InotifyWatcher)
+
+public:
+    explicit InotifyWatcher(QObject *parent = nullptr);
+    ~InotifyWatcher() override;
+
+    bool isValid() const;
+
+    bool addPath(const Path &path);
+    void removePath(const Path &path);
+    QList<Path> paths() const;
+
+signals:
+    // file was written and closed or moved into watched directory
+    void fileWritten(const Path &path);
+    void directoryCreated(const Path &path);
+    // watched directory was moved or removed so it (with its subdirectories) is no longer watched
+    void directoryRemoved(const Path &path);
+    // some events were lost so watched directories need to be rescanned
+    void overflowed();
+
+private:
+    void readEvents();
+    void removeWatches(const Path &path);
+
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QHash<int, Path> m_pathByDescriptor;
+    QHash<Path, int> m_descriptorByPath;
+};
@@ -31,6 +31,7 @@
 #include "downloadmanager.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include <QByteArray>
 #include <QDateTime>
@@ -38,6 +39,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkCookie>
 #include <QNetworkCookieJar>
+#include <QNetworkDiskCache>
 #include <QNetworkProxy>
 #include <QNetworkReply>
 #include <QNetworkRequest>
@@ -45,9 +47,11 @@
 #include <QTimer>
 #include <QUrl>
 
+#include "base/algorithm.h"
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/preferences.h"
+#include "base/profile.h"
 #include "downloadhandlerimpl.h"
 #include "proxyconfigurationmanager.h"
 
@@ -55,6 +59,10 @@ using namespace std::chrono_literals;
 
 namespace
 {
+    const qint64 DISK_CACHE_SIZE = 50 * 1024 * 1024;
+    // statistics of idle services are dropped once there are more services than that
+    const qsizetype MAX_SERVICE_STATISTICS = 256;
+
     // Disguise as browser to circumvent website blocking
     QByteArray getBrowserUserAgent()
     {
@@ -140,8 +148,15 @@ Net::DownloadManager::DownloadManager(QObject *parent)
     : QObject(parent)
     , m_networkCookieJar {new NetworkCookieJar(this)}
     , m_networkManager {new QNetworkAccessManager(this)}
+    , m_diskCache {new QNetworkDiskCache(this)}
 {
     m_networkManager->setCookieJar(m_networkCookieJar);
+
+    // Responses are cached according to their Cache-Control/Expires/ETag headers
+    m_diskCache->setCacheDirectory((specialFolderLocation(SpecialFolder::Cache) / Path(u"http"_s)).data());
+    m_diskCache->setMaximumCacheSize(DISK_CACHE_SIZE);
+    m_networkManager->setCache(m_diskCache);
+
     connect(m_networkManager, &QNetworkAccessManager::sslErrors, this
             , [](QNetworkReply *reply, const QList<QSslError> &errors)
     {
@@ -167,7 +182,11 @@ Net::DownloadManager::DownloadManager(QObject *parent)
     connect(ProxyConfigurationManager::instance(), &ProxyConfigurationManager::proxyConfigurationChanged
             , this, &DownloadManager::applyProxySettings);
     connect(Preferences::instance(), &Preferences::changed, this, &DownloadManager::applyProxySettings);
+    connect(Preferences::instance(), &Preferences::changed, this, &DownloadManager::loadPreferences);
     applyProxySettings();
+
+    m_clock.start();
+    loadPreferences();
 }
 
 void Net::DownloadManager::initInstance()
@@ -191,7 +210,6 @@ Net::DownloadHandler *Net::DownloadManager::download(const DownloadRequest &down
 {
     // Process download request
     const auto serviceID = ServiceID::fromURL(downloadRequest.url());
-    const bool isSequentialService = m_sequentialServices.contains(serviceID);
 
     auto *downloadHandler = new DownloadHandlerImpl(this, downloadRequest, useProxy);
     connect(downloadHandler, &DownloadHandler::finished, this, [this, serviceID, downloadHandler]
@@ -200,23 +218,25 @@ Net::DownloadHandler *Net::DownloadManager::download(const DownloadRequest &down
         {
             // DownloadHandler was finished (canceled) before QNetworkReply was assigned,
             // so it's still in the queue. Just remove it from there.
-            m_waitingJobs[serviceID].removeOne(downloadHandler);
+            const auto serviceIter = m_services.find(serviceID);
+            if (serviceIter != m_services.end())
+            {
+                serviceIter->interactiveJobs.removeOne(downloadHandler);
+                serviceIter->backgroundJobs.removeOne(downloadHandler);
+                removeServiceIfIdle(serviceID);
+            }
         }
 
         downloadHandler->deleteLater();
     });
 
-    if (isSequentialService && m_busyServices.contains(serviceID))
-    {
-        m_waitingJobs[serviceID].enqueue(downloadHandler);
-    }
+    ServiceState &service = m_services[serviceID];
+    if (downloadRequest.priority() == RequestPriority::Background)
+        service.backgroundJobs.enqueue(downloadHandler);
     else
-    {
-        qDebug("Downloading %s...", qUtf8Printable(downloadRequest.url()));
-        if (isSequentialService)
-            m_busyServices.insert(serviceID);
-        processRequest(downloadHandler);
-    }
+        service.interactiveJobs.enqueue(downloadHandler);
+
+    processWaitingJobs(serviceID);
 
     return downloadHandler;
 }
@@ -226,6 +246,19 @@ void Net::DownloadManager::registerSequentialService(const Net::ServiceID &servi
     m_sequentialServices.insert(serviceID, delay);
 }
 
+QHash<Net::ServiceID, Net::ServiceStatistics> Net::DownloadManager::serviceStatistics() const
+{
+    QHash<ServiceID, ServiceStatistics> result = m_serviceStatistics;
+    for (auto it = m_services.cbegin(); it != m_services.cend(); ++it)
+    {
+        const ServiceState &service = it.value();
+        ServiceStatistics &statistics = result[it.key()];
+        statistics.activeRequests = service.activeJobs;
+        statistics.waitingRequests = static_cast<int>(service.interactiveJobs.size() + service.backgroundJobs.size());
+    }
+    return result;
+}
+
 QList<QNetworkCookie> Net::DownloadManager::cookiesForUrl(const QUrl &url) const
 {
     return m_networkCookieJar->cookiesForUrl(url);
@@ -298,19 +331,138 @@ void Net::DownloadManager::applyProxySettings()
     };
 }
 
+void Net::DownloadManager::loadPreferences()
+{
+    const auto *pref = Preferences::instance();
+    const int connectionsPerHostLimit = pref->getDownloadConnectionsPerHost();
+    const int requestRatePerHostLimit = pref->getDownloadRequestRatePerHost();
+    if ((connectionsPerHostLimit == m_connectionsPerHostLimit) && (requestRatePerHostLimit == m_requestRatePerHostLimit))
+        return;
+
+    m_connectionsPerHostLimit = connectionsPerHostLimit;
+    m_requestRatePerHostLimit = requestRatePerHostLimit;
+
+    // Limits could be raised so some of waiting jobs may be able to start now
+    for (const ServiceID &serviceID : asConst(m_services.keys()))
+        processWaitingJobs(serviceID);
+}
+
 void Net::DownloadManager::processWaitingJobs(const ServiceID &serviceID)
 {
-    const auto waitingJobsIter = m_waitingJobs.find(serviceID);
-    if ((waitingJobsIter == m_waitingJobs.end()) || waitingJobsIter.value().isEmpty())
+    // Sequential services are limited to single connection
+    const int connectionsLimit = m_sequentialServices.contains(serviceID) ? 1 : m_connectionsPerHostLimit;
+
+    while (true)
+    {
+        // `m_services` can be modified by `processRequest()` so don't keep references across iterations
+        const auto serviceIter = m_services.find(serviceID);
+        if (serviceIter == m_services.end())
+            return;
+
+        ServiceState &service = serviceIter.value();
+        if ((connectionsLimit > 0) && (service.activeJobs >= connectionsLimit))
+            return;
+
+        DownloadHandlerImpl *handler = nullptr;
+        if (!service.interactiveJobs.isEmpty())
+        {
+            // Interactive requests aren't subject to request rate limit
+            handler = service.interactiveJobs.dequeue();
+        }
+        else if (!service.backgroundJobs.isEmpty() && takeRequestToken(serviceID, service))
+        {
+            handler = service.backgroundJobs.dequeue();
+        }
+
+        if (!handler)
+            return;
+
+        ++service.activeJobs;
+        ++m_serviceStatistics[serviceID].startedRequests;
+
+        qDebug("Downloading %s...", qUtf8Printable(handler->url()));
+        processRequest(handler);
+    }
+}
+
+bool Net::DownloadManager::takeRequestToken(const ServiceID &serviceID, ServiceState &service)
+{
+    if (m_requestRatePerHostLimit <= 0)
+        return true;
+
+    // Allow bursts of up to `m_requestRatePerHostLimit` requests
+    const double capacity = m_requestRatePerHostLimit;
+    const qint64 now = m_clock.elapsed();
+    service.tokens = (service.tokensUpdateTime < 0)
+        ? capacity
+        : std::min(capacity, (service.tokens + ((now - service.tokensUpdateTime) * capacity / 1000)));
+    service.tokensUpdateTime = now;
+
+    if (service.tokens >= 1)
+    {
+        service.tokens -= 1;
+        return true;
+    }
+
+    if (!service.isWaitingForTokens)
+    {
+        service.isWaitingForTokens = true;
+
+        const auto delay = std::chrono::milliseconds(static_cast<qint64>(std::ceil((1 - service.tokens) * 1000 / capacity)));
+        QTimer::singleShot(delay, this, [this, serviceID]
+        {
+            if (const auto serviceIter = m_services.find(serviceID); serviceIter != m_services.end())
+                serviceIter->isWaitingForTokens = false;
+            processWaitingJobs(serviceID);
+            removeServiceIfIdle(serviceID);
+        });
+    }
+
+    return false;
+}
+
+void Net::DownloadManager::removeServiceIfIdle(const ServiceID &serviceID)
+{
+    const auto serviceIter = m_services.find(serviceID);
+    if (serviceIter == m_services.end())
+        return;
+
+    ServiceState &service = serviceIter.value();
+    if ((service.activeJobs > 0) || service.isWaitingForTokens || service.isRemovalScheduled
+        || !service.interactiveJobs.isEmpty() || !service.backgroundJobs.isEmpty())
     {
-        // No more waiting jobs for given ServiceID
-        m_busyServices.remove(serviceID);
         return;
     }
 
-    auto *handler = waitingJobsIter.value().dequeue();
-    qDebug("Downloading %s...", qUtf8Printable(handler->url()));
-    processRequest(handler);
+    // Removing service before its token bucket is refilled would allow to exceed request rate limit
+    if ((m_requestRatePerHostLimit > 0) && (service.tokensUpdateTime >= 0))
+    {
+        const double capacity = m_requestRatePerHostLimit;
+        const qint64 refillTime = service.tokensUpdateTime
+            + static_cast<qint64>(std::ceil((capacity - service.tokens) * 1000 / capacity));
+        const qint64 now = m_clock.elapsed();
+        if (refillTime > now)
+        {
+            service.isRemovalScheduled = true;
+            QTimer::singleShot(std::chrono::milliseconds(refillTime - now), this, [this, serviceID]
+            {
+                if (const auto serviceIter = m_services.find(serviceID); serviceIter != m_services.end())
+                    serviceIter->isRemovalScheduled = false;
+                removeServiceIfIdle(serviceID);
+            });
+            return;
+        }
+    }
+
+    m_services.erase(serviceIter);
+
+    if (m_serviceStatistics.size() > MAX_SERVICE_STATISTICS)
+    {
+        Algorithm::removeIf(m_serviceStatistics, [this](const ServiceID &serviceID, const ServiceStatistics &)
+        {
+            return !m_services.contains(serviceID);
+        });
+    }
 }
 
 void Net::DownloadManager::processRequest(DownloadHandlerImpl *downloadHandler)
@@ -335,10 +487,33 @@ void Net::DownloadManager::processRequest(DownloadHandlerImpl *downloadHandler)
 
     request.setTransferTimeout();
 
+    if (!downloadRequest.useCache())
+    {
+        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    }
+
     QNetworkReply *reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, serviceID = ServiceID::fromURL(downloadHandler->url())]
+    connect(reply, &QNetworkReply::finished, this
+            , [this, reply, useCache = downloadRequest.useCache(), serviceID = ServiceID::fromURL(downloadHandler->url())]
     {
-        QTimer::singleShot(m_sequentialServices.value(serviceID, 0s), this, [this, serviceID] { processWaitingJobs(serviceID); });
+        ServiceStatistics &statistics = m_serviceStatistics[serviceID];
+        const QNetworkReply::NetworkError error = reply->error();
+        if ((error != QNetworkReply::NoError) && (error != QNetworkReply::OperationCanceledError))
+            ++statistics.failedRequests;
+
+        if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool())
+            ++statistics.cacheHits;
+        else if (useCache && (error == QNetworkReply::NoError))
+            ++statistics.cacheMisses;
+
+        QTimer::singleShot(m_sequentialServices.value(serviceID, 0s), this, [this, serviceID]
+        {
+            if (const auto serviceIter = m_services.find(serviceID); serviceIter != m_services.end())
+                --serviceIter->activeJobs;
+            processWaitingJobs(serviceID);
+            removeServiceIfIdle(serviceID);
+        });
     });
     downloadHandler->assignNetworkReply(reply);
 }
@@ -403,6 +578,28 @@ Net::DownloadRequest &Net::DownloadRequest::destFileName(const Path &value)
     return *this;
 }
 
+Net::RequestPriority Net::DownloadRequest::priority() const
+{
+    return m_priority;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::priority(const RequestPriority value)
+{
+    m_priority = value;
+    return *this;
+}
+
+bool Net::DownloadRequest::useCache() const
+{
+    return m_useCache;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::useCache(const bool value)
+{
+    m_useCache = value;
+    return *this;
+}
+
 Net::ServiceID Net::ServiceID::fromURL(const QUrl &url)
 {
     return {url.host(), url.port(80)};
@@ -33,16 +33,17 @@
 #include <chrono>
 
 #include <QtTypes>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QNetworkProxy>
 #include <QObject>
 #include <QQueue>
-#include <QSet>
 
 #include "base/path.h"
 
 class QNetworkAccessManager;
 class QNetworkCookie;
+class QNetworkDiskCache;
 class QNetworkReply;
 class QSslError;
 class QUrl;
@@ -67,6 +68,24 @@ namespace Net
         Failed
     };
 
+    enum class RequestPriority
+    {
+        // requests made on behalf of the user (e.g. adding torrent from URL)
+        Interactive,
+        // requests made by automated activities (e.g. RSS, favicons)
+        Background
+    };
+
+    struct ServiceStatistics
+    {
+        qint64 startedRequests = 0;
+        qint64 failedRequests = 0;
+        qint64 cacheHits = 0;
+        qint64 cacheMisses = 0;
+        int activeRequests = 0;
+        int waitingRequests = 0;
+    };
+
     class DownloadRequest
     {
     public:
@@ -91,12 +110,20 @@ namespace Net
         Path destFileName() const;
         DownloadRequest &destFileName(const Path &value);
 
+        RequestPriority priority() const;
+        DownloadRequest &priority(RequestPriority value);
+
+        bool useCache() const;
+        DownloadRequest &useCache(bool value);
+
     private:
         QString m_url;
         QString m_userAgent;
         qint64 m_limit = 0;
         bool m_saveToFile = false;
         Path m_destFileName;
+        RequestPriority m_priority = RequestPriority::Interactive;
+        bool m_useCache = true;
     };
 
     struct DownloadResult
@@ -141,6 +168,7 @@ namespace Net
         void download(const DownloadRequest &downloadRequest, bool useProxy, Context context, Func &&slot);
 
         void registerSequentialService(const ServiceID &serviceID, std::chrono::seconds delay = std::chrono::seconds(0));
+        QHash<ServiceID, ServiceStatistics> serviceStatistics() const;
 
         QList<QNetworkCookie> cookiesForUrl(const QUrl &url) const;
         bool setCookiesFromUrl(const QList<QNetworkCookie> &cookieList, const QUrl &url);
@@ -153,21 +181,42 @@ namespace Net
     private:
         class NetworkCookieJar;
 
+        struct ServiceState
+        {
+            QQueue<DownloadHandlerImpl *> interactiveJobs;
+            QQueue<DownloadHandlerImpl *> backgroundJobs;
+            int activeJobs = 0;
+            // token bucket used to limit request rate
+            double tokens = 0;
+            qint64 tokensUpdateTime = -1;
+            bool isWaitingForTokens = false;
+            bool isRemovalScheduled = false;
+        };
+
         explicit DownloadManager(QObject *parent = nullptr);
 
         void applyProxySettings();
+        void loadPreferences();
         void processWaitingJobs(const ServiceID &serviceID);
         void processRequest(DownloadHandlerImpl *downloadHandler);
+        bool takeRequestToken(const ServiceID &serviceID, ServiceState &service);
+        void removeServiceIfIdle(const ServiceID &serviceID);
 
         static DownloadManager *m_instance;
         NetworkCookieJar *m_networkCookieJar = nullptr;
         QNetworkAccessManager *m_networkManager = nullptr;
+        QNetworkDiskCache *m_diskCache = nullptr;
         QNetworkProxy m_proxy;
 
         // m_sequentialServices value is delay for same host requests
         QHash<ServiceID, std::chrono::seconds> m_sequentialServices;
-        QSet<ServiceID> m_busyServices;
-        QHash<ServiceID, QQueue<DownloadHandlerImpl *>> m_waitingJobs;
+        // state of services that have pending requests, it's removed once service becomes idle
+        QHash<ServiceID, ServiceState> m_services;
+        // request counters are kept for recently used services
+        QHash<ServiceID, ServiceStatistics> m_serviceStatistics;
+        QElapsedTimer m_clock;
+        int m_connectionsPerHostLimit = 0;
+        int m_requestRatePerHostLimit = 0;
     };
 
     template <typename Context, typename Func>
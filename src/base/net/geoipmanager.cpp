@@ -130,7 +130,7 @@ void GeoIPManager::downloadDatabaseFile()
     const QDateTime curDatetime = QDateTime::currentDateTimeUtc();
     const QString curUrl = DATABASE_URL.arg(QLocale::c().toString(curDatetime, u"yyyy-MM"));
     DownloadManager::instance()->download(
-            {curUrl}, Preferences::instance()->useProxyForGeneralPurposes()
+            DownloadRequest(curUrl).priority(RequestPriority::Background), Preferences::instance()->useProxyForGeneralPurposes()
             , this, &GeoIPManager::downloadFinished);
 }
 
@@ -74,7 +74,10 @@ namespace
 
 Preferences *Preferences::m_instance = nullptr;
 
-Preferences::Preferences() = default;
+Preferences::Preferences()
+{
+    updateSnapshot();
+}
 
 Preferences *Preferences::instance()
 {
@@ -93,6 +96,31 @@ void Preferences::freeInstance()
     m_instance = nullptr;
 }
 
+std::shared_ptr<const Preferences::Snapshot> Preferences::snapshot() const
+{
+    const QMutexLocker locker {&m_snapshotMutex};
+    return m_snapshot;
+}
+
+void Preferences::updateSnapshot()
+{
+    const Snapshot newSnapshot {
+        .torrentFileSizeLimit = getTorrentFileSizeLimit(),
+        .bdecodeDepthLimit = getBdecodeDepthLimit(),
+        .bdecodeTokenLimit = getBdecodeTokenLimit(),
+        .webUIMaxAuthFailCount = getWebUIMaxAuthFailCount(),
+        .webUIBanDuration = getWebUIBanDuration()
+    };
+
+    if (const std::shared_ptr<const Snapshot> currentSnapshot = snapshot(); currentSnapshot && (*currentSnapshot == newSnapshot))
+        return;
+
+    // Replaced snapshot is released once the last reader drops it
+    auto snapshot = std::make_shared<const Snapshot>(newSnapshot);
+    const QMutexLocker locker {&m_snapshotMutex};
+    m_snapshot.swap(snapshot);
+}
+
 // General options
 QString Preferences::getLocale() const
 {
@@ -331,6 +359,7 @@ void Preferences::setTorrentFileSizeLimit(const qint64 value)
         return;
 
     setValue(u"BitTorrent/TorrentFileSizeLimit"_s, value);
+    updateSnapshot();
 }
 
 int Preferences::getBdecodeDepthLimit() const
@@ -344,6 +373,7 @@ void Preferences::setBdecodeDepthLimit(const int value)
         return;
 
     setValue(u"BitTorrent/BdecodeDepthLimit"_s, value);
+    updateSnapshot();
 }
 
 int Preferences::getBdecodeTokenLimit() const
@@ -357,6 +387,7 @@ void Preferences::setBdecodeTokenLimit(const int value)
         return;
 
     setValue(u"BitTorrent/BdecodeTokenLimit"_s, value);
+    updateSnapshot();
 }
 
 bool Preferences::isToolbarDisplayed() const
@@ -927,6 +958,7 @@ void Preferences::setWebUIMaxAuthFailCount(const int count)
         return;
 
     setValue(u"Preferences/WebUI/MaxAuthenticationFailCount"_s, count);
+    updateSnapshot();
 }
 
 std::chrono::seconds Preferences::getWebUIBanDuration() const
@@ -940,6 +972,7 @@ void Preferences::setWebUIBanDuration(const std::chrono::seconds duration)
         return;
 
     setValue(u"Preferences/WebUI/BanDuration"_s, static_cast<int>(duration.count()));
+    updateSnapshot();
 }
 
 int Preferences::getWebUISessionTimeout() const
@@ -955,6 +988,19 @@ void Preferences::setWebUISessionTimeout(const int timeout)
     setValue(u"Preferences/WebUI/SessionTimeout"_s, timeout);
 }
 
+int Preferences::getWebUINetworkThreads() const
+{
+    return value<int>(u"Preferences/WebUI/NetworkThreads"_s, 1);
+}
+
+void Preferences::setWebUINetworkThreads(const int count)
+{
+    if (count == getWebUINetworkThreads())
+        return;
+
+    setValue(u"Preferences/WebUI/NetworkThreads"_s, count);
+}
+
 bool Preferences::isWebUIClickjackingProtectionEnabled() const
 {
     return value(u"Preferences/WebUI/ClickjackingProtection"_s, true);
@@ -1480,6 +1526,32 @@ void Preferences::setIgnoreSSLErrors(const bool enabled)
     setValue(u"Preferences/Advanced/IgnoreSSLErrors"_s, enabled);
 }
 
+int Preferences::getDownloadConnectionsPerHost() const
+{
+    return value(u"Preferences/Advanced/DownloadConnectionsPerHost"_s, 0);
+}
+
+void Preferences::setDownloadConnectionsPerHost(const int value)
+{
+    if (value == getDownloadConnectionsPerHost())
+        return;
+
+    setValue(u"Preferences/Advanced/DownloadConnectionsPerHost"_s, value);
+}
+
+int Preferences::getDownloadRequestRatePerHost() const
+{
+    return value(u"Preferences/Advanced/DownloadRequestRatePerHost"_s, 0);
+}
+
+void Preferences::setDownloadRequestRatePerHost(const int value)
+{
+    if (value == getDownloadRequestRatePerHost())
+        return;
+
+    setValue(u"Preferences/Advanced/DownloadRequestRatePerHost"_s, value);
+}
+
 Path Preferences::getPythonExecutablePath() const
 {
     return value(u"Preferences/Search/pythonExecutablePath"_s, Path());
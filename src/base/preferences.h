@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+
 #include <QtContainerFwd>
 #include <QtSystemDetection>
+#include <QMutex>
 #include <QObject>
 
 #include "base/net/smtpencryptiontype.h"
@@ -82,10 +86,26 @@ class Preferences final : public QObject
     Preferences();
 
 public:
+    // Typed copy of the settings which are read by hot code paths (possibly from other threads).
+    // It is rebuilt whenever any of its settings is changed so readers don't need to access SettingsStorage.
+    struct Snapshot
+    {
+        qint64 torrentFileSizeLimit = 0;
+        int bdecodeDepthLimit = 0;
+        int bdecodeTokenLimit = 0;
+        int webUIMaxAuthFailCount = 0;
+        std::chrono::seconds webUIBanDuration {};
+
+        friend bool operator==(const Snapshot &, const Snapshot &) = default;
+    };
+
     static void initInstance();
     static void freeInstance();
     static Preferences *instance();
 
+    // Returned snapshot isn't affected by further changes of settings
+    std::shared_ptr<const Snapshot> snapshot() const;
+
     // General options
     QString getLocale() const;
     void setLocale(const QString &locale);
@@ -207,6 +227,8 @@ public:
     void setWebUIBanDuration(std::chrono::seconds duration);
     int getWebUISessionTimeout() const;
     void setWebUISessionTimeout(int timeout);
+    int getWebUINetworkThreads() const;
+    void setWebUINetworkThreads(int count);
 
     // WebUI security
     bool isWebUIClickjackingProtectionEnabled() const;
@@ -305,6 +327,10 @@ public:
     void setMarkOfTheWebEnabled(bool enabled);
     bool isIgnoreSSLErrors() const;
     void setIgnoreSSLErrors(bool enabled);
+    int getDownloadConnectionsPerHost() const;
+    void setDownloadConnectionsPerHost(int value);
+    int getDownloadRequestRatePerHost() const;
+    void setDownloadRequestRatePerHost(int value);
     Path getPythonExecutablePath() const;
     void setPythonExecutablePath(const Path &path);
 #if defined(Q_OS_WIN) || defined(Q_OS_MACOS)
@@ -456,5 +482,11 @@ signals:
     void changed();
 
 private:
+    void updateSnapshot();
+
     static Preferences *m_instance;
+
+    // Only guards replacing of the pointer, readers share the snapshot itself
+    mutable QMutex m_snapshotMutex;
+    std::shared_ptr<const Snapshot> m_snapshot;
 };
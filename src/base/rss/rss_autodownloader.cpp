@@ -48,6 +48,7 @@
 #include "base/global.h"
 #include "base/interfaces/iapplication.h"
 #include "base/logger.h"
+#include "base/net/downloadmanager.h"
 #include "base/profile.h"
 #include "base/utils/fs.h"
 #include "base/utils/io.h"
@@ -499,7 +500,7 @@ void AutoDownloader::processJob(const QSharedPointer<ProcessingJob> &job)
                 .arg(job->articleData.value(Article::KeyTitle).toString(), rule.name()));
 
         const auto torrentURL = job->articleData.value(Article::KeyTorrentURL).toString();
-        app()->addTorrentManager()->addTorrent(torrentURL, rule.addTorrentParams());
+        app()->addTorrentManager()->addTorrent(torrentURL, rule.addTorrentParams(), Net::RequestPriority::Background);
 
         if (BitTorrent::TorrentDescriptor::parse(torrentURL))
         {
@@ -154,7 +154,8 @@ void Feed::refresh()
 
     // NOTE: Should we allow manually refreshing for disabled session?
 
-    m_downloadHandler = Net::DownloadManager::instance()->download(m_url, Preferences::instance()->useProxyForRSS());
+    m_downloadHandler = Net::DownloadManager::instance()->download(
+            Net::DownloadRequest(m_url).priority(Net::RequestPriority::Background).useCache(false), Preferences::instance()->useProxyForRSS());
     connect(m_downloadHandler, &Net::DownloadHandler::finished, this, &Feed::handleDownloadFinished);
 
     if (!m_iconPath.exists())
@@ -389,7 +390,7 @@ void Feed::downloadIcon()
     const QUrl url(m_url);
     const auto iconUrl = u"%1://%2/favicon.ico"_s.arg(url.scheme(), url.host());
     Net::DownloadManager::instance()->download(
-            Net::DownloadRequest(iconUrl).saveToFile(true).destFileName(m_iconPath)
+            Net::DownloadRequest(iconUrl).saveToFile(true).destFileName(m_iconPath).priority(Net::RequestPriority::Background)
             , Preferences::instance()->useProxyForRSS(), this, &Feed::handleIconDownloadFinished);
 }
 
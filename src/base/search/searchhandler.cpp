@@ -29,12 +29,15 @@
 
 #include "searchhandler.h"
 
+#include <algorithm>
 #include <chrono>
+#include <optional>
 
 #include <QtLogging>
 #include <QList>
 #include <QMetaObject>
 #include <QProcess>
+#include <QThread>
 #include <QTimer>
 
 #include "base/global.h"
@@ -81,6 +84,24 @@ namespace
         }
         return {};
     };
+
+    QString resultKey(const SearchResult &searchResult)
+    {
+        // The same torrent can be provided by several plugins (or several times by the same one)
+        // so magnet links are identified by their info hash rather than by the entire URL
+        const QString btihPrefix = u"xt=urn:btih:"_s;
+        if (searchResult.fileUrl.startsWith(u"magnet:", Qt::CaseInsensitive))
+        {
+            if (const qsizetype begin = searchResult.fileUrl.indexOf(btihPrefix, 0, Qt::CaseInsensitive); begin >= 0)
+            {
+                const qsizetype hashBegin = begin + btihPrefix.size();
+                const qsizetype hashEnd = searchResult.fileUrl.indexOf(u'&', hashBegin);
+                return searchResult.fileUrl.sliced(hashBegin, (((hashEnd >= 0) ? hashEnd : searchResult.fileUrl.size()) - hashBegin)).toLower();
+            }
+        }
+
+        return searchResult.fileUrl;
+    }
 }
 
 SearchHandler::SearchHandler(const QString &pattern, const QString &category, const QStringList &usedPlugins, SearchPluginManager *manager)
@@ -89,14 +110,79 @@ SearchHandler::SearchHandler(const QString &pattern, const QString &category, co
     , m_category {category}
     , m_usedPlugins {usedPlugins}
     , m_manager {manager}
-    , m_searchProcess {new QProcess(this)}
-    , m_searchTimeout {new QTimer(this)}
 {
+    m_pluginSearches.reserve(m_usedPlugins.size());
+    for (const QString &pluginName : asConst(m_usedPlugins))
+    {
+        if (std::ranges::any_of(asConst(m_pluginSearches), [&pluginName](const PluginSearch &pluginSearch) { return pluginSearch.pluginName == pluginName; }))
+            continue;
+
+        PluginSearch &pluginSearch = m_pluginSearches.emplaceBack();
+        pluginSearch.pluginName = pluginName;
+    }
+
+    // Launch search
+    // deferred start allows clients to handle starting-related signals
+    QMetaObject::invokeMethod(this, &SearchHandler::start, Qt::QueuedConnection);
+}
+
+bool SearchHandler::isActive() const
+{
+    return !m_searchFinished;
+}
+
+void SearchHandler::start()
+{
+    // Results of repeated queries are taken from the cache without launching search processes
+    for (PluginSearch &pluginSearch : m_pluginSearches)
+    {
+        if (const std::optional<QList<SearchResult>> cachedResults = m_manager->cachedSearchResults(m_pattern, m_category, pluginSearch.pluginName))
+        {
+            pluginSearch.isCached = true;
+            appendResults(pluginSearch, *cachedResults);
+        }
+    }
+
+    startPendingPluginSearches();
+}
+
+void SearchHandler::startPendingPluginSearches()
+{
+    const int maxRunningProcesses = std::max(QThread::idealThreadCount(), 1);
+
+    while (!m_searchCancelled && (m_nextPluginSearchIndex < m_pluginSearches.size())
+           && (m_runningProcessCount < maxRunningProcesses))
+    {
+        PluginSearch &pluginSearch = m_pluginSearches[m_nextPluginSearchIndex++];
+        if (!pluginSearch.isCached)
+            startPluginSearch(pluginSearch);
+    }
+
+    if ((m_runningProcessCount > 0) || m_searchFinished)
+        return;
+
+    if (!m_searchCancelled && (m_nextPluginSearchIndex < m_pluginSearches.size()))
+        return;
+
+    m_searchFinished = true;
+    if (m_searchCancelled)
+        emit searchFinished(true);
+    else if ((m_failedPluginCount > 0) && (m_failedPluginCount == m_pluginSearches.size()))
+        emit searchFailed(m_lastErrorMessage);
+    else
+        emit searchFinished(false);
+}
+
+void SearchHandler::startPluginSearch(PluginSearch &pluginSearch)
+{
+    const qsizetype index = std::distance(m_pluginSearches.data(), &pluginSearch);
+
+    pluginSearch.process = new QProcess(this);
     // Load environment variables (proxy)
-    m_searchProcess->setProcessEnvironment(m_manager->proxyEnvironment());
-    m_searchProcess->setProgram(Utils::ForeignApps::pythonInfo().executablePath.data());
+    pluginSearch.process->setProcessEnvironment(m_manager->proxyEnvironment());
+    pluginSearch.process->setProgram(Utils::ForeignApps::pythonInfo().executablePath.data());
 #ifdef Q_OS_UNIX
-    m_searchProcess->setUnixProcessParameters(QProcess::UnixProcessFlag::CloseFileDescriptors);
+    pluginSearch.process->setUnixProcessParameters(QProcess::UnixProcessFlag::CloseFileDescriptors);
 #endif
 
     const QStringList params
@@ -104,86 +190,136 @@ SearchHandler::SearchHandler(const QString &pattern, const QString &category, co
         Utils::ForeignApps::PYTHON_ISOLATE_MODE_FLAG,
         Utils::ForeignApps::PYTHON_UTF8_MODE_FLAG,
         (SearchPluginManager::engineLocation() / Path(u"nova2.py"_s)).toString(),
-        m_usedPlugins.join(u','),
+        pluginSearch.pluginName,
         m_category
     };
-    m_searchProcess->setArguments(params + m_pattern.split(u' '));
+    pluginSearch.process->setArguments(params + m_pattern.split(u' '));
 
-    connect(m_searchProcess, &QProcess::errorOccurred, this, [this](const QProcess::ProcessError error)
+    connect(pluginSearch.process, &QProcess::errorOccurred, this, [this, index](const QProcess::ProcessError error)
     {
+        PluginSearch &pluginSearch = m_pluginSearches[index];
+        const auto errMsg = toString(error);
         if (!m_searchCancelled)
         {
-            const auto errMsg = toString(error);
-            LogMsg(tr("Search process failed. Search query: \"%1\". Category: \"%2\". Engines: \"%3\". Error: \"%4\".")
-                .arg(m_pattern, m_category, m_usedPlugins.join(u", "), errMsg), Log::WARNING);
-            emit searchFailed(errMsg);
+            LogMsg(tr("Search process failed. Search query: \"%1\". Category: \"%2\". Engine: \"%3\". Error: \"%4\".")
+                .arg(m_pattern, m_category, pluginSearch.pluginName, errMsg), Log::WARNING);
         }
-    });
-    connect(m_searchProcess, &QProcess::readyReadStandardOutput, this, &SearchHandler::readSearchOutput);
-    connect(m_searchProcess, qOverload<int, QProcess::ExitStatus>(&QProcess::finished)
-            , this, &SearchHandler::processFinished);
 
-    m_searchTimeout->setSingleShot(true);
-    connect(m_searchTimeout, &QTimer::timeout, this, &SearchHandler::cancelSearch);
-    m_searchTimeout->start(3min);
+        // `finished` signal isn't emitted in this case
+        if (error == QProcess::FailedToStart)
+            pluginSearchFinished(pluginSearch, errMsg);
+    });
+    connect(pluginSearch.process, &QProcess::readyReadStandardOutput, this, [this, index]
+    {
+        readSearchOutput(m_pluginSearches[index]);
+    });
+    connect(pluginSearch.process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished)
+            , this, [this, index](const int exitCode)
+    {
+        processFinished(m_pluginSearches[index], exitCode);
+    });
 
-    // Launch search
-    // deferred start allows clients to handle starting-related signals
-    QMetaObject::invokeMethod(this, [this]() { m_searchProcess->start(QIODevice::ReadOnly); }
-        , Qt::QueuedConnection);
-}
+    pluginSearch.timeout = new QTimer(this);
+    pluginSearch.timeout->setSingleShot(true);
+    connect(pluginSearch.timeout, &QTimer::timeout, this, [this, index]
+    {
+        const PluginSearch &pluginSearch = m_pluginSearches[index];
+        LogMsg(tr("Search plugin timed out. Search query: \"%1\". Category: \"%2\". Engine: \"%3\".")
+            .arg(m_pattern, m_category, pluginSearch.pluginName), Log::WARNING);
+#ifdef Q_OS_WIN
+        pluginSearch.process->kill();
+#else
+        pluginSearch.process->terminate();
+#endif
+    });
+    pluginSearch.timeout->start(3min);
 
-bool SearchHandler::isActive() const
-{
-    return (m_searchProcess->state() != QProcess::NotRunning);
+    ++m_runningProcessCount;
+    pluginSearch.process->start(QIODevice::ReadOnly);
 }
 
 void SearchHandler::cancelSearch()
 {
-    if ((m_searchProcess->state() == QProcess::NotRunning) || m_searchCancelled)
+    if (m_searchFinished || m_searchCancelled)
         return;
 
+    m_searchCancelled = true;
+
+    for (const PluginSearch &pluginSearch : asConst(m_pluginSearches))
+    {
+        if (!pluginSearch.process || (pluginSearch.process->state() == QProcess::NotRunning))
+            continue;
+
+        pluginSearch.timeout->stop();
 #ifdef Q_OS_WIN
-    m_searchProcess->kill();
+        pluginSearch.process->kill();
 #else
-    m_searchProcess->terminate();
+        pluginSearch.process->terminate();
 #endif
-    m_searchCancelled = true;
-    m_searchTimeout->stop();
+    }
+
+    // finish immediately if there are no running processes to wait for
+    startPendingPluginSearches();
 }
 
 // Slot called when QProcess is Finished
 // QProcess can be finished for 3 reasons:
 // Error | Stopped by user | Finished normally
-void SearchHandler::processFinished(const int exitcode)
+void SearchHandler::processFinished(PluginSearch &pluginSearch, const int exitcode)
 {
-    m_searchTimeout->stop();
+    pluginSearch.timeout->stop();
 
-    const auto errMsg = QString::fromUtf8(m_searchProcess->readAllStandardError()).trimmed();
+    const auto errMsg = QString::fromUtf8(pluginSearch.process->readAllStandardError()).trimmed();
     if (!errMsg.isEmpty())
     {
         qWarning("%s", qUtf8Printable(errMsg));
-        LogMsg(tr("Error occurred in search engine. Search query: \"%1\". Category: \"%2\". Engines: \"%3\". Error: \"%4\".")
-            .arg(m_pattern, m_category, m_usedPlugins.join(u", "), errMsg), Log::WARNING);
+        LogMsg(tr("Error occurred in search engine. Search query: \"%1\". Category: \"%2\". Engine: \"%3\". Error: \"%4\".")
+            .arg(m_pattern, m_category, pluginSearch.pluginName, errMsg), Log::WARNING);
     }
 
-    if (m_searchCancelled)
-        emit searchFinished(true);
-    else if ((m_searchProcess->exitStatus() == QProcess::NormalExit) && (exitcode == 0))
-        emit searchFinished(false);
+    const bool isSucceeded = (pluginSearch.process->exitStatus() == QProcess::NormalExit) && (exitcode == 0);
+    if (isSucceeded && !m_searchCancelled)
+    {
+        QList<SearchResult> pluginResults;
+        pluginResults.reserve(pluginSearch.resultIndexes.size());
+        for (const qsizetype index : asConst(pluginSearch.resultIndexes))
+            pluginResults.append(m_results[index]);
+        m_manager->cacheSearchResults(m_pattern, m_category, pluginSearch.pluginName, pluginResults);
+    }
+
+    if (isSucceeded || m_searchCancelled)
+        pluginSearchFinished(pluginSearch);
     else
-        emit searchFailed(errMsg);
+        pluginSearchFinished(pluginSearch, (errMsg.isEmpty() ? toString(pluginSearch.process->error()) : errMsg));
+}
+
+void SearchHandler::pluginSearchFinished(PluginSearch &pluginSearch, const QString &errorMessage)
+{
+    if (!errorMessage.isEmpty())
+    {
+        pluginSearch.isFailed = true;
+        ++m_failedPluginCount;
+        m_lastErrorMessage = errorMessage;
+    }
+
+    pluginSearch.process->deleteLater();
+    pluginSearch.process = nullptr;
+    pluginSearch.timeout->deleteLater();
+    pluginSearch.timeout = nullptr;
+
+    --m_runningProcessCount;
+    startPendingPluginSearches();
 }
 
 // search QProcess return output as soon as it gets new
 // stuff to read. We split it into lines and parse each
 // line to SearchResult calling parseSearchResult().
-void SearchHandler::readSearchOutput()
+void SearchHandler::readSearchOutput(PluginSearch &pluginSearch)
 {
-    const QByteArray output = m_searchResultLineTruncated + m_searchProcess->readAllStandardOutput();
+    const QByteArray output = pluginSearch.truncatedLine + pluginSearch.process->readAllStandardOutput();
     QList<QByteArrayView> lines = Utils::ByteArray::splitToViews(output, "\n", Qt::KeepEmptyParts);
 
-    m_searchResultLineTruncated = lines.takeLast().trimmed().toByteArray();
+    pluginSearch.truncatedLine = lines.takeLast().trimmed().toByteArray();
 
     QList<SearchResult> searchResultList;
     searchResultList.reserve(lines.size());
@@ -194,11 +330,29 @@ void SearchHandler::readSearchOutput()
             searchResultList.append(std::move(searchResult));
     }
 
-    if (!searchResultList.isEmpty())
+    appendResults(pluginSearch, searchResultList);
+}
+
+void SearchHandler::appendResults(PluginSearch &pluginSearch, const QList<SearchResult> &results)
+{
+    const qsizetype oldResultsCount = m_results.size();
+    pluginSearch.resultIndexes.reserve(pluginSearch.resultIndexes.size() + results.size());
+    for (const SearchResult &searchResult : results)
     {
-        m_results.append(searchResultList);
-        emit newSearchResults(searchResultList);
+        // Duplicates of the results received from other plugins refer to the existing ones
+        const QString key = resultKey(searchResult);
+        qsizetype index = m_resultIndexByKey.value(key, -1);
+        if (index < 0)
+        {
+            index = m_results.size();
+            m_results.append(searchResult);
+            m_resultIndexByKey.insert(key, index);
+        }
+        pluginSearch.resultIndexes.append(index);
     }
+
+    if (m_results.size() > oldResultsCount)
+        emit newSearchResults(m_results.sliced(oldResultsCount));
 }
 
 // Parse one line of search results list
@@ -227,8 +381,12 @@ bool SearchHandler::parseSearchResult(const QByteArrayView line, SearchResult &s
     if (!ok || (searchResult.nbLeechers < 0))
         searchResult.nbLeechers = -1;
 
-    searchResult.siteUrl = QString::fromUtf8(parts.at(PL_ENGINE_URL).trimmed()); // Search engine site URL
-    searchResult.engineName = m_manager->pluginNameBySiteURL(searchResult.siteUrl); // Search engine name
+    const QString siteUrl = QString::fromUtf8(parts.at(PL_ENGINE_URL).trimmed()); // Search engine site URL
+    auto engineIter = m_engineNameBySiteURL.constFind(siteUrl);
+    if (engineIter == m_engineNameBySiteURL.cend())
+        engineIter = m_engineNameBySiteURL.insert(siteUrl, m_manager->pluginNameBySiteURL(siteUrl));
+    searchResult.siteUrl = engineIter.key();
+    searchResult.engineName = engineIter.value(); // Search engine name
 
     if (nbFields > PL_DESC_LINK)
         searchResult.descrLink = QString::fromUtf8(parts.at(PL_DESC_LINK).trimmed()); // Description Link
@@ -243,12 +401,21 @@ bool SearchHandler::parseSearchResult(const QByteArrayView line, SearchResult &s
     return true;
 }
 
+QHash<QString, int> SearchHandler::resultCountByPlugin() const
+{
+    QHash<QString, int> counts;
+    counts.reserve(m_pluginSearches.size());
+    for (const PluginSearch &pluginSearch : m_pluginSearches)
+        counts.insert(pluginSearch.pluginName, pluginSearch.resultIndexes.size());
+    return counts;
+}
+
 SearchPluginManager *SearchHandler::manager() const
 {
     return m_manager;
 }
 
-QList<SearchResult> SearchHandler::results() const
+const QList<SearchResult> &SearchHandler::results() const
 {
     return m_results;
 }
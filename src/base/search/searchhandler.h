@@ -31,6 +31,7 @@
 
 #include <QByteArray>
 #include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QString>
@@ -68,7 +69,9 @@ public:
     bool isActive() const;
     QString pattern() const;
     SearchPluginManager *manager() const;
-    QList<SearchResult> results() const;
+    const QList<SearchResult> &results() const;
+    // Number of results received from each plugin (including the ones that were dropped as duplicates)
+    QHash<QString, int> resultCountByPlugin() const;
 
     void cancelSearch();
 
@@ -78,17 +81,43 @@ signals:
     void newSearchResults(const QList<SearchResult> &results);
 
 private:
-    void readSearchOutput();
-    void processFinished(int exitcode);
+    // Each plugin is run by its own search process so that
+    // slow or failing plugins don't hold up the results of the others
+    struct PluginSearch
+    {
+        QString pluginName;
+        QProcess *process = nullptr;
+        QTimer *timeout = nullptr;
+        QByteArray truncatedLine;
+        // Indexes of the results received from the plugin (including duplicates of other plugins' ones) in m_results
+        QList<qsizetype> resultIndexes;
+        bool isCached = false;
+        bool isFailed = false;
+    };
+
+    void start();
+    void startPluginSearch(PluginSearch &pluginSearch);
+    void startPendingPluginSearches();
+    void readSearchOutput(PluginSearch &pluginSearch);
+    void processFinished(PluginSearch &pluginSearch, int exitcode);
+    void pluginSearchFinished(PluginSearch &pluginSearch, const QString &errorMessage = {});
     bool parseSearchResult(QByteArrayView line, SearchResult &searchResult);
+    void appendResults(PluginSearch &pluginSearch, const QList<SearchResult> &results);
 
     const QString m_pattern;
     const QString m_category;
     const QStringList m_usedPlugins;
     SearchPluginManager *m_manager = nullptr;
-    QProcess *m_searchProcess = nullptr;
-    QTimer *m_searchTimeout = nullptr;
-    QByteArray m_searchResultLineTruncated;
+    QList<PluginSearch> m_pluginSearches;
+    qsizetype m_nextPluginSearchIndex = 0;
+    int m_runningProcessCount = 0;
+    int m_failedPluginCount = 0;
+    QString m_lastErrorMessage;
     bool m_searchCancelled = false;
+    bool m_searchFinished = false;
     QList<SearchResult> m_results;
+    // Site URL -> engine name. It's also used to share the same string data between all the results
+    QHash<QString, QString> m_engineNameBySiteURL;
+    // Torrent info hashes (or download URLs when they aren't available) of the results received so far
+    QHash<QString, qsizetype> m_resultIndexByKey;
 };
@@ -29,6 +29,7 @@
 
 #include "searchpluginmanager.h"
 
+#include <chrono>
 #include <memory>
 
 #include <QtLogging>
@@ -54,8 +55,13 @@
 #include "searchdownloadhandler.h"
 #include "searchhandler.h"
 
+using namespace std::chrono_literals;
+
 namespace
 {
+    const auto SEARCH_RESULTS_CACHE_TTL = 5min;
+    const int MAX_SEARCH_RESULTS_CACHE_SIZE = 100;
+
     void clearPythonCache(const Path &path)
     {
         // remove python cache artifacts in `path` and subdirs
@@ -348,6 +354,13 @@ bool SearchPluginManager::uninstallPlugin(const QString &name)
 
     // Remove it from supported engines
     delete m_plugins.take(name);
+    for (auto iter = m_searchResultsCache.begin(); iter != m_searchResultsCache.end();)
+    {
+        if (iter.key().pluginName == name)
+            iter = m_searchResultsCache.erase(iter);
+        else
+            ++iter;
+    }
 
     emit pluginUninstalled(name);
     return true;
@@ -375,7 +388,7 @@ void SearchPluginManager::checkForUpdates()
 {
     // Download version file from update server
     using namespace Net;
-    DownloadManager::instance()->download({m_updateUrl + u"versions.txt"}
+    DownloadManager::instance()->download(DownloadRequest(m_updateUrl + u"versions.txt").useCache(false)
             , Preferences::instance()->useProxyForGeneralPurposes()
             , this, &SearchPluginManager::versionInfoDownloadFinished);
 }
@@ -398,6 +411,41 @@ QProcessEnvironment SearchPluginManager::proxyEnvironment() const
     return m_proxyEnv;
 }
 
+std::optional<QList<SearchResult>> SearchPluginManager::cachedSearchResults(const QString &pattern
+        , const QString &category, const QString &pluginName) const
+{
+    const auto iter = m_searchResultsCache.constFind({pattern, category, pluginName});
+    if ((iter == m_searchResultsCache.cend()) || iter->expiration.hasExpired())
+        return std::nullopt;
+
+    return iter->results;
+}
+
+void SearchPluginManager::cacheSearchResults(const QString &pattern, const QString &category
+        , const QString &pluginName, const QList<SearchResult> &results)
+{
+    for (auto iter = m_searchResultsCache.begin(); iter != m_searchResultsCache.end();)
+    {
+        if (iter->expiration.hasExpired())
+            iter = m_searchResultsCache.erase(iter);
+        else
+            ++iter;
+    }
+
+    if (m_searchResultsCache.size() >= MAX_SEARCH_RESULTS_CACHE_SIZE)
+    {
+        // evict the oldest entry
+        const auto oldestIter = std::ranges::min_element(m_searchResultsCache
+                , [](const CachedSearchResults &left, const CachedSearchResults &right)
+        {
+            return left.expiration < right.expiration;
+        });
+        m_searchResultsCache.erase(oldestIter);
+    }
+
+    m_searchResultsCache.insert({pattern, category, pluginName}, {results, QDeadlineTimer(SEARCH_RESULTS_CACHE_TTL)});
+}
+
 QString SearchPluginManager::categoryFullName(const QString &categoryName)
 {
     const QHash<QString, QString> categoryTable
@@ -574,6 +622,9 @@ void SearchPluginManager::updateNova()
 
 void SearchPluginManager::update()
 {
+    // plugins may have changed so previous results are no longer relevant
+    m_searchResultsCache.clear();
+
     QProcess nova;
     nova.setProcessEnvironment(proxyEnvironment());
 #ifdef Q_OS_UNIX
@@ -29,12 +29,17 @@
 
 #pragma once
 
+#include <optional>
+
+#include <QDeadlineTimer>
 #include <QHash>
+#include <QList>
 #include <QObject>
 #include <QProcessEnvironment>
 
 #include "base/path.h"
 #include "base/utils/version.h"
+#include "searchhandler.h"
 
 using SearchPluginVersion = Utils::Version<2>;
 
@@ -55,7 +60,6 @@ struct SearchPluginInfo
 };
 
 class SearchDownloadHandler;
-class SearchHandler;
 
 class SearchPluginManager final : public QObject
 {
@@ -88,6 +92,10 @@ public:
 
     QProcessEnvironment proxyEnvironment() const;
 
+    // Recent search results are kept for a while so repeated queries don't need to run the plugins again
+    std::optional<QList<SearchResult>> cachedSearchResults(const QString &pattern, const QString &category, const QString &pluginName) const;
+    void cacheSearchResults(const QString &pattern, const QString &category, const QString &pluginName, const QList<SearchResult> &results);
+
     static SearchPluginVersion getPluginVersion(const Path &filePath);
     static QString categoryFullName(const QString &categoryName);
     QString pluginFullName(const QString &pluginName) const;
@@ -106,6 +114,25 @@ signals:
     void checkForUpdatesFailed(const QString &reason);
 
 private:
+    struct SearchResultsCacheKey
+    {
+        QString pattern;
+        QString category;
+        QString pluginName;
+
+        friend bool operator==(const SearchResultsCacheKey &, const SearchResultsCacheKey &) = default;
+        friend std::size_t qHash(const SearchResultsCacheKey &key, const std::size_t seed = 0)
+        {
+            return qHashMulti(seed, key.pattern, key.category, key.pluginName);
+        }
+    };
+
+    struct CachedSearchResults
+    {
+        QList<SearchResult> results;
+        QDeadlineTimer expiration;
+    };
+
     void applyProxySettings();
     void update();
     void updateNova();
@@ -124,4 +151,5 @@ private:
 
     QHash<QString, SearchPluginInfo*> m_plugins;
     QProcessEnvironment m_proxyEnv;
+    QHash<SearchResultsCacheKey, CachedSearchResults> m_searchResultsCache;
 };
@@ -31,17 +31,22 @@
 
 #include <chrono>
 #include <memory>
+#include <utility>
 
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
 #include <QHash>
 #include <QMetaObject>
 #include <QOverload>
+#include <QThread>
 
 #include "global.h"
 #include "logger.h"
 #include "path.h"
 #include "profile.h"
 #include "utils/fs.h"
+#include "utils/io.h"
 
 using namespace std::chrono_literals;
 
@@ -49,9 +54,16 @@ SettingsStorage *SettingsStorage::m_instance = nullptr;
 
 SettingsStorage::SettingsStorage()
     : m_nativeSettingsName {u"qBittorrent"_s}
+    , m_ioThread {new QThread}
+    , m_asyncWorker {new QObject}
 {
     readNativeSettings();
 
+    m_asyncWorker->moveToThread(m_ioThread.get());
+    connect(m_ioThread.get(), &QThread::finished, m_asyncWorker, &QObject::deleteLater);
+    m_ioThread->setObjectName("SettingsStorage m_ioThread");
+    m_ioThread->start();
+
     m_timer.setSingleShot(true);
     m_timer.setInterval(5s);
     connect(&m_timer, &QTimer::timeout, this, &SettingsStorage::save);
@@ -59,7 +71,12 @@ SettingsStorage::SettingsStorage()
 
 SettingsStorage::~SettingsStorage()
 {
-    save();
+    // Let current saving job complete, then write any remaining changes synchronously
+    m_ioThread.reset();
+
+    const QMutexLocker locker {&m_saveMutex};
+    if (m_dirty || m_hasPendingData)
+        writeNativeSettings(m_data);
 }
 
 void SettingsStorage::initInstance()
@@ -81,21 +98,69 @@ SettingsStorage *SettingsStorage::instance()
 
 bool SettingsStorage::save()
 {
-    // return `true` only when settings is different AND is saved successfully
-
-    const QWriteLocker locker(&m_lock);  // guard for `m_dirty` too
-    if (!m_dirty) return false;
+    // return `true` only when settings is different AND is scheduled to be saved
 
-    if (!writeNativeSettings())
     {
-        QMetaObject::invokeMethod(&m_timer, qOverload<>(&QTimer::start));
-        return false;
+        const QWriteLocker locker(&m_lock);  // guard for `m_dirty` too
+        if (!m_dirty) return false;
+
+        m_dirty = false;
+
+        // Only the most recent data is kept so bursts of changes result in a single write.
+        // It is implicitly shared so actual copying occurs only if `m_data` is modified meanwhile.
+        const QMutexLocker saveLocker {&m_saveMutex};
+        m_pendingData = m_data;
+        m_hasPendingData = true;
     }
 
-    m_dirty = false;
+    QMetaObject::invokeMethod(m_asyncWorker, [this] { writePendingData(); });
     return true;
 }
 
+SettingsStorage::SaveStatistics SettingsStorage::saveStatistics() const
+{
+    const QMutexLocker locker {&m_saveMutex};
+    return m_saveStatistics;
+}
+
+void SettingsStorage::writePendingData()
+{
+    QVariantHash data;
+    {
+        const QMutexLocker locker {&m_saveMutex};
+        if (!m_hasPendingData)
+            return;  // already written by previous job
+
+        data = std::exchange(m_pendingData, {});
+        m_hasPendingData = false;
+    }
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    const std::optional<qint64> bytesWritten = writeNativeSettings(data);
+    const auto duration = std::chrono::milliseconds(elapsedTimer.elapsed());
+
+    const QMutexLocker locker {&m_saveMutex};
+    if (!bytesWritten)
+    {
+        // Retry later unless there is more recent data to be written
+        if (!m_hasPendingData)
+        {
+            m_pendingData = data;
+            m_hasPendingData = true;
+        }
+
+        QTimer::singleShot(5s, m_asyncWorker, [this] { writePendingData(); });
+        return;
+    }
+
+    ++m_saveStatistics.saveCount;
+    m_saveStatistics.bytesWritten += *bytesWritten;
+    m_saveStatistics.lastSaveDuration = duration;
+    m_saveStatistics.totalSaveDuration += duration;
+}
+
 QVariant SettingsStorage::loadValueImpl(const QString &key, const QVariant &defaultValue) const
 {
     const QReadLocker locker(&m_lock);
@@ -153,9 +218,7 @@ void SettingsStorage::readNativeSettings()
         const qsizetype index = finalPathStr.lastIndexOf(u"_new", -1, Qt::CaseInsensitive);
         finalPathStr.remove(index, 4);
 
-        const Path finalPath {finalPathStr};
-        Utils::Fs::removeFile(finalPath);
-        Utils::Fs::renameFile(newPath, finalPath);
+        replaceSettingsFile(newPath, Path(finalPathStr));
     }
     else
     {
@@ -163,15 +226,17 @@ void SettingsStorage::readNativeSettings()
     }
 }
 
-bool SettingsStorage::writeNativeSettings() const
+std::optional<qint64> SettingsStorage::writeNativeSettings(const QVariantHash &data) const
 {
+    // return the number of bytes written or `std::nullopt` if saving should be retried
+
     const auto *profile = Profile::instance();
 
     // No-op when it has no write permission
     if (const auto confPath = Path(profile->applicationSettings(m_nativeSettingsName)->fileName());
         confPath.exists() && !Utils::Fs::isWritable(confPath))
     {
-        return true;  // no need to retry saving
+        return 0;  // no need to retry saving
     }
 
     std::unique_ptr<QSettings> nativeSettings = profile->applicationSettings(m_nativeSettingsName + u"_new");
@@ -181,7 +246,7 @@ bool SettingsStorage::writeNativeSettings() const
     // between deleting the file and recreating it. This is a safety measure.
     // Write everything to qBittorrent_new.ini/qBittorrent_new.conf and if it succeeds
     // replace qBittorrent.ini/qBittorrent.conf with it.
-    for (auto i = m_data.cbegin(); i != m_data.cend(); ++i)
+    for (auto i = data.cbegin(); i != data.cend(); ++i)
         nativeSettings->setValue(i.key(), i.value());
 
     nativeSettings->sync(); // Important to get error status
@@ -208,16 +273,41 @@ bool SettingsStorage::writeNativeSettings() const
     if (status != QSettings::NoError)
     {
         Utils::Fs::removeFile(newPath);
-        return false;
+        return std::nullopt;
     }
 
+    const qint64 fileSize = QFileInfo(newPath.data()).size();
+
     QString finalPathStr = newPath.data();
     const qsizetype index = finalPathStr.lastIndexOf(u"_new", -1, Qt::CaseInsensitive);
     finalPathStr.remove(index, 4);
 
-    const Path finalPath {finalPathStr};
-    Utils::Fs::removeFile(finalPath);
-    return Utils::Fs::renameFile(newPath, finalPath);
+    if (!replaceSettingsFile(newPath, Path(finalPathStr)))
+        return std::nullopt;
+
+    return fileSize;
+}
+
+bool SettingsStorage::replaceSettingsFile(const Path &newPath, const Path &finalPath)
+{
+    // Final file is replaced atomically so it can't get lost if the program is interrupted.
+    // "_new" file is removed only after that, so it can be used to restore settings otherwise.
+    const auto readResult = Utils::IO::readFile(newPath, -1);
+    if (!readResult)
+    {
+        LogMsg(tr("Couldn't read the configuration file. Error: \"%1\"").arg(readResult.error().message), Log::CRITICAL);
+        return false;
+    }
+
+    if (const auto saveResult = Utils::IO::saveToFile(finalPath, readResult.value()); !saveResult)
+    {
+        LogMsg(tr("Couldn't save the configuration file. File: \"%1\". Error: \"%2\"")
+            .arg(finalPath.toString(), saveResult.error()), Log::CRITICAL);
+        return false;
+    }
+
+    Utils::Fs::removeFile(newPath);
+    return true;
 }
 
 void SettingsStorage::removeValue(const QString &key)
@@ -30,8 +30,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <type_traits>
 
+#include <QMutex>
 #include <QObject>
 #include <QReadWriteLock>
 #include <QTimer>
@@ -39,7 +42,9 @@
 #include <QVariantHash>
 
 #include "base/concepts/stringable.h"
+#include "base/pathfwd.h"
 #include "utils/string.h"
+#include "utils/thread.h"
 
 template <typename T>
 concept IsQFlags = std::same_as<T, QFlags<typename T::enum_type>>;
@@ -57,6 +62,14 @@ class SettingsStorage final : public QObject
     ~SettingsStorage();
 
 public:
+    struct SaveStatistics
+    {
+        qint64 saveCount = 0;
+        qint64 bytesWritten = 0;
+        std::chrono::milliseconds lastSaveDuration {};
+        std::chrono::milliseconds totalSaveDuration {};
+    };
+
     static void initInstance();
     static void freeInstance();
     static SettingsStorage *instance();
@@ -111,6 +124,8 @@ public:
     bool hasKey(const QString &key) const;
     bool isEmpty() const;
 
+    SaveStatistics saveStatistics() const;
+
 public slots:
     bool save();
 
@@ -118,7 +133,9 @@ private:
     QVariant loadValueImpl(const QString &key, const QVariant &defaultValue = {}) const;
     void storeValueImpl(const QString &key, const QVariant &value);
     void readNativeSettings();
-    bool writeNativeSettings() const;
+    void writePendingData();
+    std::optional<qint64> writeNativeSettings(const QVariantHash &data) const;
+    static bool replaceSettingsFile(const Path &newPath, const Path &finalPath);
 
     static SettingsStorage *m_instance;
 
@@ -127,4 +144,12 @@ private:
     QVariantHash m_data;
     QTimer m_timer;
     mutable QReadWriteLock m_lock;
+
+    Utils::Thread::UniquePtr m_ioThread;
+    QObject *m_asyncWorker = nullptr;
+    // guards the members below, which are shared with `m_ioThread`
+    mutable QMutex m_saveMutex;
+    QVariantHash m_pendingData;
+    bool m_hasPendingData = false;
+    SaveStatistics m_saveStatistics;
 };
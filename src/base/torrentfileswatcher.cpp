@@ -36,6 +36,7 @@
 #include <QDirIterator>
 #include <QFile>
 #include <QFileSystemWatcher>
+#include <QFuture>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QSet>
@@ -57,6 +58,10 @@
 #include "base/utils/io.h"
 #include "base/utils/string.h"
 
+#ifdef Q_OS_LINUX
+#include "base/inotifywatcher.h"
+#endif
+
 using namespace std::chrono_literals;
 
 const std::chrono::seconds WATCH_INTERVAL {10};
@@ -104,15 +109,39 @@ private:
     void scheduleWatchedFolderProcessing(const Path &path);
     void processWatchedFolder(const Path &path);
     void processFolder(const Path &path, const Path &watchedFolderPath, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void processFile(const Path &filePath, const Path &folderPath, const Path &watchedFolderPath
+            , const TorrentFilesWatcher::WatchedFolderOptions &options);
     void processFailedTorrents();
+    void startRetryTimer();
     void addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
     void updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void startWatching(const Path &path);
+    void stopWatching(const Path &path);
+    void watchByTimeout(const Path &path);
+
+#ifdef Q_OS_LINUX
+    bool watchByInotify(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    bool addInotifyWatches(const Path &path, bool recursive);
+    void removeInotifyWatches(const Path &watchedFolderPath);
+    Path findWatchedFolder(const Path &path) const;
+    void onInotifyFileWritten(const Path &filePath);
+    void onInotifyDirectoryCreated(const Path &path);
+    void onInotifyDirectoryRemoved(const Path &path);
+    void onInotifyOverflowed();
+#endif
 
     QFileSystemWatcher *m_watcher = nullptr;
     QTimer *m_watchTimer = nullptr;
     QHash<Path, TorrentFilesWatcher::WatchedFolderOptions> m_watchedFolders;
     QSet<Path> m_watchedByTimeoutFolders;
 
+#ifdef Q_OS_LINUX
+    // Folders (with all their subfolders if recursive) watched via inotify,
+    // so only affected files are processed instead of rescanning the whole tree
+    InotifyWatcher *m_inotifyWatcher = nullptr;
+    QSet<Path> m_watchedByInotifyFolders;
+#endif
+
     // Failed torrents
     QTimer *m_retryTorrentTimer = nullptr;
     QHash<Path, QHash<Path, int>> m_failedTorrents;
@@ -309,7 +338,19 @@ void TorrentFilesWatcher::removeWatchedFolder(const Path &path)
 void TorrentFilesWatcher::onTorrentFound(const BitTorrent::TorrentDescriptor &torrentDescr
         , const BitTorrent::AddTorrentParams &addTorrentParams)
 {
-    BitTorrent::Session::instance()->addTorrent(torrentDescr, addTorrentParams);
+    if (m_foundTorrents.isEmpty())
+        QMetaObject::invokeMethod(this, &TorrentFilesWatcher::addFoundTorrents, Qt::QueuedConnection);
+
+    m_foundTorrents.emplaceBack(torrentDescr, addTorrentParams);
+}
+
+void TorrentFilesWatcher::addFoundTorrents()
+{
+    const auto foundTorrents = std::exchange(m_foundTorrents, {});
+    if (foundTorrents.size() == 1)
+        BitTorrent::Session::instance()->addTorrent(foundTorrents[0].first, foundTorrents[0].second);
+    else
+        BitTorrent::Session::instance()->addTorrents(foundTorrents);
 }
 
 TorrentFilesWatcher::Worker::Worker(QFileSystemWatcher *watcher)
@@ -342,13 +383,9 @@ void TorrentFilesWatcher::Worker::setWatchedFolder(const Path &path, const Torre
 
 void TorrentFilesWatcher::Worker::removeWatchedFolder(const Path &path)
 {
+    stopWatching(path);
     m_watchedFolders.remove(path);
 
-    m_watcher->removePath(path.data());
-    m_watchedByTimeoutFolders.remove(path);
-    if (m_watchedByTimeoutFolders.isEmpty())
-        m_watchTimer->stop();
-
     m_failedTorrents.remove(path);
     if (m_failedTorrents.isEmpty())
         m_retryTorrentTimer->stop();
@@ -367,6 +404,11 @@ void TorrentFilesWatcher::Worker::processWatchedFolder(const Path &path)
     const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(path);
     processFolder(path, path, options);
 
+    startRetryTimer();
+}
+
+void TorrentFilesWatcher::Worker::startRetryTimer()
+{
     if (!m_failedTorrents.empty() && !m_retryTorrentTimer->isActive())
         m_retryTorrentTimer->start(WATCH_INTERVAL);
 }
@@ -376,81 +418,84 @@ void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &wa
 {
     QDirIterator dirIter {path.data(), {u"*.torrent"_s, u"*.magnet"_s}, QDir::Files};
     while (dirIter.hasNext())
+        processFile(Path(dirIter.next()), path, watchedFolderPath, options);
+
+    if (options.recursive)
     {
-        const Path filePath {dirIter.next()};
-        BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
-        if (path != watchedFolderPath)
+        QDirIterator iter {path.data(), (QDir::Dirs | QDir::NoDotAndDotDot)};
+        while (iter.hasNext())
         {
-            const Path subdirPath = watchedFolderPath.relativePathOf(path);
-            const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
-            if (useAutoTMM)
-            {
-                addTorrentParams.category = addTorrentParams.category.isEmpty()
-                        ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
-            }
-            else
-            {
-                addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
-            }
+            const Path folderPath {iter.next()};
+            // Skip processing of subdirectory that is explicitly set as watched folder
+            if (!m_watchedFolders.contains(folderPath))
+                processFolder(folderPath, watchedFolderPath, options);
         }
+    }
+}
 
-        if (filePath.hasExtension(u".magnet"_s))
+void TorrentFilesWatcher::Worker::processFile(const Path &filePath, const Path &folderPath
+        , const Path &watchedFolderPath, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
+    if (folderPath != watchedFolderPath)
+    {
+        const Path subdirPath = watchedFolderPath.relativePathOf(folderPath);
+        const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
+        if (useAutoTMM)
+        {
+            addTorrentParams.category = addTorrentParams.category.isEmpty()
+                    ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
+        }
+        else
         {
-            const int fileMaxSize = 100 * 1024 * 1024;
+            addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
+        }
+    }
 
-            QFile file {filePath.data()};
-            if (file.open(QIODevice::ReadOnly | QIODevice::Text))
-            {
-                if (file.size() <= fileMaxSize)
-                {
-                    while (!file.atEnd())
-                    {
-                        const auto line = QString::fromLatin1(file.readLine()).trimmed();
-                        if (const auto parseResult = BitTorrent::TorrentDescriptor::parse(line))
-                            emit torrentFound(parseResult.value(), addTorrentParams);
-                        else
-                            LogMsg(tr("Invalid Magnet URI. URI: %1. Reason: %2").arg(line, parseResult.error()), Log::WARNING);
-                    }
+    if (filePath.hasExtension(u".magnet"_s))
+    {
+        const int fileMaxSize = 100 * 1024 * 1024;
 
-                    file.close();
-                    Utils::Fs::removeFile(filePath);
-                }
-                else
+        QFile file {filePath.data()};
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            if (file.size() <= fileMaxSize)
+            {
+                while (!file.atEnd())
                 {
-                    LogMsg(tr("Magnet file too big. File: %1").arg(file.errorString()), Log::WARNING);
+                    const auto line = QString::fromLatin1(file.readLine()).trimmed();
+                    if (const auto parseResult = BitTorrent::TorrentDescriptor::parse(line))
+                        emit torrentFound(parseResult.value(), addTorrentParams);
+                    else
+                        LogMsg(tr("Invalid Magnet URI. URI: %1. Reason: %2").arg(line, parseResult.error()), Log::WARNING);
                 }
+
+                file.close();
+                Utils::Fs::removeFile(filePath);
             }
             else
             {
-                LogMsg(tr("Failed to open magnet file: %1").arg(file.errorString()));
+                LogMsg(tr("Magnet file too big. File: %1").arg(file.errorString()), Log::WARNING);
             }
         }
         else
         {
-            if (const auto loadResult = BitTorrent::TorrentDescriptor::loadFromFile(filePath))
-            {
-                emit torrentFound(loadResult.value(), addTorrentParams);
-                Utils::Fs::removeFile(filePath);
-            }
-            else
-            {
-                if (!m_failedTorrents.value(watchedFolderPath).contains(filePath))
-                {
-                    m_failedTorrents[watchedFolderPath][filePath] = 0;
-                }
-            }
+            LogMsg(tr("Failed to open magnet file: %1").arg(file.errorString()));
         }
     }
-
-    if (options.recursive)
+    else
     {
-        QDirIterator iter {path.data(), (QDir::Dirs | QDir::NoDotAndDotDot)};
-        while (iter.hasNext())
+        if (const auto loadResult = BitTorrent::TorrentDescriptor::loadFromFile(filePath))
         {
-            const Path folderPath {iter.next()};
-            // Skip processing of subdirectory that is explicitly set as watched folder
-            if (!m_watchedFolders.contains(folderPath))
-                processFolder(folderPath, watchedFolderPath, options);
+            emit torrentFound(loadResult.value(), addTorrentParams);
+            Utils::Fs::removeFile(filePath);
+        }
+        else
+        {
+            if (!m_failedTorrents.value(watchedFolderPath).contains(filePath))
+            {
+                m_failedTorrents[watchedFolderPath][filePath] = 0;
+            }
         }
     }
 }
@@ -516,49 +561,223 @@ void TorrentFilesWatcher::Worker::processFailedTorrents()
 
 void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
 {
+    m_watchedFolders[path] = options;
+    startWatching(path);
+
+    LogMsg(tr("Watching folder: \"%1\"").arg(path.toString()));
+}
+
+void TorrentFilesWatcher::Worker::updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    const bool recursiveModeChanged = (m_watchedFolders[path].recursive != options.recursive);
+    if (recursiveModeChanged)
+    {
+        stopWatching(path);
+        m_watchedFolders[path] = options;
+        startWatching(path);
+    }
+    else
+    {
+        m_watchedFolders[path] = options;
+    }
+}
+
+void TorrentFilesWatcher::Worker::startWatching(const Path &path)
+{
+    const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(path);
+
     // Check if the `path` points to a network file system or not
-    if (Utils::Fs::isNetworkFileSystem(path) || options.recursive)
+    if (Utils::Fs::isNetworkFileSystem(path))
     {
-        m_watchedByTimeoutFolders.insert(path);
-        if (!m_watchTimer->isActive())
-            m_watchTimer->start(WATCH_INTERVAL);
+        watchByTimeout(path);
+    }
+#ifdef Q_OS_LINUX
+    else if (watchByInotify(path, options))
+    {
+        scheduleWatchedFolderProcessing(path);
+    }
+#endif
+    else if (options.recursive)
+    {
+        watchByTimeout(path);
     }
     else
     {
         m_watcher->addPath(path.data());
         scheduleWatchedFolderProcessing(path);
     }
+}
 
-    m_watchedFolders[path] = options;
+void TorrentFilesWatcher::Worker::stopWatching(const Path &path)
+{
+    m_watcher->removePath(path.data());
 
-    LogMsg(tr("Watching folder: \"%1\"").arg(path.toString()));
+    m_watchedByTimeoutFolders.remove(path);
+    if (m_watchedByTimeoutFolders.isEmpty())
+        m_watchTimer->stop();
+
+#ifdef Q_OS_LINUX
+    if (m_watchedByInotifyFolders.remove(path))
+        removeInotifyWatches(path);
+#endif
 }
 
-void TorrentFilesWatcher::Worker::updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+void TorrentFilesWatcher::Worker::watchByTimeout(const Path &path)
 {
-    const bool recursiveModeChanged = (m_watchedFolders[path].recursive != options.recursive);
-    if (recursiveModeChanged && !Utils::Fs::isNetworkFileSystem(path))
+    m_watchedByTimeoutFolders.insert(path);
+    if (!m_watchTimer->isActive())
+        m_watchTimer->start(WATCH_INTERVAL);
+}
+
+#ifdef Q_OS_LINUX
+bool TorrentFilesWatcher::Worker::watchByInotify(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    if (!m_inotifyWatcher)
     {
-        if (options.recursive)
-        {
-            m_watcher->removePath(path.data());
+        m_inotifyWatcher = new InotifyWatcher(this);
+        connect(m_inotifyWatcher, &InotifyWatcher::fileWritten, this, &Worker::onInotifyFileWritten);
+        connect(m_inotifyWatcher, &InotifyWatcher::directoryCreated, this, &Worker::onInotifyDirectoryCreated);
+        connect(m_inotifyWatcher, &InotifyWatcher::directoryRemoved, this, &Worker::onInotifyDirectoryRemoved);
+        connect(m_inotifyWatcher, &InotifyWatcher::overflowed, this, &Worker::onInotifyOverflowed);
+    }
 
-            m_watchedByTimeoutFolders.insert(path);
-            if (!m_watchTimer->isActive())
-                m_watchTimer->start(WATCH_INTERVAL);
-        }
-        else
-        {
-            m_watchedByTimeoutFolders.remove(path);
-            if (m_watchedByTimeoutFolders.isEmpty())
-                m_watchTimer->stop();
+    if (!m_inotifyWatcher->isValid())
+        return false;
 
-            m_watcher->addPath(path.data());
-            scheduleWatchedFolderProcessing(path);
-        }
+    m_watchedByInotifyFolders.insert(path);
+    if (!addInotifyWatches(path, options.recursive))
+    {
+        // e.g. the limit of inotify watches is reached
+        m_watchedByInotifyFolders.remove(path);
+        removeInotifyWatches(path);
+        LogMsg(tr("Couldn't set up change notifications for folder \"%1\". Falling back to periodic scanning.")
+            .arg(path.toString()), Log::WARNING);
+        return false;
     }
 
-    m_watchedFolders[path] = options;
+    return true;
+}
+
+bool TorrentFilesWatcher::Worker::addInotifyWatches(const Path &path, const bool recursive)
+{
+    if (!m_inotifyWatcher->addPath(path))
+        return false;
+
+    if (!recursive)
+        return true;
+
+    QDirIterator iter {path.data(), (QDir::Dirs | QDir::NoDotAndDotDot)};
+    while (iter.hasNext())
+    {
+        const Path folderPath {iter.next()};
+        // Skip subdirectory that is explicitly set as watched folder
+        if (m_watchedFolders.contains(folderPath))
+            continue;
+
+        if (!addInotifyWatches(folderPath, true))
+            return false;
+    }
+
+    return true;
+}
+
+void TorrentFilesWatcher::Worker::removeInotifyWatches(const Path &watchedFolderPath)
+{
+    // Subfolders stay watched if they are covered by outer recursively watched folder
+    const Path outerWatchedFolderPath = findWatchedFolder(watchedFolderPath.parentPath());
+    if (m_watchedByInotifyFolders.contains(outerWatchedFolderPath)
+            && m_watchedFolders.value(outerWatchedFolderPath).recursive)
+    {
+        return;
+    }
+
+    const QList<Path> folderPaths = m_inotifyWatcher->paths();
+    for (const Path &folderPath : folderPaths)
+    {
+        if (findWatchedFolder(folderPath) == watchedFolderPath)
+            m_inotifyWatcher->removePath(folderPath);
+    }
+}
+
+Path TorrentFilesWatcher::Worker::findWatchedFolder(const Path &path) const
+{
+    for (Path folderPath = path; !folderPath.isEmpty(); folderPath = folderPath.parentPath())
+    {
+        if (m_watchedFolders.contains(folderPath))
+            return folderPath;
+    }
+
+    return {};
+}
+
+void TorrentFilesWatcher::Worker::onInotifyFileWritten(const Path &filePath)
+{
+    if (!filePath.hasExtension(u".torrent"_s) && !filePath.hasExtension(u".magnet"_s))
+        return;
+
+    const Path folderPath = filePath.parentPath();
+    const Path watchedFolderPath = findWatchedFolder(folderPath);
+    if (!m_watchedByInotifyFolders.contains(watchedFolderPath))
+        return;
+
+    const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(watchedFolderPath);
+    if ((folderPath != watchedFolderPath) && !options.recursive)
+        return;
+
+    processFile(filePath, folderPath, watchedFolderPath, options);
+    startRetryTimer();
+}
+
+void TorrentFilesWatcher::Worker::onInotifyDirectoryCreated(const Path &path)
+{
+    if (m_watchedFolders.contains(path))
+        return;
+
+    const Path watchedFolderPath = findWatchedFolder(path.parentPath());
+    if (!m_watchedByInotifyFolders.contains(watchedFolderPath))
+        return;
+
+    const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(watchedFolderPath);
+    if (!options.recursive)
+        return;
+
+    if (!addInotifyWatches(path, true))
+    {
+        stopWatching(watchedFolderPath);
+        LogMsg(tr("Couldn't set up change notifications for folder \"%1\". Falling back to periodic scanning.")
+            .arg(watchedFolderPath.toString()), Log::WARNING);
+        watchByTimeout(watchedFolderPath);
+        return;
+    }
+
+    // Files could be added before the folder was watched
+    processFolder(path, watchedFolderPath, options);
+    startRetryTimer();
+}
+
+void TorrentFilesWatcher::Worker::onInotifyDirectoryRemoved(const Path &path)
+{
+    // Subfolders are watched again if they appear under another watched path,
+    // but watched folders themselves can only be checked periodically until they are back
+    const QSet<Path> watchedFolderPaths = m_watchedByInotifyFolders;
+    for (const Path &watchedFolderPath : watchedFolderPaths)
+    {
+        if ((watchedFolderPath != path) && !watchedFolderPath.hasAncestor(path))
+            continue;
+
+        m_watchedByInotifyFolders.remove(watchedFolderPath);
+        removeInotifyWatches(watchedFolderPath);
+        LogMsg(tr("Watched folder \"%1\" was moved or removed. Falling back to periodic scanning.")
+            .arg(watchedFolderPath.toString()), Log::WARNING);
+        watchByTimeout(watchedFolderPath);
+    }
+}
+
+void TorrentFilesWatcher::Worker::onInotifyOverflowed()
+{
+    for (const Path &path : asConst(m_watchedByInotifyFolders))
+        processWatchedFolder(path);
 }
+#endif
 
 #include "torrentfileswatcher.moc"
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <utility>
+
 #include <QHash>
+#include <QList>
 
 #include "base/bittorrent/addtorrentparams.h"
 #include "base/bittorrent/torrentdescriptor.h"
@@ -76,10 +79,13 @@ private:
     void store() const;
 
     void doSetWatchedFolder(const Path &path, const WatchedFolderOptions &options);
+    void addFoundTorrents();
 
     static TorrentFilesWatcher *m_instance;
 
     QHash<Path, WatchedFolderOptions> m_watchedFolders;
+    // torrents found during the same scan are added to session together
+    QList<std::pair<BitTorrent::TorrentDescriptor, BitTorrent::AddTorrentParams>> m_foundTorrents;
 
     Utils::Thread::UniquePtr m_ioThread;
 
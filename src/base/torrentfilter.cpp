@@ -68,6 +68,11 @@ TorrentFilter::TorrentFilter(const Status status, const std::optional<TorrentIDS
 {
 }
 
+TorrentFilter::Status TorrentFilter::status() const
+{
+    return m_status;
+}
+
 bool TorrentFilter::setStatus(const Status status)
 {
     if (m_status != status)
@@ -123,6 +128,11 @@ bool TorrentFilter::setPrivate(const std::optional<bool> isPrivate)
     return false;
 }
 
+std::optional<QString> TorrentFilter::trackerHost() const
+{
+    return m_trackerHost;
+}
+
 bool TorrentFilter::setTrackerHost(const std::optional<QString> &trackerHost)
 {
     if (m_trackerHost != trackerHost)
@@ -134,6 +144,11 @@ bool TorrentFilter::setTrackerHost(const std::optional<QString> &trackerHost)
     return false;
 }
 
+std::optional<TorrentAnnounceStatus> TorrentFilter::announceStatus() const
+{
+    return m_announceStatus;
+}
+
 bool TorrentFilter::setAnnounceStatus(const std::optional<TorrentAnnounceStatus> &announceStatus)
 {
     if (m_announceStatus != announceStatus)
@@ -84,12 +84,15 @@ public:
             , const std::optional<QString> &trackerHost = AnyTrackerHost
             , const std::optional<BitTorrent::TorrentAnnounceStatus> &announceStatus = AnyAnnounceStatus);
 
+    Status status() const;
     bool setStatus(Status status);
     bool setTorrentIDSet(const std::optional<TorrentIDSet> &idSet);
     bool setCategory(const std::optional<QString> &category);
     bool setTag(const std::optional<Tag> &tag);
     bool setPrivate(std::optional<bool> isPrivate);
+    std::optional<QString> trackerHost() const;
     bool setTrackerHost(const std::optional<QString> &trackerHost);
+    std::optional<BitTorrent::TorrentAnnounceStatus> announceStatus() const;
     bool setAnnounceStatus(const std::optional<BitTorrent::TorrentAnnounceStatus> &announceStatus);
 
     bool match(const BitTorrent::Torrent *torrent) const;
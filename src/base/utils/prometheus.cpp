@@ -0,0 +1,112 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "prometheus.h"
+
+#include <QLocale>
+
+namespace
+{
+    QByteArrayView metricTypeName(const Utils::Prometheus::MetricType type)
+    {
+        switch (type)
+        {
+        case Utils::Prometheus::MetricType::Counter:
+            return "counter";
+        case Utils::Prometheus::MetricType::Gauge:
+            return "gauge";
+        case Utils::Prometheus::MetricType::Histogram:
+            return "histogram";
+        }
+
+        Q_UNREACHABLE();
+        return {};
+    }
+}
+
+void Utils::Prometheus::TextWriter::addMetric(const QByteArrayView name, const MetricType type, const QByteArrayView help)
+{
+    m_data.append("# HELP ").append(name).append(' ').append(help).append('\n');
+    m_data.append("# TYPE ").append(name).append(' ').append(metricTypeName(type)).append('\n');
+}
+
+void Utils::Prometheus::TextWriter::addSample(const QByteArrayView name, const qint64 value, const Labels &labels)
+{
+    addSampleName(name, labels);
+    m_data += QByteArray::number(value) + '\n';
+}
+
+void Utils::Prometheus::TextWriter::addSample(const QByteArrayView name, const double value, const Labels &labels)
+{
+    addSampleName(name, labels);
+    m_data += QByteArray::number(value, 'g', QLocale::FloatingPointShortest) + '\n';
+}
+
+QByteArray Utils::Prometheus::TextWriter::data() const
+{
+    return m_data;
+}
+
+void Utils::Prometheus::TextWriter::addSampleName(const QByteArrayView name, const Labels &labels)
+{
+    m_data.append(name);
+    if (!labels.isEmpty())
+    {
+        m_data += '{';
+        for (qsizetype i = 0; i < labels.size(); ++i)
+        {
+            if (i > 0)
+                m_data += ',';
+            m_data += labels[i].first.toLatin1() + "=\"" + escapeLabelValue(labels[i].second) + '"';
+        }
+        m_data += '}';
+    }
+    m_data += ' ';
+}
+
+QByteArray Utils::Prometheus::sanitizeName(const QByteArrayView name)
+{
+    QByteArray result;
+    result.reserve(name.size());
+    for (const char c : name)
+    {
+        const bool isValid = ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'))
+                || ((c >= '0') && (c <= '9')) || (c == '_') || (c == ':');
+        result += (isValid ? c : '_');
+    }
+    return result;
+}
+
+QByteArray Utils::Prometheus::escapeLabelValue(const QStringView value)
+{
+    QByteArray result = value.toUtf8();
+    result.replace('\\', "\\\\");
+    result.replace('"', "\\\"");
+    result.replace('\n', "\\n");
+    return result;
+}
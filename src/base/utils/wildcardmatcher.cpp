@@ -0,0 +1,83 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "wildcardmatcher.h"
+
+#include <QStringView>
+
+namespace
+{
+    bool hasWildcards(const QStringView pattern)
+    {
+        return pattern.contains(u'*') || pattern.contains(u'?') || pattern.contains(u'[')
+                || pattern.contains(u']') || pattern.contains(u'\\');
+    }
+}
+
+Utils::WildcardMatcher::WildcardMatcher(const QStringList &patterns)
+{
+    QStringList regexPatterns;
+    for (const QString &pattern : patterns)
+    {
+        if (!hasWildcards(pattern))
+            m_names.append(pattern);
+        else if (pattern.startsWith(u'*') && !hasWildcards(QStringView(pattern).sliced(1)))
+            m_suffixes.append(pattern.sliced(1));
+        else
+            regexPatterns.append(QRegularExpression::wildcardToRegularExpression(pattern));
+    }
+
+    if (!regexPatterns.isEmpty())
+    {
+        m_regex = QRegularExpression(regexPatterns.join(u'|'), QRegularExpression::CaseInsensitiveOption);
+        m_regex.optimize();
+        m_hasRegex = true;
+    }
+}
+
+bool Utils::WildcardMatcher::isEmpty() const
+{
+    return m_names.isEmpty() && m_suffixes.isEmpty() && !m_hasRegex;
+}
+
+bool Utils::WildcardMatcher::match(const QStringView fileName) const
+{
+    for (const QString &suffix : m_suffixes)
+    {
+        if (fileName.endsWith(suffix, Qt::CaseInsensitive))
+            return true;
+    }
+
+    for (const QString &name : m_names)
+    {
+        if (fileName.compare(name, Qt::CaseInsensitive) == 0)
+            return true;
+    }
+
+    return m_hasRegex && m_regex.matchView(fileName).hasMatch();
+}
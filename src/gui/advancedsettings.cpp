@@ -110,6 +110,9 @@ namespace
         ENABLE_MARK_OF_THE_WEB,
 #endif // Q_OS_MACOS || Q_OS_WIN
         IGNORE_SSL_ERRORS,
+        DOWNLOAD_CONNECTIONS_PER_HOST,
+        DOWNLOAD_REQUEST_RATE_PER_HOST,
+        WEBUI_NETWORK_THREADS,
         PYTHON_EXECUTABLE_PATH,
         START_SESSION_PAUSED,
         SESSION_SHUTDOWN_TIMEOUT,
@@ -358,6 +361,12 @@ void AdvancedSettings::saveAdvancedSettings() const
 #endif // Q_OS_MACOS || Q_OS_WIN
     // Ignore SSL errors
     pref->setIgnoreSSLErrors(m_checkBoxIgnoreSSLErrors.isChecked());
+    // HTTP connections per host
+    pref->setDownloadConnectionsPerHost(m_spinBoxDownloadConnectionsPerHost.value());
+    // HTTP request rate per host
+    pref->setDownloadRequestRatePerHost(m_spinBoxDownloadRequestRatePerHost.value());
+    // WebUI network threads
+    pref->setWebUINetworkThreads(m_spinBoxWebUINetworkThreads.value());
     // Python executable path
     pref->setPythonExecutablePath(Path(m_pythonExecutablePath.text().trimmed()));
     // Start session paused
@@ -922,6 +931,28 @@ void AdvancedSettings::loadAdvancedSettings()
     m_checkBoxIgnoreSSLErrors.setChecked(pref->isIgnoreSSLErrors());
     m_checkBoxIgnoreSSLErrors.setToolTip(tr("Affects certificate validation and non-torrent protocol activities (e.g. RSS feeds, program updates, torrent files, geoip db, etc)"));
     addRow(IGNORE_SSL_ERRORS, tr("Ignore SSL errors"), &m_checkBoxIgnoreSSLErrors);
+    // HTTP connections per host
+    m_spinBoxDownloadConnectionsPerHost.setMinimum(0);
+    m_spinBoxDownloadConnectionsPerHost.setMaximum(100);
+    m_spinBoxDownloadConnectionsPerHost.setValue(pref->getDownloadConnectionsPerHost());
+    m_spinBoxDownloadConnectionsPerHost.setSpecialValueText(tr("0 (unlimited)"));
+    m_spinBoxDownloadConnectionsPerHost.setToolTip(tr("Affects non-torrent protocol activities (e.g. RSS feeds, program updates, torrent files, geoip db, etc)"));
+    addRow(DOWNLOAD_CONNECTIONS_PER_HOST, tr("Max concurrent HTTP connections per host [0: unlimited]"), &m_spinBoxDownloadConnectionsPerHost);
+    // HTTP request rate per host
+    m_spinBoxDownloadRequestRatePerHost.setMinimum(0);
+    m_spinBoxDownloadRequestRatePerHost.setMaximum(1000);
+    m_spinBoxDownloadRequestRatePerHost.setValue(pref->getDownloadRequestRatePerHost());
+    m_spinBoxDownloadRequestRatePerHost.setSuffix(tr(" req/s", " requests per second"));
+    m_spinBoxDownloadRequestRatePerHost.setSpecialValueText(tr("0 (unlimited)"));
+    m_spinBoxDownloadRequestRatePerHost.setToolTip(tr("Limits background requests only (e.g. RSS feeds, favicons, geoip db)"));
+    addRow(DOWNLOAD_REQUEST_RATE_PER_HOST, tr("Max background HTTP request rate per host [0: unlimited]"), &m_spinBoxDownloadRequestRatePerHost);
+    // WebUI network threads
+    m_spinBoxWebUINetworkThreads.setMinimum(0);
+    m_spinBoxWebUINetworkThreads.setMaximum(64);
+    m_spinBoxWebUINetworkThreads.setValue(pref->getWebUINetworkThreads());
+    m_spinBoxWebUINetworkThreads.setSpecialValueText(tr("0 (main thread)"));
+    m_spinBoxWebUINetworkThreads.setToolTip(tr("Threads used by WebUI server to handle connections, TLS, request parsing and response compression"));
+    addRow(WEBUI_NETWORK_THREADS, tr("WebUI network threads (requires restart)"), &m_spinBoxWebUINetworkThreads);
     // Python executable path
     m_pythonExecutablePath.setPlaceholderText(tr("(Auto detect if empty)"));
     m_pythonExecutablePath.setText(pref->getPythonExecutablePath().toString());
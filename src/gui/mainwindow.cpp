@@ -1949,7 +1949,7 @@ void MainWindow::installPython()
     setCursor(Qt::WaitCursor);
     // Download python
     Net::DownloadManager::instance()->download(
-            Net::DownloadRequest(PYTHON_INSTALLER_URL).saveToFile(true)
+            Net::DownloadRequest(PYTHON_INSTALLER_URL).saveToFile(true).useCache(false)
             , Preferences::instance()->useProxyForGeneralPurposes()
             , this, &MainWindow::pythonDownloadFinished);
 }
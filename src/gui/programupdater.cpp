@@ -94,13 +94,13 @@ void ProgramUpdater::checkForUpdates()
     const bool useProxy = Preferences::instance()->useProxyForGeneralPurposes();
 
     m_pendingRequestCount = 3;
-    netManager->download(Net::DownloadRequest(FOSSHUB_URL).userAgent(USER_AGENT), useProxy, this, &ProgramUpdater::rssDownloadFinished);
+    netManager->download(Net::DownloadRequest(FOSSHUB_URL).userAgent(USER_AGENT).useCache(false), useProxy, this, &ProgramUpdater::rssDownloadFinished);
     // don't use the custom user agent for the following requests, disguise as a normal browser instead
-    netManager->download(Net::DownloadRequest(QBT_MAIN_URL), useProxy, this, [this](const Net::DownloadResult &result)
+    netManager->download(Net::DownloadRequest(QBT_MAIN_URL).useCache(false), useProxy, this, [this](const Net::DownloadResult &result)
     {
         fallbackDownloadFinished(result, m_qbtMainVersion);
     });
-    netManager->download(Net::DownloadRequest(QBT_BACKUP_URL), useProxy, this, [this](const Net::DownloadResult &result)
+    netManager->download(Net::DownloadRequest(QBT_BACKUP_URL).useCache(false), useProxy, this, [this](const Net::DownloadResult &result)
     {
         fallbackDownloadFinished(result, m_qbtBackupVersion);
     });
@@ -30,6 +30,8 @@
 
 #include "piecesbar.h"
 
+#include <span>
+
 #include <QApplication>
 #include <QDebug>
 #include <QHelpEvent>
@@ -284,17 +286,17 @@ void PiecesBar::showToolTip(const QHelpEvent *e)
         {
             const PieceIndexToImagePos transform {torrentInfo, m_image};
             const int pieceIndex = transform.pieceIndex(imagePos);
-            const QList<int> fileIndexes = torrentInfo.fileIndicesForPiece(pieceIndex);
+            const std::span<const int> fileIndexes = torrentInfo.pieceFileIndexes(pieceIndex);
 
             QString tooltipTitle;
-            if (fileIndexes.count() > 1)
+            if (fileIndexes.size() > 1)
                 tooltipTitle = tr("Files in this piece:");
             else if (torrentInfo.fileSize(fileIndexes.front()) == torrentInfo.pieceLength(pieceIndex))
                 tooltipTitle = tr("File in this piece:");
             else
                 tooltipTitle = tr("File in these pieces:");
 
-            toolTipText.reserve(fileIndexes.size() * 128);
+            toolTipText.reserve(static_cast<qsizetype>(fileIndexes.size()) * 128);
             toolTipText += u"<html><body>";
 
             DetailedTooltipRenderer renderer {toolTipText, tooltipTitle};
@@ -328,10 +330,10 @@ void PiecesBar::highlightFile(int imagePos)
     PieceIndexToImagePos transform {torrentInfo, m_image};
 
     int pieceIndex = transform.pieceIndex(imagePos);
-    QList<int> fileIndices {torrentInfo.fileIndicesForPiece(pieceIndex)};
-    if (fileIndices.count() == 1)
+    const std::span<const int> fileIndices = torrentInfo.pieceFileIndexes(pieceIndex);
+    if (fileIndices.size() == 1)
     {
-        BitTorrent::TorrentInfo::PieceRange filePieces = torrentInfo.filePieces(fileIndices.first());
+        BitTorrent::TorrentInfo::PieceRange filePieces = torrentInfo.filePieces(fileIndices.front());
 
         ImageRange imageRange = transform.imagePos(filePieces);
         QRect newHighlightedRegion {imageRange.first(), 0, imageRange.size(), m_image.height()};
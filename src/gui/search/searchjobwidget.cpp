@@ -36,8 +36,6 @@
 #include <QKeyEvent>
 #include <QMenu>
 #include <QMessageBox>
-#include <QPalette>
-#include <QStandardItemModel>
 #include <QUrl>
 
 #include "base/logger.h"
@@ -49,21 +47,12 @@
 #include "gui/interfaces/iguiapplication.h"
 #include "gui/lineedit.h"
 #include "gui/uithememanager.h"
+#include "searchresultsmodel.h"
 #include "searchsortmodel.h"
 #include "ui_searchjobwidget.h"
 
 namespace
 {
-    enum DataRole
-    {
-        LinkVisitedRole = Qt::UserRole + 100
-    };
-
-    QColor visitedRowColor()
-    {
-        return QApplication::palette().color(QPalette::Disabled, QPalette::WindowText);
-    }
-
     QString statusText(const SearchJobWidget::Status st)
     {
         switch (st)
@@ -104,18 +93,7 @@ SearchJobWidget::SearchJobWidget(const QString &id, IGUIApplication *app, QWidge
     fillFilterComboBoxes();
 
     // Set Search results list model
-    m_searchListModel = new QStandardItemModel(0, SearchSortModel::NB_SEARCH_COLUMNS, this);
-    m_searchListModel->setHeaderData(SearchSortModel::NAME, Qt::Horizontal, tr("Name", "i.e: file name"));
-    m_searchListModel->setHeaderData(SearchSortModel::SIZE, Qt::Horizontal, tr("Size", "i.e: file size"));
-    m_searchListModel->setHeaderData(SearchSortModel::SEEDS, Qt::Horizontal, tr("Seeders", "i.e: Number of full sources"));
-    m_searchListModel->setHeaderData(SearchSortModel::LEECHES, Qt::Horizontal, tr("Leechers", "i.e: Number of partial sources"));
-    m_searchListModel->setHeaderData(SearchSortModel::ENGINE_NAME, Qt::Horizontal, tr("Engine"));
-    m_searchListModel->setHeaderData(SearchSortModel::ENGINE_URL, Qt::Horizontal, tr("Engine URL"));
-    m_searchListModel->setHeaderData(SearchSortModel::PUB_DATE, Qt::Horizontal, tr("Published On"));
-    // Set columns text alignment
-    m_searchListModel->setHeaderData(SearchSortModel::SIZE, Qt::Horizontal, QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
-    m_searchListModel->setHeaderData(SearchSortModel::SEEDS, Qt::Horizontal, QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
-    m_searchListModel->setHeaderData(SearchSortModel::LEECHES, Qt::Horizontal, QVariant(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    m_searchListModel = new SearchResultsModel(this);
 
     m_proxyModel = new SearchSortModel(this);
     m_proxyModel->setDynamicSortFilter(true);
@@ -125,6 +103,10 @@ SearchJobWidget::SearchJobWidget(const QString &id, IGUIApplication *app, QWidge
     m_proxyModel->setSizeFilter(sizeInBytes(m_ui->minSize->value(), static_cast<SizeUnit>(m_ui->minSizeUnit->currentIndex()))
         , sizeInBytes(m_ui->maxSize->value(), static_cast<SizeUnit>(m_ui->maxSizeUnit->currentIndex())));
 
+    // should be connected after the proxy model so it is already updated by the time the count is refreshed
+    connect(m_searchListModel, &QAbstractItemModel::rowsInserted, this, &SearchJobWidget::updateResultsCount);
+    connect(m_searchListModel, &QAbstractItemModel::modelReset, this, &SearchJobWidget::updateResultsCount);
+
     updateResultsCount();
 
     m_ui->resultsBrowser->setModel(m_proxyModel);
@@ -196,7 +178,7 @@ SearchJobWidget::SearchJobWidget(const QString &id, const QString &searchPattern
     m_searchPattern = searchPattern;
     m_proxyModel->setNameFilter(m_searchPattern);
 
-    appendSearchResults(searchResults);
+    m_searchListModel->setResults(searchResults);
 }
 
 SearchJobWidget::SearchJobWidget(const QString &id, SearchHandler *searchHandler, IGUIApplication *app, QWidget *parent)
@@ -223,7 +205,7 @@ QString SearchJobWidget::searchPattern() const
 
 QList<SearchResult> SearchJobWidget::searchResults() const
 {
-    return m_searchResults;
+    return m_searchListModel->results();
 }
 
 void SearchJobWidget::onItemDoubleClicked(const QModelIndex &index)
@@ -236,36 +218,14 @@ QHeaderView *SearchJobWidget::header() const
     return m_ui->resultsBrowser->header();
 }
 
-// Set the color of a row in data model
-void SearchJobWidget::setRowColor(int row, const QColor &color)
-{
-    for (int i = 0; i < m_proxyModel->columnCount(); ++i)
-        m_proxyModel->setData(m_proxyModel->index(row, i), color, Qt::ForegroundRole);
-}
-
 void SearchJobWidget::setRowVisited(const int row)
 {
-    m_proxyModel->setDynamicSortFilter(false);
-
-    m_proxyModel->setData(m_proxyModel->index(row, 0), true, LinkVisitedRole);
-    setRowColor(row, visitedRowColor());
-
-    m_proxyModel->setDynamicSortFilter(true);
+    m_searchListModel->setRowVisited(m_proxyModel->mapToSource(m_proxyModel->index(row, 0)).row());
 }
 
 void SearchJobWidget::onUIThemeChanged()
 {
-    m_proxyModel->setDynamicSortFilter(false);
-
-    for (int row = 0; row < m_proxyModel->rowCount(); ++row)
-    {
-        const QVariant userData = m_proxyModel->data(m_proxyModel->index(row, 0), LinkVisitedRole);
-        const bool isVisited = userData.toBool();
-        if (isVisited)
-            setRowColor(row, visitedRowColor());
-    }
-
-    m_proxyModel->setDynamicSortFilter(true);
+    m_searchListModel->refreshVisitedRows();
 }
 
 SearchJobWidget::Status SearchJobWidget::status() const
@@ -289,13 +249,11 @@ void SearchJobWidget::assignSearchHandler(SearchHandler *searchHandler)
     if (!searchHandler) [[unlikely]]
         return;
 
-    m_searchResults.clear();
-    m_searchListModel->removeRows(0, m_searchListModel->rowCount());
+    m_searchListModel->setSearchHandler(searchHandler);
     delete m_searchHandler;
 
     m_searchHandler = searchHandler;
     m_searchHandler->setParent(this);
-    connect(m_searchHandler, &SearchHandler::newSearchResults, this, &SearchJobWidget::appendSearchResults);
     connect(m_searchHandler, &SearchHandler::searchFinished, this, &SearchJobWidget::searchFinished);
     connect(m_searchHandler, &SearchHandler::searchFailed, this, &SearchJobWidget::searchFailed);
 
@@ -643,41 +601,6 @@ void SearchJobWidget::searchFailed([[maybe_unused]] const QString &errorMessage)
     setStatus(Status::Error);
 }
 
-void SearchJobWidget::appendSearchResults(const QList<SearchResult> &results)
-{
-    for (const SearchResult &result : results)
-    {
-        // Add item to search result list
-        int row = m_searchListModel->rowCount();
-        m_searchListModel->insertRow(row);
-
-        const auto setModelData = [this, row] (const int column, const QString &displayData
-                , const QVariant &underlyingData, const Qt::Alignment textAlignmentData = {})
-        {
-            const QMap<int, QVariant> data =
-            {
-                {Qt::DisplayRole, displayData},
-                {SearchSortModel::UnderlyingDataRole, underlyingData},
-                {Qt::TextAlignmentRole, QVariant {textAlignmentData}}
-            };
-            m_searchListModel->setItemData(m_searchListModel->index(row, column), data);
-        };
-
-        setModelData(SearchSortModel::NAME, result.fileName, result.fileName);
-        setModelData(SearchSortModel::DL_LINK, result.fileUrl, result.fileUrl);
-        setModelData(SearchSortModel::ENGINE_NAME, result.engineName, result.engineName);
-        setModelData(SearchSortModel::ENGINE_URL, result.siteUrl, result.siteUrl);
-        setModelData(SearchSortModel::DESC_LINK, result.descrLink, result.descrLink);
-        setModelData(SearchSortModel::SIZE, Utils::Misc::friendlyUnit(result.fileSize), result.fileSize, (Qt::AlignRight | Qt::AlignVCenter));
-        setModelData(SearchSortModel::SEEDS, QString::number(result.nbSeeders), result.nbSeeders, (Qt::AlignRight | Qt::AlignVCenter));
-        setModelData(SearchSortModel::LEECHES, QString::number(result.nbLeechers), result.nbLeechers, (Qt::AlignRight | Qt::AlignVCenter));
-        setModelData(SearchSortModel::PUB_DATE, QLocale().toString(result.pubDate.toLocalTime(), QLocale::ShortFormat), result.pubDate);
-    }
-
-    m_searchResults.append(results);
-    updateResultsCount();
-}
-
 void SearchJobWidget::keyPressEvent(QKeyEvent *event)
 {
     switch (event->key())
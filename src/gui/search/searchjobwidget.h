@@ -40,10 +40,10 @@
 
 class QHeaderView;
 class QModelIndex;
-class QStandardItemModel;
 
 class LineEdit;
 class SearchHandler;
+class SearchResultsModel;
 class SearchSortModel;
 struct SearchResult;
 
@@ -115,7 +115,6 @@ private:
     void onItemDoubleClicked(const QModelIndex &index);
     void searchFinished(bool cancelled);
     void searchFailed(const QString &errorMessage);
-    void appendSearchResults(const QList<SearchResult> &results);
     void updateResultsCount();
     void setStatus(Status value);
     void downloadTorrent(const QModelIndex &rowIndex, AddTorrentOption option = AddTorrentOption::Default);
@@ -123,7 +122,6 @@ private:
     void fillFilterComboBoxes();
     QHeaderView *header() const;
     int visibleColumnsCount() const;
-    void setRowColor(int row, const QColor &color);
     void setRowVisited(int row);
     void onUIThemeChanged();
 
@@ -138,10 +136,9 @@ private:
 
     QString m_id;
     QString m_searchPattern;
-    QList<SearchResult> m_searchResults;
     Ui::SearchJobWidget *m_ui = nullptr;
     SearchHandler *m_searchHandler = nullptr;
-    QStandardItemModel *m_searchListModel = nullptr;
+    SearchResultsModel *m_searchListModel = nullptr;
     SearchSortModel *m_proxyModel = nullptr;
     LineEdit *m_lineEditSearchResultsFilter = nullptr;
     Status m_status = Status::Ready;
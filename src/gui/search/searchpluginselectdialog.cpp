@@ -312,7 +312,7 @@ void SearchPluginSelectDialog::addNewPlugin(const QString &pluginName)
         // Icon is missing, we must download it
         using namespace Net;
         DownloadManager::instance()->download(
-                DownloadRequest(plugin->url + u"/favicon.ico").saveToFile(true)
+                DownloadRequest(plugin->url + u"/favicon.ico").saveToFile(true).priority(RequestPriority::Background)
                 , Preferences::instance()->useProxyForGeneralPurposes(), this, &SearchPluginSelectDialog::iconDownloadFinished);
     }
     item->setText(PLUGIN_VERSION, plugin->version.toString());
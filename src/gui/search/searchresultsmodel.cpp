@@ -0,0 +1,274 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#include "searchresultsmodel.h"
+
+#include <chrono>
+
+#include <QApplication>
+#include <QColor>
+#include <QLocale>
+#include <QPalette>
+#include <QTimer>
+
+#include "base/utils/misc.h"
+#include "searchsortmodel.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Results which arrive more often than this are inserted in a single batch
+    const auto INSERT_INTERVAL = 250ms;
+
+    QColor visitedRowColor()
+    {
+        return QApplication::palette().color(QPalette::Disabled, QPalette::WindowText);
+    }
+}
+
+SearchResultsModel::SearchResultsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_insertTimer {new QTimer(this)}
+{
+    m_insertTimer->setSingleShot(true);
+    m_insertTimer->setInterval(INSERT_INTERVAL);
+    connect(m_insertTimer, &QTimer::timeout, this, [this]
+    {
+        if (insertPendingResults())
+            m_insertTimer->start();
+    });
+}
+
+const QList<SearchResult> &SearchResultsModel::results() const
+{
+    return m_searchHandler ? m_searchHandler->results() : m_results;
+}
+
+void SearchResultsModel::setResults(const QList<SearchResult> &results)
+{
+    beginResetModel();
+
+    if (m_searchHandler)
+        m_searchHandler->disconnect(this);
+    m_searchHandler = nullptr;
+    m_insertTimer->stop();
+
+    m_results = results;
+    m_rowCount = m_results.size();
+    m_visitedRows.clear();
+
+    endResetModel();
+}
+
+void SearchResultsModel::setSearchHandler(SearchHandler *searchHandler)
+{
+    beginResetModel();
+
+    if (m_searchHandler)
+        m_searchHandler->disconnect(this);
+    m_searchHandler = searchHandler;
+    m_insertTimer->stop();
+
+    m_results.clear();
+    m_rowCount = 0;
+    m_visitedRows.clear();
+
+    endResetModel();
+
+    if (!m_searchHandler)
+        return;
+
+    connect(m_searchHandler, &SearchHandler::newSearchResults, this, &SearchResultsModel::handleNewSearchResults);
+    // make sure all the results are visible by the time the search is reported as finished
+    connect(m_searchHandler, &SearchHandler::searchFinished, this, &SearchResultsModel::insertPendingResults);
+    connect(m_searchHandler, &SearchHandler::searchFailed, this, &SearchResultsModel::insertPendingResults);
+
+    insertPendingResults();
+}
+
+bool SearchResultsModel::isRowVisited(const int row) const
+{
+    return m_visitedRows.contains(row);
+}
+
+void SearchResultsModel::setRowVisited(const int row)
+{
+    if ((row < 0) || (row >= m_rowCount))
+        return;
+
+    if (m_visitedRows.contains(row))
+        return;
+
+    m_visitedRows.insert(row);
+    emit dataChanged(index(row, 0), index(row, (columnCount() - 1)), {Qt::ForegroundRole});
+}
+
+void SearchResultsModel::refreshVisitedRows()
+{
+    if (!m_visitedRows.isEmpty())
+        emit dataChanged(index(0, 0), index((m_rowCount - 1), (columnCount() - 1)), {Qt::ForegroundRole});
+}
+
+int SearchResultsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int SearchResultsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : SearchSortModel::NB_SEARCH_COLUMNS;
+}
+
+QVariant SearchResultsModel::data(const QModelIndex &index, const int role) const
+{
+    const QList<SearchResult> &results = this->results();
+    if (!index.isValid() || (index.row() >= m_rowCount) || (index.row() >= results.size()))
+        return {};
+
+    const SearchResult &result = results[index.row()];
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        switch (index.column())
+        {
+        case SearchSortModel::SIZE:
+            return Utils::Misc::friendlyUnit(result.fileSize);
+        case SearchSortModel::SEEDS:
+            return QString::number(result.nbSeeders);
+        case SearchSortModel::LEECHES:
+            return QString::number(result.nbLeechers);
+        case SearchSortModel::PUB_DATE:
+            return QLocale().toString(result.pubDate.toLocalTime(), QLocale::ShortFormat);
+        default:
+            return data(index, SearchSortModel::UnderlyingDataRole);
+        }
+    case SearchSortModel::UnderlyingDataRole:
+        switch (index.column())
+        {
+        case SearchSortModel::NAME:
+            return result.fileName;
+        case SearchSortModel::SIZE:
+            return result.fileSize;
+        case SearchSortModel::SEEDS:
+            return result.nbSeeders;
+        case SearchSortModel::LEECHES:
+            return result.nbLeechers;
+        case SearchSortModel::ENGINE_NAME:
+            return result.engineName;
+        case SearchSortModel::ENGINE_URL:
+            return result.siteUrl;
+        case SearchSortModel::PUB_DATE:
+            return result.pubDate;
+        case SearchSortModel::DL_LINK:
+            return result.fileUrl;
+        case SearchSortModel::DESC_LINK:
+            return result.descrLink;
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        switch (index.column())
+        {
+        case SearchSortModel::SIZE:
+        case SearchSortModel::SEEDS:
+        case SearchSortModel::LEECHES:
+            return QVariant {Qt::AlignRight | Qt::AlignVCenter};
+        }
+        break;
+    case Qt::ForegroundRole:
+        if (m_visitedRows.contains(index.row()))
+            return visitedRowColor();
+        break;
+    }
+
+    return {};
+}
+
+QVariant SearchResultsModel::headerData(const int section, const Qt::Orientation orientation, const int role) const
+{
+    if (orientation != Qt::Horizontal)
+        return {};
+
+    if (role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+        case SearchSortModel::NAME:
+            return tr("Name", "i.e: file name");
+        case SearchSortModel::SIZE:
+            return tr("Size", "i.e: file size");
+        case SearchSortModel::SEEDS:
+            return tr("Seeders", "i.e: Number of full sources");
+        case SearchSortModel::LEECHES:
+            return tr("Leechers", "i.e: Number of partial sources");
+        case SearchSortModel::ENGINE_NAME:
+            return tr("Engine");
+        case SearchSortModel::ENGINE_URL:
+            return tr("Engine URL");
+        case SearchSortModel::PUB_DATE:
+            return tr("Published On");
+        }
+    }
+    else if (role == Qt::TextAlignmentRole)
+    {
+        switch (section)
+        {
+        case SearchSortModel::SIZE:
+        case SearchSortModel::SEEDS:
+        case SearchSortModel::LEECHES:
+            return QVariant {Qt::AlignRight | Qt::AlignVCenter};
+        }
+    }
+
+    return {};
+}
+
+void SearchResultsModel::handleNewSearchResults()
+{
+    // Throttle row insertion so that a flood of results produces
+    // a few big insertions instead of lots of tiny ones
+    if (m_insertTimer->isActive())
+        return;
+
+    if (insertPendingResults())
+        m_insertTimer->start();
+}
+
+bool SearchResultsModel::insertPendingResults()
+{
+    const int resultsCount = results().size();
+    if (resultsCount <= m_rowCount)
+        return false;
+
+    beginInsertRows({}, m_rowCount, (resultsCount - 1));
+    m_rowCount = resultsCount;
+    endInsertRows();
+    return true;
+}
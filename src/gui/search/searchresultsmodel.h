@@ -0,0 +1,74 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QPointer>
+#include <QSet>
+
+#include "base/search/searchhandler.h"
+
+class QTimer;
+
+class SearchResultsModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(SearchResultsModel)
+
+public:
+    explicit SearchResultsModel(QObject *parent = nullptr);
+
+    // Results are read directly from the search handler while it is assigned,
+    // otherwise the model holds its own (e.g. restored) results
+    const QList<SearchResult> &results() const;
+    void setResults(const QList<SearchResult> &results);
+    void setSearchHandler(SearchHandler *searchHandler);
+
+    bool isRowVisited(int row) const;
+    void setRowVisited(int row);
+    void refreshVisitedRows();
+
+    int rowCount(const QModelIndex &parent = {}) const override;
+    int columnCount(const QModelIndex &parent = {}) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    void handleNewSearchResults();
+    bool insertPendingResults();
+
+    QPointer<SearchHandler> m_searchHandler;
+    QList<SearchResult> m_results;
+    // number of results exposed to the views, the search handler may already have more of them
+    int m_rowCount = 0;
+    QSet<int> m_visitedRows;
+    QTimer *m_insertTimer = nullptr;
+};
@@ -167,7 +167,8 @@ namespace
 
 TorrentContentModel::TorrentContentModel(QObject *parent)
     : QAbstractItemModel(parent)
-    , m_rootItem {new TorrentContentModelFolder(QList<QString>({ tr("Name"), tr("Total Size"), tr("Progress"), tr("Download Priority"), tr("Remaining"), tr("Availability") }))}
+    , m_rootItem {new TorrentContentModelFolder}
+    , m_headerLabels {tr("Name"), tr("Total Size"), tr("Progress"), tr("Download Priority"), tr("Remaining"), tr("Availability")}
 #if defined(Q_OS_WIN)
     , m_fileIconProvider {new QFileIconProvider}
 #elif defined(Q_OS_MACOS)
@@ -182,6 +183,7 @@ TorrentContentModel::TorrentContentModel(QObject *parent)
 TorrentContentModel::~TorrentContentModel()
 {
     delete m_fileIconProvider;
+    // Folders must be destroyed before the file items they refer to
     delete m_rootItem;
 }
 
@@ -190,16 +192,15 @@ void TorrentContentModel::updateFilesProgress()
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
     const QList<qreal> &filesProgress = m_contentHandler->filesProgress();
-    Q_ASSERT(m_filesIndex.size() == filesProgress.size());
+    Q_ASSERT(m_files.size() == static_cast<std::size_t>(filesProgress.size()));
     // XXX: Why is this necessary?
-    if (m_filesIndex.size() != filesProgress.size()) [[unlikely]]
+    if (m_files.size() != static_cast<std::size_t>(filesProgress.size())) [[unlikely]]
         return;
 
     for (qsizetype i = 0; i < filesProgress.size(); ++i)
-        m_filesIndex[i]->setProgress(filesProgress[i]);
+        m_files[i].setProgress(filesProgress[i]);
     // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    m_rootItem->recalculateAvailability();
+    m_rootItem->recalculate();
 }
 
 void TorrentContentModel::updateFilesPriorities()
@@ -207,13 +208,13 @@ void TorrentContentModel::updateFilesPriorities()
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
 
     const QList<BitTorrent::DownloadPriority> fprio = m_contentHandler->filePriorities();
-    Q_ASSERT(m_filesIndex.size() == fprio.size());
+    Q_ASSERT(m_files.size() == static_cast<std::size_t>(fprio.size()));
     // XXX: Why is this necessary?
-    if (m_filesIndex.size() != fprio.size())
+    if (m_files.size() != static_cast<std::size_t>(fprio.size()))
         return;
 
     for (qsizetype i = 0; i < fprio.size(); ++i)
-        m_filesIndex[i]->setPriority(static_cast<BitTorrent::DownloadPriority>(fprio[i]));
+        m_files[i].setPriority(static_cast<BitTorrent::DownloadPriority>(fprio[i]));
 }
 
 void TorrentContentModel::updateFilesAvailability()
@@ -226,10 +227,10 @@ void TorrentContentModel::updateFilesAvailability()
         if (!m_contentHandler || (m_contentHandler != handler))
             return;
 
-        for (qsizetype i = 0; i < m_filesIndex.size(); ++i)
-            m_filesIndex[i]->setAvailability(availableFileFractions.value(i, 0));
-        // Update folders progress in the tree
-        m_rootItem->recalculateProgress();
+        for (std::size_t i = 0; i < m_files.size(); ++i)
+            m_files[i].setAvailability(availableFileFractions.value(static_cast<qsizetype>(i), 0));
+        // Update folders availability in the tree
+        m_rootItem->recalculate();
     });
 }
 
@@ -246,8 +247,7 @@ bool TorrentContentModel::setItemPriority(const QModelIndex &index, BitTorrent::
     m_contentHandler->prioritizeFiles(getFilePriorities());
 
     // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    m_rootItem->recalculateAvailability();
+    m_rootItem->recalculate();
 
     const QList<ColumnInterval> columns =
     {
@@ -262,9 +262,9 @@ bool TorrentContentModel::setItemPriority(const QModelIndex &index, BitTorrent::
 QList<BitTorrent::DownloadPriority> TorrentContentModel::getFilePriorities() const
 {
     QList<BitTorrent::DownloadPriority> prio;
-    prio.reserve(m_filesIndex.size());
-    for (const TorrentContentModelFile *file : asConst(m_filesIndex))
-        prio.push_back(file->priority());
+    prio.reserve(static_cast<qsizetype>(m_files.size()));
+    for (const TorrentContentModelFile &file : m_files)
+        prio.push_back(file.priority());
     return prio;
 }
 
@@ -477,7 +477,7 @@ QVariant TorrentContentModel::headerData(int section, Qt::Orientation orientatio
     switch (role)
     {
     case Qt::DisplayRole:
-        return m_rootItem->displayData(section);
+        return m_headerLabels.value(section);
 
     case Qt::TextAlignmentRole:
         if ((section == TorrentContentModelItem::COL_SIZE)
@@ -609,7 +609,6 @@ void TorrentContentModel::populate()
         return;
 
     const int filesCount = m_contentHandler->filesCount();
-    m_filesIndex.reserve(filesCount);
 
     TorrentContentModelFolder *lastParentFolderItem = m_rootItem;
     // Iterate over files
@@ -627,9 +626,8 @@ void TorrentContentModel::populate()
         }
 
         // Actually create the file
-        auto *fileItem = new TorrentContentModelFile(filePath.filename(), m_contentHandler->fileSize(i), i);
+        auto *fileItem = &m_files.emplace_back(filePath.filename(), m_contentHandler->fileSize(i), i);
         lastParentFolderItem->appendChild(fileItem);
-        m_filesIndex.push_back(fileItem);
         m_itemByPath.insert(filePath, fileItem);
     }
 
@@ -709,7 +707,7 @@ void TorrentContentModel::onMetadataReceived()
 void TorrentContentModel::onFileRenamed(const int fileIndex, const Path &oldFilePath)
 {
     const Path newFilePath = m_contentHandler->filePath(fileIndex);
-    TorrentContentModelFile *fileItem = m_filesIndex.at(fileIndex);
+    TorrentContentModelFile *fileItem = &m_files.at(fileIndex);
     fileItem->setName(newFilePath.filename());
     if (newFilePath.parentPath() == oldFilePath.parentPath())
     {
@@ -797,9 +795,9 @@ void TorrentContentModel::setContentHandler(BitTorrent::TorrentContentHandler *c
     if (m_contentHandler)
     {
         m_contentHandler->disconnect(this);
-        m_filesIndex.clear();
         m_itemByPath.clear();
         m_rootItem->deleteAllChildren();
+        m_files.clear();
     }
 
     m_contentHandler = contentHandler;
@@ -833,7 +831,7 @@ BitTorrent::TorrentContentHandler *TorrentContentModel::contentHandler() const
 
 void TorrentContentModel::refresh()
 {
-    if (m_filesIndex.isEmpty())
+    if (m_files.empty())
         return;
 
     Q_ASSERT(m_contentHandler && m_contentHandler->hasMetadata());
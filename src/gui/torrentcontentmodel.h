@@ -29,12 +29,16 @@
 
 #pragma once
 
+#include <deque>
+
 #include <QtContainerFwd>
 #include <QAbstractItemModel>
 #include <QList>
+#include <QStringList>
 
 #include "base/indexrange.h"
 #include "base/pathfwd.h"
+#include "torrentcontentmodelfile.h"
 #include "torrentcontentmodelitem.h"
 
 class QFileIconProvider;
@@ -42,8 +46,6 @@ class QMimeData;
 class QModelIndex;
 class QVariant;
 
-class TorrentContentModelFile;
-
 namespace BitTorrent
 {
     class TorrentContentHandler;
@@ -118,7 +120,9 @@ private:
 
     BitTorrent::TorrentContentHandler *m_contentHandler = nullptr;
     TorrentContentModelFolder *m_rootItem = nullptr;
-    QList<TorrentContentModelFile *> m_filesIndex;
+    QStringList m_headerLabels;
+    // File items are kept in a chunked arena so their addresses stay stable
+    std::deque<TorrentContentModelFile> m_files;
     QHash<Path, TorrentContentModelItem *> m_itemByPath;
     QFileIconProvider *m_fileIconProvider = nullptr;
 };
@@ -52,23 +52,32 @@ void TorrentContentModelFile::setPriority(BitTorrent::DownloadPriority newPriori
         return;
 
     m_priority = newPriority;
+    parent()->markDirty();
 
     // Update parent
     if (updateParent)
         parent()->updatePriority();
 }
 
-void TorrentContentModelFile::setProgress(qreal progress)
+void TorrentContentModelFile::setProgress(const qreal progress)
 {
+    if (m_progress == progress)
+        return;
+
     m_progress = progress;
     m_remaining = static_cast<qulonglong>(m_size * (1.0 - m_progress));
     Q_ASSERT(m_progress <= 1.);
+    parent()->markDirty();
 }
 
 void TorrentContentModelFile::setAvailability(const qreal availability)
 {
+    if (m_availability == availability)
+        return;
+
     m_availability = availability;
     Q_ASSERT(m_availability <= 1.);
+    parent()->markDirty();
 }
 
 TorrentContentModelItem::ItemType TorrentContentModelFile::itemType() const
@@ -33,20 +33,20 @@
 
 #include "base/global.h"
 
+TorrentContentModelFolder::TorrentContentModelFolder() = default;
+
 TorrentContentModelFolder::TorrentContentModelFolder(const QString &name)
 {
     m_name = name;
 }
 
-TorrentContentModelFolder::TorrentContentModelFolder(const QList<QString> &data)
-{
-    Q_ASSERT(data.size() == NB_COL);
-    m_itemData = data;
-}
-
 TorrentContentModelFolder::~TorrentContentModelFolder()
 {
-    qDeleteAll(m_childItems);
+    for (TorrentContentModelItem *child : asConst(m_childItems))
+    {
+        if (child->itemType() == FolderType)
+            delete child;
+    }
 }
 
 TorrentContentModelItem::ItemType TorrentContentModelFolder::itemType() const
@@ -57,8 +57,13 @@ TorrentContentModelItem::ItemType TorrentContentModelFolder::itemType() const
 void TorrentContentModelFolder::deleteAllChildren()
 {
     Q_ASSERT(isRootItem());
-    qDeleteAll(m_childItems);
+    for (TorrentContentModelItem *child : asConst(m_childItems))
+    {
+        if (child->itemType() == FolderType)
+            delete child;
+    }
     m_childItems.clear();
+    m_isDirty = true;
 }
 
 const QList<TorrentContentModelItem *> &TorrentContentModelFolder::children() const
@@ -72,11 +77,13 @@ void TorrentContentModelFolder::appendChild(TorrentContentModelItem *item)
     if (!item) [[unlikely]]
         return;
 
+    item->m_row = static_cast<int>(m_childItems.size());
     m_childItems.append(item);
     item->m_parentItem = this;
     // Update own size
     if (item->itemType() == FileType)
         increaseSize(item->size());
+    markDirty();
 }
 
 void TorrentContentModelFolder::removeChild(TorrentContentModelItem *item)
@@ -85,13 +92,20 @@ void TorrentContentModelFolder::removeChild(TorrentContentModelItem *item)
     if (!item) [[unlikely]]
         return;
 
-    if (m_childItems.removeOne(item))
-    {
-        // Update own size
-        if (item->itemType() == FileType)
-            decreaseSize(item->size());
-        item->m_parentItem = nullptr;
-    }
+    Q_ASSERT(item->m_parentItem == this);
+    if (item->m_parentItem != this) [[unlikely]]
+        return;
+
+    m_childItems.removeAt(item->m_row);
+    for (int row = item->m_row; row < m_childItems.size(); ++row)
+        m_childItems[row]->m_row = row;
+
+    // Update own size
+    if (item->itemType() == FileType)
+        decreaseSize(item->size());
+    item->m_parentItem = nullptr;
+    item->m_row = 0;
+    markDirty();
 }
 
 TorrentContentModelItem *TorrentContentModelFolder::child(const int row) const
@@ -136,6 +150,8 @@ void TorrentContentModelFolder::setPriority(BitTorrent::DownloadPriority newPrio
         return;
 
     m_priority = newPriority;
+    // Parent progress depends on whether this folder is ignored
+    m_parentItem->markDirty();
 
     // Update parent priority
     if (updateParent)
@@ -149,62 +165,62 @@ void TorrentContentModelFolder::setPriority(BitTorrent::DownloadPriority newPrio
     }
 }
 
-void TorrentContentModelFolder::recalculateProgress()
+void TorrentContentModelFolder::markDirty()
 {
+    // Ancestors of an outdated folder are always outdated as well
+    for (TorrentContentModelFolder *folder = this; folder && !folder->m_isDirty; folder = folder->parent())
+        folder->m_isDirty = true;
+}
+
+void TorrentContentModelFolder::recalculate()
+{
+    if (!m_isDirty)
+        return;
+
     qreal tProgress = 0;
+    qreal tAvailability = 0;
     qulonglong tSize = 0;
     qulonglong tRemaining = 0;
+    bool foundAnyData = false;
     for (TorrentContentModelItem *child : asConst(m_childItems))
     {
+        // Child folders are recalculated even when ignored so the whole subtree becomes up to date
+        if (child->itemType() == FolderType)
+            static_cast<TorrentContentModelFolder *>(child)->recalculate();
+
         if (child->priority() == BitTorrent::DownloadPriority::Ignored)
             continue;
 
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder *>(child)->recalculateProgress();
         tProgress += child->progress() * child->size();
         tSize += child->size();
         tRemaining += child->remaining();
-    }
 
-    if (!isRootItem())
-    {
-        if (tSize > 0)
-        {
-            m_progress = tProgress / tSize;
-            m_remaining = tRemaining;
-        }
-        else
-        {
-            m_progress = 1.0;
-            m_remaining = 0;
-        }
-
-        Q_ASSERT(m_progress <= 1.);
-    }
-}
-
-void TorrentContentModelFolder::recalculateAvailability()
-{
-    qreal tAvailability = 0;
-    qulonglong tSize = 0;
-    bool foundAnyData = false;
-    for (TorrentContentModelItem *child : asConst(m_childItems))
-    {
-        if (child->priority() == BitTorrent::DownloadPriority::Ignored)
-            continue;
-
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder*>(child)->recalculateAvailability();
         const qreal childAvailability = child->availability();
         if (childAvailability >= 0)
         { // -1 means "no data"
             tAvailability += childAvailability * child->size();
             foundAnyData = true;
         }
-        tSize += child->size();
     }
 
-    if (!isRootItem() && (tSize > 0) && foundAnyData)
+    m_isDirty = false;
+
+    if (isRootItem())
+        return;
+
+    if (tSize > 0)
+    {
+        m_progress = tProgress / tSize;
+        m_remaining = tRemaining;
+    }
+    else
+    {
+        m_progress = 1.0;
+        m_remaining = 0;
+    }
+    Q_ASSERT(m_progress <= 1.);
+
+    if ((tSize > 0) && foundAnyData)
     {
         m_availability = tAvailability / tSize;
         Q_ASSERT(m_availability <= 1.);
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <QList>
+
 #include "torrentcontentmodelitem.h"
 
 namespace BitTorrent
@@ -36,21 +38,24 @@ namespace BitTorrent
     enum class DownloadPriority;
 }
 
+// Owns its child folders, file items are owned by the model
 class TorrentContentModelFolder final : public TorrentContentModelItem
 {
 public:
+    // Invisible root item constructor
+    TorrentContentModelFolder();
+
     // Folder constructor
     explicit TorrentContentModelFolder(const QString &name);
 
-    // Invisible root item constructor
-    explicit TorrentContentModelFolder(const QList<QString> &data);
-
     ~TorrentContentModelFolder() override;
 
     ItemType itemType() const override;
 
-    void recalculateProgress();
-    void recalculateAvailability();
+    // Marks progress and availability of this folder and its ancestors as outdated
+    void markDirty();
+    // Recalculates progress and availability of outdated folders in the subtree
+    void recalculate();
     void updatePriority();
 
     void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) override;
@@ -67,4 +72,5 @@ private:
     void decreaseSize(qulonglong delta);
 
     QList<TorrentContentModelItem *> m_childItems;
+    bool m_isDirty = true;
 };
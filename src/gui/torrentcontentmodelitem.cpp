@@ -96,7 +96,7 @@ int TorrentContentModelItem::columnCount() const
 QString TorrentContentModelItem::displayData(const int column) const
 {
     if (isRootItem())
-        return m_itemData.value(column);
+        return {};
 
     switch (column)
     {
@@ -146,7 +146,7 @@ QString TorrentContentModelItem::displayData(const int column) const
 QVariant TorrentContentModelItem::underlyingData(const int column) const
 {
     if (isRootItem())
-        return m_itemData.value(column);
+        return {};
 
     switch (column)
     {
@@ -172,9 +172,7 @@ QVariant TorrentContentModelItem::underlyingData(const int column) const
 
 int TorrentContentModelItem::row() const
 {
-    if (m_parentItem)
-        return m_parentItem->children().indexOf(const_cast<TorrentContentModelItem *>(this));
-    return 0;
+    return m_row;
 }
 
 TorrentContentModelFolder *TorrentContentModelItem::parent() const
@@ -30,7 +30,6 @@
 #pragma once
 
 #include <QCoreApplication>
-#include <QList>
 
 #include "base/bittorrent/downloadpriority.h"
 
@@ -88,9 +87,6 @@ public:
     int row() const;
 
 protected:
-    // Root item members
-    QList<QString> m_itemData;
-    // Non-root item members
     QString m_name;
     qulonglong m_size = 0;
     qulonglong m_remaining = 0;
@@ -100,4 +96,5 @@ protected:
 
 private:
     TorrentContentModelFolder *m_parentItem = nullptr;
+    int m_row = 0;
 };
@@ -383,7 +383,7 @@ void TrackersFilterWidget::downloadFavicon(const QString &trackerHost, const QSt
     if (downloadingFaviconNode.isEmpty())
     {
         Net::DownloadManager::instance()->download(
-                Net::DownloadRequest(faviconURL).saveToFile(true), Preferences::instance()->useProxyForGeneralPurposes()
+                Net::DownloadRequest(faviconURL).saveToFile(true).priority(Net::RequestPriority::Background), Preferences::instance()->useProxyForGeneralPurposes()
                 , this, &TrackersFilterWidget::handleFavicoDownloadFinished);
     }
 
@@ -139,6 +139,9 @@ TransferListModel::TransferListModel(QObject *parent)
     connect(Session::instance(), &Session::torrentFinishedChecking, this, &TransferListModel::handleTorrentStatusUpdated);
 
     connect(Session::instance(), &Session::trackerEntryStatusesUpdated, this, &TransferListModel::handleTorrentStatusUpdated);
+    connect(Session::instance(), &Session::trackersAdded, this, &TransferListModel::handleTorrentStatusUpdated);
+    connect(Session::instance(), &Session::trackersRemoved, this, &TransferListModel::handleTorrentStatusUpdated);
+    connect(Session::instance(), &Session::trackersReset, this, &TransferListModel::handleTorrentStatusUpdated);
 }
 
 int TransferListModel::rowCount(const QModelIndex &) const
@@ -653,6 +656,7 @@ void TransferListModel::addTorrents(const QList<BitTorrent::Torrent *> &torrents
     {
         Q_ASSERT(m_torrents.get<ByHandle>().find(torrent) == m_torrents.get<ByHandle>().end());  // TODO: use `contains()` with boost >= 1.84
         m_torrents.get<ByIndex>().emplace_back(torrent);
+        updateCachedValues(torrent);
     }
     endInsertRows();
 }
@@ -681,6 +685,7 @@ void TransferListModel::handleTorrentAboutToBeRemoved(BitTorrent::Torrent *const
     const auto iter = m_torrents.get<ByIndex>().begin() + row;
     beginRemoveRows({}, row, row);
     m_torrents.get<ByIndex>().erase(iter);
+    m_cachedValues.remove(torrent);
     endRemoveRows();
 }
 
@@ -689,13 +694,12 @@ void TransferListModel::handleTorrentStatusUpdated(BitTorrent::Torrent *const to
     const int row = getTorrentRow(torrent);
     Q_ASSERT(row >= 0);
 
-    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+    updateCachedValues(torrent);
+    emitTorrentDataChanged(row, row, 0, (columnCount() - 1));
 }
 
 void TransferListModel::handleTorrentsUpdated(const QList<BitTorrent::Torrent *> &torrents)
 {
-    const int columns = (columnCount() - 1);
-
     if (torrents.size() <= (m_torrents.size() * 0.5))
     {
         for (BitTorrent::Torrent *const torrent : torrents)
@@ -703,16 +707,131 @@ void TransferListModel::handleTorrentsUpdated(const QList<BitTorrent::Torrent *>
             const int row = getTorrentRow(torrent);
             Q_ASSERT(row >= 0);
 
-            emit dataChanged(index(row, 0), index(row, columns));
+            emitColumnsChanged(row, row, updateCachedValues(torrent));
         }
     }
     else
     {
         // save the overhead when more than half of the torrent list needs update
-        emit dataChanged(index(0, 0), index((rowCount() - 1), columns));
+        ColumnSet changedColumns;
+        for (BitTorrent::Torrent *const torrent : torrents)
+            changedColumns |= updateCachedValues(torrent);
+
+        emitColumnsChanged(0, (rowCount() - 1), changedColumns);
+    }
+}
+
+QVariant TransferListModel::comparableValue(const BitTorrent::Torrent *torrent, const int column) const
+{
+    switch (column)
+    {
+    case TR_SEEDS:
+    case TR_PEERS:
+    case TR_TIME_ELAPSED:
+        // these columns display an additional value as well
+        return QVariantList {internalValue(torrent, column, false), internalValue(torrent, column, true)};
+    default:
+        return internalValue(torrent, column, false);
+    }
+}
+
+TransferListModel::ColumnSet TransferListModel::updateCachedValues(BitTorrent::Torrent *const torrent)
+{
+    QList<QVariant> &cachedValues = m_cachedValues[torrent];
+    if (cachedValues.isEmpty())
+        cachedValues.resize(NB_COLUMNS);
+
+    // Comparing values is only worth it for the columns the proxy model depends on
+    ColumnSet changedColumns = ~m_trackedColumns;
+    for (int column = 0; column < NB_COLUMNS; ++column)
+    {
+        if (!m_trackedColumns.test(column))
+            continue;
+
+        QVariant value = comparableValue(torrent, column);
+        if (value != cachedValues[column])
+        {
+            cachedValues[column] = std::move(value);
+            changedColumns.set(column);
+        }
+    }
+
+    // Torrent state affects the icon, the text color and the way zero values
+    // are displayed, so the whole row needs to be updated when it changes
+    if (changedColumns.test(TR_STATUS))
+        changedColumns.set();
+    else if ((m_sortColumn >= 0) && (m_subSortColumn >= 0) && changedColumns.test(m_subSortColumn))
+        changedColumns.set(m_sortColumn);
+
+    return changedColumns;
+}
+
+void TransferListModel::emitColumnsChanged(const int firstRow, const int lastRow, const ColumnSet &columns)
+{
+    if ((firstRow > lastRow) || columns.none())
+        return;
+
+    // Emit separate signal for each contiguous range of changed columns
+    // so that the views and proxy models don't have to process unaffected ones
+    int column = 0;
+    while (column < NB_COLUMNS)
+    {
+        if (!columns.test(column))
+        {
+            ++column;
+            continue;
+        }
+
+        const int firstColumn = column;
+        while ((column < NB_COLUMNS) && columns.test(column))
+            ++column;
+
+        emitTorrentDataChanged(firstRow, lastRow, firstColumn, (column - 1));
     }
 }
 
+void TransferListModel::emitTorrentDataChanged(const int firstRow, const int lastRow, const int firstColumn, const int lastColumn)
+{
+    emit torrentDataAboutToChange(firstColumn, lastColumn);
+    emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn));
+    emit torrentDataChangeFinished();
+}
+
+void TransferListModel::setTrackedColumns(const QList<int> &columns)
+{
+    ColumnSet trackedColumns;
+    // Torrent state change requires the whole row to be updated so it is always tracked
+    trackedColumns.set(TR_STATUS);
+    for (const int column : columns)
+    {
+        if ((column >= 0) && (column < NB_COLUMNS))
+            trackedColumns.set(column);
+    }
+
+    if (trackedColumns == m_trackedColumns)
+        return;
+
+    // Values of untracked columns are dropped, so the newly tracked ones
+    // are reported as changed on the next update
+    for (QList<QVariant> &cachedValues : m_cachedValues)
+    {
+        for (int column = 0; column < NB_COLUMNS; ++column)
+        {
+            if (!trackedColumns.test(column))
+                cachedValues[column] = {};
+        }
+    }
+
+    m_trackedColumns = trackedColumns;
+}
+
+void TransferListModel::setSortColumns(const int sortColumn, const int subSortColumn)
+{
+    const auto isValidColumn = [](const int column) { return ((column >= 0) && (column < NB_COLUMNS)); };
+    m_sortColumn = isValidColumn(sortColumn) ? sortColumn : -1;
+    m_subSortColumn = isValidColumn(subSortColumn) ? subSortColumn : -1;
+}
+
 int TransferListModel::getTorrentRow(BitTorrent::Torrent *const torrent) const
 {
     const auto iter = m_torrents.get<ByHandle>().find(torrent);
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <bitset>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
@@ -114,6 +116,19 @@ public:
 
     BitTorrent::Torrent *torrentHandle(const QModelIndex &index) const;
 
+    // Changes in tracked columns are detected by comparing their values,
+    // other columns are always reported as changed when torrent is updated
+    void setTrackedColumns(const QList<int> &columns);
+    // Proxy re-sorts changed rows only if sort column is within the changed range,
+    // so sort column is reported as changed whenever sub-sort column changes
+    void setSortColumns(int sortColumn, int subSortColumn);
+
+signals:
+    // Emitted right before and after dataChanged() caused by torrent updates,
+    // so that a proxy can tell which columns the changes it's going to process belong to
+    void torrentDataAboutToChange(int firstColumn, int lastColumn);
+    void torrentDataChangeFinished();
+
 private slots:
     void addTorrents(const QList<BitTorrent::Torrent *> &torrents);
     void handleTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent);
@@ -121,7 +136,13 @@ private slots:
     void handleTorrentsUpdated(const QList<BitTorrent::Torrent *> &torrents);
 
 private:
+    using ColumnSet = std::bitset<NB_COLUMNS>;
+
     int getTorrentRow(BitTorrent::Torrent *torrent) const;
+    QVariant comparableValue(const BitTorrent::Torrent *torrent, int column) const;
+    ColumnSet updateCachedValues(BitTorrent::Torrent *torrent);
+    void emitColumnsChanged(int firstRow, int lastRow, const ColumnSet &columns);
+    void emitTorrentDataChanged(int firstRow, int lastRow, int firstColumn, int lastColumn);
 
     void configure();
     void loadUIThemeResources();
@@ -135,6 +156,11 @@ private:
             boost::multi_index::random_access<boost::multi_index::tag<struct ByIndex>>,
             boost::multi_index::hashed_unique<boost::multi_index::tag<struct ByHandle>, boost::multi_index::identity<BitTorrent::Torrent *>>>>;
     TorrentList m_torrents;
+    // last reported values of tracked columns of each torrent, used to find out which columns have actually changed
+    QHash<BitTorrent::Torrent *, QList<QVariant>> m_cachedValues;
+    ColumnSet m_trackedColumns = ColumnSet().set();
+    int m_sortColumn = -1;
+    int m_subSortColumn = -1;
     const QHash<BitTorrent::TorrentState, QString> m_statusStrings;
     // row text colors
     QHash<BitTorrent::TorrentState, QColor> m_stateThemeColors;
@@ -28,6 +28,8 @@
 
 #include "transferlistsortmodel.h"
 
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 
 #include <QtVersionChecks>
@@ -96,6 +98,16 @@ namespace
         return leftValid ? -1 : 1;
     }
 
+    // columns that reflect torrent properties used by TorrentFilter
+    const int FILTER_COLUMNS[] =
+    {
+        TransferListModel::TR_STATUS,
+        TransferListModel::TR_CATEGORY,
+        TransferListModel::TR_TAGS,
+        TransferListModel::TR_TRACKER,
+        TransferListModel::TR_PRIVATE
+    };
+
     int adjustSubSortColumn(const int column)
     {
         return ((column >= 0) && (column < TransferListModel::NB_COLUMNS))
@@ -109,6 +121,31 @@ TransferListSortModel::TransferListSortModel(QObject *parent)
     , m_subSortOrder {u"TransferList/SubSortOrder"_s, 0}
 {
     setSortRole(TransferListModel::UnderlyingDataRole);
+    setFilterKeyColumn(TransferListModel::TR_NAME);
+}
+
+void TransferListSortModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    disconnect(m_sourceDataAboutToChangeConnection);
+    disconnect(m_sourceDataChangeFinishedConnection);
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    // Let filterAcceptsRow() know whether the columns being changed can affect filtering
+    if (const auto *model = qobject_cast<TransferListModel *>(sourceModel))
+    {
+        m_sourceDataAboutToChangeConnection = connect(model, &TransferListModel::torrentDataAboutToChange, this
+                , [this](const int firstColumn, const int lastColumn)
+        {
+            m_isFilterAffected = isFilterAffected(firstColumn, lastColumn);
+        });
+        m_sourceDataChangeFinishedConnection = connect(model, &TransferListModel::torrentDataChangeFinished, this, [this]
+        {
+            m_isFilterAffected = true;
+        });
+    }
+
+    updateTrackedColumns();
 }
 
 void TransferListSortModel::sort(const int column, const Qt::SortOrder order)
@@ -122,6 +159,13 @@ void TransferListSortModel::sort(const int column, const Qt::SortOrder order)
     m_lastSortOrder = ((order == Qt::AscendingOrder) ? 0 : 1);
 
     QSortFilterProxyModel::sort(column, order);
+    updateTrackedColumns();
+}
+
+void TransferListSortModel::setTextFilterColumn(const int column)
+{
+    setFilterKeyColumn(column);
+    updateTrackedColumns();
 }
 
 void TransferListSortModel::setStatusFilter(const TorrentFilter::Status status)
@@ -134,6 +178,7 @@ void TransferListSortModel::setStatusFilter(const TorrentFilter::Status status)
     if (m_filter.setStatus(status))
         invalidateRowsFilter();
 #endif
+    updateTrackedColumns();
 }
 
 void TransferListSortModel::setCategoryFilter(const QString &category)
@@ -314,6 +359,10 @@ bool TransferListSortModel::lessThan(const QModelIndex &left, const QModelIndex
 
 bool TransferListSortModel::filterAcceptsRow(const int sourceRow, const QModelIndex &sourceParent) const
 {
+    // Changed data doesn't affect filtering so just keep the row in its current state
+    if (!m_isFilterAffected)
+        return mapFromSource(sourceModel()->index(sourceRow, 0, sourceParent)).isValid();
+
     return matchFilter(sourceRow, sourceParent)
            && QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
@@ -328,3 +377,60 @@ bool TransferListSortModel::matchFilter(const int sourceRow, const QModelIndex &
 
     return m_filter.match(torrent);
 }
+
+bool TransferListSortModel::isFilterAffected(const int firstColumn, const int lastColumn) const
+{
+    const auto isInRange = [firstColumn, lastColumn](const int column)
+    {
+        return ((column >= firstColumn) && (column <= lastColumn));
+    };
+
+    if (std::ranges::any_of(FILTER_COLUMNS, isInRange))
+        return true;
+
+    // Tracker filters depend on tracker statuses that aren't reflected by any column
+    if (m_filter.trackerHost() || m_filter.announceStatus())
+        return true;
+
+    // "Active" and "Inactive" status filters depend on transfer rates
+    const TorrentFilter::Status status = m_filter.status();
+    if (((status == TorrentFilter::Active) || (status == TorrentFilter::Inactive))
+            && (isInRange(TransferListModel::TR_DLSPEED) || isInRange(TransferListModel::TR_UPSPEED)))
+    {
+        return true;
+    }
+
+    // text filter
+    return ((filterKeyColumn() < 0) || isInRange(filterKeyColumn()));
+}
+
+void TransferListSortModel::updateTrackedColumns()
+{
+    auto *model = qobject_cast<TransferListModel *>(sourceModel());
+    if (!model)
+        return;
+
+    // Source model only needs to detect actual changes of the columns that affect sorting and filtering
+    QList<int> columns {std::begin(FILTER_COLUMNS), std::end(FILTER_COLUMNS)};
+    columns.append({sortColumn(), m_subSortColumn.get()});
+    model->setSortColumns(sortColumn(), m_subSortColumn);
+
+    const TorrentFilter::Status status = m_filter.status();
+    if ((status == TorrentFilter::Active) || (status == TorrentFilter::Inactive))
+        columns.append({TransferListModel::TR_DLSPEED, TransferListModel::TR_UPSPEED});
+
+    if (filterKeyColumn() >= 0)
+    {
+        columns.append(filterKeyColumn());
+        model->setTrackedColumns(columns);
+    }
+    else
+    {
+        // text filter is applied to all the columns
+        QList<int> allColumns;
+        allColumns.reserve(TransferListModel::NB_COLUMNS);
+        for (int column = 0; column < TransferListModel::NB_COLUMNS; ++column)
+            allColumns.append(column);
+        model->setTrackedColumns(allColumns);
+    }
+}
@@ -47,8 +47,10 @@ class TransferListSortModel final : public QSortFilterProxyModel
 public:
     explicit TransferListSortModel(QObject *parent = nullptr);
 
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
     void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
 
+    void setTextFilterColumn(int column);
     void setStatusFilter(TorrentFilter::Status status);
     void setCategoryFilter(const QString &category);
     void disableCategoryFilter();
@@ -63,12 +65,18 @@ private:
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
     bool matchFilter(int sourceRow, const QModelIndex &sourceParent) const;
+    bool isFilterAffected(int firstColumn, int lastColumn) const;
+    void updateTrackedColumns();
 
     TorrentFilter m_filter;
     CachedSettingValue<int> m_subSortColumn;
     CachedSettingValue<int> m_subSortOrder;
     int m_lastSortColumn = -1;
     int m_lastSortOrder = 0;
+    // Whether the rows being re-evaluated by the dynamic filter could have changed their filter state
+    bool m_isFilterAffected = true;
+    QMetaObject::Connection m_sourceDataAboutToChangeConnection;
+    QMetaObject::Connection m_sourceDataChangeFinishedConnection;
 
     Utils::Compare::NaturalCompare<Qt::CaseInsensitive> m_naturalCompare;
 };
@@ -128,7 +128,7 @@ TransferListWidget::TransferListWidget(IGUIApplication *app, QWidget *parent)
 
     m_sortFilterModel->setDynamicSortFilter(true);
     m_sortFilterModel->setSourceModel(m_listModel);
-    m_sortFilterModel->setFilterKeyColumn(TransferListModel::TR_NAME);
+    m_sortFilterModel->setTextFilterColumn(TransferListModel::TR_NAME);
     m_sortFilterModel->setFilterRole(Qt::DisplayRole);
     m_sortFilterModel->setSortCaseSensitivity(Qt::CaseInsensitive);
     m_sortFilterModel->setSortRole(TransferListModel::UnderlyingDataRole);
@@ -1384,7 +1384,7 @@ void TransferListWidget::applyAnnounceStatusFilter(const std::optional<BitTorren
 
 void TransferListWidget::applyFilter(const QString &name, const TransferListModel::Column &type)
 {
-    m_sortFilterModel->setFilterKeyColumn(type);
+    m_sortFilterModel->setTextFilterColumn(type);
     const QString pattern = (Preferences::instance()->getRegexAsFilteringPatternForTransferList()
                 ? name : Utils::String::wildcardToRegexPattern(name));
     m_sortFilterModel->setFilterRegularExpression(QRegularExpression(pattern, QRegularExpression::CaseInsensitiveOption));
@@ -1,4 +1,4 @@
-# VERSION: 1.53
+# VERSION: 1.54
 
 # Author:
 #  Fabien Devaux <fab AT gnux DOT info>
@@ -248,7 +248,8 @@ if __name__ == "__main__":
         params = ((engine_class, what, category) for e in engines if (engine_class := import_engine(e)) is not None)
 
         search_success = False
-        if THREADED:
+        # qbt runs a separate process per engine, no need to spawn another one in that case
+        if THREADED and (len(engines) > 1):
             processes = max(min(len(engines), MAX_THREADS), 1)
             # cannot use `forkserver` as it will interfere with `helpers.enable_socks_proxy()`
             with MP.get_context("spawn").Pool(processes) as pool:
@@ -33,6 +33,7 @@
 #include <QHash>
 #include <QJsonDocument>
 #include <QList>
+#include <QMetaMethod>
 #include <QMetaObject>
 #include <QScopeGuard>
 
@@ -55,13 +56,50 @@ APIResult APIController::run(const QString &action, const StringMap &params, con
         m_data = {};
     });
 
-    const QByteArray methodName = action.toLatin1() + "Action";
-    if (!QMetaObject::invokeMethod(this, methodName.constData()))
+    const QMetaMethod actionMethod = findActionMethod(action);
+    if (!actionMethod.isValid())
         throw APIError(APIErrorType::NotFound, tr("Endpoint does not exist"));
 
+    actionMethod.invoke(this);
+
     return std::exchange(m_result, {});
 }
 
+bool APIController::hasAction(const QString &action) const
+{
+    return findActionMethod(action).isValid();
+}
+
+QMetaMethod APIController::findActionMethod(const QString &action) const
+{
+    // Routing table of each controller class is built once from its "<action>Action" slots.
+    // Controllers are only used from the thread of WebApplication so no locking is needed.
+    static QHash<const QMetaObject *, QHash<QString, QMetaMethod>> routingTables;
+
+    const QMetaObject *controllerMetaObject = metaObject();
+    auto routingTableIter = routingTables.constFind(controllerMetaObject);
+    if (routingTableIter == routingTables.cend())
+    {
+        const QByteArray actionSuffix = "Action";
+
+        QHash<QString, QMetaMethod> routingTable;
+        for (int i = QObject::staticMetaObject.methodCount(); i < controllerMetaObject->methodCount(); ++i)
+        {
+            const QMetaMethod method = controllerMetaObject->method(i);
+            if ((method.methodType() != QMetaMethod::Slot) || (method.parameterCount() != 0))
+                continue;
+
+            const QByteArray methodName = method.name();
+            if (methodName.endsWith(actionSuffix))
+                routingTable.insert(QString::fromLatin1(methodName.chopped(actionSuffix.size())), method);
+        }
+
+        routingTableIter = routingTables.insert(controllerMetaObject, routingTable);
+    }
+
+    return routingTableIter->value(action);
+}
+
 const StringMap &APIController::params() const
 {
     return m_params;
@@ -112,6 +150,11 @@ void APIController::setResult(const Path &filePath)
     m_result = StreamFileAPIResult {.filePath = filePath};
 }
 
+void APIController::setEventStreamResult(EventStreamHandler handler)
+{
+    m_result = EventStreamAPIResult {.handler = std::move(handler)};
+}
+
 void APIController::setStatus(const APIStatus status)
 {
     Q_ASSERT(std::holds_alternative<RegularAPIResult>(m_result));
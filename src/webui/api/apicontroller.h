@@ -28,9 +28,12 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <variant>
 
 #include <QtContainerFwd>
+#include <QMetaMethod>
 #include <QObject>
 #include <QString>
 #include <QVariant>
@@ -39,6 +42,11 @@
 #include "base/path.h"
 #include "apistatus.h"
 
+namespace Http
+{
+    class ResponseStream;
+}
+
 using DataMap = QHash<QString, QByteArray>;
 using StringMap = QHash<QString, QString>;
 
@@ -55,7 +63,14 @@ struct StreamFileAPIResult
     Path filePath;
 };
 
-using APIResult = std::variant<RegularAPIResult, StreamFileAPIResult>;
+using EventStreamHandler = std::function<void (std::shared_ptr<Http::ResponseStream> stream)>;
+
+struct EventStreamAPIResult
+{
+    EventStreamHandler handler;
+};
+
+using APIResult = std::variant<RegularAPIResult, StreamFileAPIResult, EventStreamAPIResult>;
 
 class APIController : public ApplicationComponent<QObject>
 {
@@ -66,6 +81,7 @@ public:
     explicit APIController(IApplication *app, QObject *parent = nullptr);
 
     APIResult run(const QString &action, const StringMap &params, const DataMap &data = {});
+    bool hasAction(const QString &action) const;
 
 protected:
     const StringMap &params() const;
@@ -77,10 +93,14 @@ protected:
     void setResult(const QJsonObject &result);
     void setResult(const QByteArray &result, const QString &mimeType = {}, const QString &filename = {});
     void setResult(const Path &filePath);
+    // Respond with "text/event-stream", `handler` is given the stream once response is started
+    void setEventStreamResult(EventStreamHandler handler);
 
     void setStatus(APIStatus status);
 
 private:
+    QMetaMethod findActionMethod(const QString &action) const;
+
     StringMap m_params;
     DataMap m_data;
     APIResult m_result;
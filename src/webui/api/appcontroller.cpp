@@ -47,6 +47,7 @@
 #include <QStringList>
 #include <QTimer>
 
+#include "base/bittorrent/bandwidthrule.h"
 #include "base/bittorrent/session.h"
 #include "base/global.h"
 #include "base/interfaces/iapplication.h"
@@ -58,6 +59,7 @@
 #include "base/preferences.h"
 #include "base/rss/rss_autodownloader.h"
 #include "base/rss/rss_session.h"
+#include "base/settingsstorage.h"
 #include "base/torrentfileguard.h"
 #include "base/torrentfileswatcher.h"
 #include "base/utils/apikey.h"
@@ -69,6 +71,7 @@
 #include "base/utils/string.h"
 #include "base/version.h"
 #include "apierror.h"
+#include "../apimetrics.h"
 #include "../webapplication.h"
 
 using namespace std::chrono_literals;
@@ -85,6 +88,12 @@ const QString KEY_FILE_METADATA_CREATION_DATE = u"creation_date"_s;
 const QString KEY_FILE_METADATA_LAST_ACCESS_DATE = u"last_access_date"_s;
 const QString KEY_FILE_METADATA_LAST_MODIFICATION_DATE = u"last_modification_date"_s;
 
+AppController::AppController(const APIMetrics *apiMetrics, IApplication *app, QObject *parent)
+    : APIController(app, parent)
+    , m_apiMetrics {apiMetrics}
+{
+}
+
 void AppController::webapiVersionAction()
 {
     setResult(API_VERSION.toString());
@@ -123,9 +132,14 @@ void AppController::buildInfoAction()
 
 void AppController::processInfoAction()
 {
+    const SettingsStorage::SaveStatistics settingsSaveStatistics = SettingsStorage::instance()->saveStatistics();
     const QJsonObject info =
     {
-        {u"launch_time"_s, app()->launchTimeSecsSinceEpoch()}
+        {u"launch_time"_s, app()->launchTimeSecsSinceEpoch()},
+        {u"settings_save_count"_s, settingsSaveStatistics.saveCount},
+        {u"settings_bytes_written"_s, settingsSaveStatistics.bytesWritten},
+        {u"settings_last_save_duration"_s, static_cast<qint64>(settingsSaveStatistics.lastSaveDuration.count())},
+        {u"settings_total_save_duration"_s, static_cast<qint64>(settingsSaveStatistics.totalSaveDuration.count())}
     };
     setResult(info);
 }
@@ -349,6 +363,7 @@ void AppController::preferencesAction()
     data[u"web_ui_max_auth_fail_count"_s] = pref->getWebUIMaxAuthFailCount();
     data[u"web_ui_ban_duration"_s] = static_cast<int>(pref->getWebUIBanDuration().count());
     data[u"web_ui_session_timeout"_s] = pref->getWebUISessionTimeout();
+    data[u"web_ui_network_threads"_s] = pref->getWebUINetworkThreads();
     // API key
     data[u"web_ui_api_key"_s] = pref->getWebUIApiKey();
     // Use alternative WebUI
@@ -399,6 +414,10 @@ void AppController::preferencesAction()
     data[u"save_resume_data_interval"_s] = session->saveResumeDataInterval();
     // Save statistics interval
     data[u"save_statistics_interval"_s] = static_cast<int>(session->saveStatisticsInterval().count());
+    // Record transfer history by category
+    data[u"transfer_history_by_category"_s] = session->isTransferHistoryByCategoryEnabled();
+    // Export metrics by category
+    data[u"metrics_by_category"_s] = session->isMetricsByCategoryEnabled();
     // .torrent file size limit
     data[u"torrent_file_size_limit"_s] = pref->getTorrentFileSizeLimit();
     // Confirm torrent recheck
@@ -423,6 +442,10 @@ void AppController::preferencesAction()
     data[u"mark_of_the_web"_s] = pref->isMarkOfTheWebEnabled();
     // Ignore SSL errors
     data[u"ignore_ssl_errors"_s] = pref->isIgnoreSSLErrors();
+    // HTTP connections per host
+    data[u"download_connections_per_host"_s] = pref->getDownloadConnectionsPerHost();
+    // HTTP request rate per host
+    data[u"download_request_rate_per_host"_s] = pref->getDownloadRequestRatePerHost();
     // Python executable path
     data[u"python_executable_path"_s] = pref->getPythonExecutablePath().toString();
 
@@ -934,6 +957,8 @@ void AppController::setPreferencesAction()
         pref->setWebUIBanDuration(std::chrono::seconds {it.value().toInt()});
     if (hasKey(u"web_ui_session_timeout"_s))
         pref->setWebUISessionTimeout(it.value().toInt());
+    if (hasKey(u"web_ui_network_threads"_s))
+        pref->setWebUINetworkThreads(it.value().toInt());
     // Use alternative WebUI
     if (hasKey(u"alternative_webui_enabled"_s))
         pref->setAltWebUIEnabled(it.value().toBool());
@@ -1024,6 +1049,12 @@ void AppController::setPreferencesAction()
     // Save statistics interval
     if (hasKey(u"save_statistics_interval"_s))
         session->setSaveStatisticsInterval(std::chrono::minutes(it.value().toInt()));
+    // Record transfer history by category
+    if (hasKey(u"transfer_history_by_category"_s))
+        session->setTransferHistoryByCategoryEnabled(it.value().toBool());
+    // Export metrics by category
+    if (hasKey(u"metrics_by_category"_s))
+        session->setMetricsByCategoryEnabled(it.value().toBool());
     // .torrent file size limit
     if (hasKey(u"torrent_file_size_limit"_s))
         pref->setTorrentFileSizeLimit(it.value().toLongLong());
@@ -1061,6 +1092,12 @@ void AppController::setPreferencesAction()
     // Ignore SLL errors
     if (hasKey(u"ignore_ssl_errors"_s))
         pref->setIgnoreSSLErrors(it.value().toBool());
+    // HTTP connections per host
+    if (hasKey(u"download_connections_per_host"_s))
+        pref->setDownloadConnectionsPerHost(it.value().toInt());
+    // HTTP request rate per host
+    if (hasKey(u"download_request_rate_per_host"_s))
+        pref->setDownloadRequestRatePerHost(it.value().toInt());
     // Python executable path
     if (hasKey(u"python_executable_path"_s))
         pref->setPythonExecutablePath(Path(it.value().toString()));
@@ -1360,6 +1397,47 @@ void AppController::setCookiesAction()
     setResult(QString());
 }
 
+void AppController::bandwidthRulesAction()
+{
+    const QList<BitTorrent::BandwidthRule> rules = BitTorrent::Session::instance()->bandwidthRules();
+    QJsonArray ret;
+    for (const BitTorrent::BandwidthRule &rule : rules)
+        ret << rule.toJSON();
+
+    setResult(ret);
+}
+
+void AppController::setBandwidthRulesAction()
+{
+    requireParams({u"rules"_s});
+
+    QJsonParseError jsonError;
+    const auto rulesJsonDocument = QJsonDocument::fromJson(params()[u"rules"_s].toUtf8(), &jsonError);
+    if (jsonError.error != QJsonParseError::NoError)
+        throw APIError(APIErrorType::BadParams, jsonError.errorString());
+    if (!rulesJsonDocument.isArray())
+        throw APIError(APIErrorType::BadParams, tr("rules must be array"));
+
+    const QJsonArray rulesJsonArr = rulesJsonDocument.array();
+    QList<BitTorrent::BandwidthRule> rules;
+    rules.reserve(rulesJsonArr.size());
+    for (const QJsonValue &jsonVal : rulesJsonArr)
+    {
+        if (!jsonVal.isObject())
+            throw APIError(APIErrorType::BadParams);
+
+        const auto rule = BitTorrent::BandwidthRule::fromJSON(jsonVal.toObject());
+        if (!rule.isValid())
+            throw APIError(APIErrorType::BadParams, tr("Invalid bandwidth rule"));
+
+        rules << rule;
+    }
+
+    BitTorrent::Session::instance()->setBandwidthRules(rules);
+
+    setResult(QString());
+}
+
 void AppController::rotateAPIKeyAction()
 {
     const QString key = Utils::APIKey::generate();
@@ -1425,3 +1503,62 @@ void AppController::networkInterfaceAddressListAction()
 
     setResult(addressList);
 }
+
+void AppController::downloadStatisticsAction()
+{
+    const QHash<Net::ServiceID, Net::ServiceStatistics> statistics = Net::DownloadManager::instance()->serviceStatistics();
+
+    QJsonArray serviceList;
+    for (auto it = statistics.cbegin(); it != statistics.cend(); ++it)
+    {
+        const Net::ServiceStatistics &serviceStatistics = it.value();
+        serviceList.append(QJsonObject
+        {
+            {u"host"_s, it.key().hostName},
+            {u"port"_s, it.key().port},
+            {u"started"_s, serviceStatistics.startedRequests},
+            {u"failed"_s, serviceStatistics.failedRequests},
+            {u"cacheHits"_s, serviceStatistics.cacheHits},
+            {u"cacheMisses"_s, serviceStatistics.cacheMisses},
+            {u"active"_s, serviceStatistics.activeRequests},
+            {u"waiting"_s, serviceStatistics.waitingRequests}
+        });
+    }
+
+    setResult(serviceList);
+}
+
+void AppController::metricsAction()
+{
+    QJsonArray latencyBuckets;
+    for (const qint64 bucket : APIMetrics::LATENCY_BUCKETS)
+        latencyBuckets.append(bucket);
+
+    const QHash<QString, APIMetrics::EndpointStatistics> statistics = m_apiMetrics->statistics();
+
+    QJsonArray endpointList;
+    for (auto it = statistics.cbegin(); it != statistics.cend(); ++it)
+    {
+        const APIMetrics::EndpointStatistics &endpointStatistics = it.value();
+
+        QJsonArray latencyHistogram;
+        for (const qint64 count : endpointStatistics.latencyHistogram)
+            latencyHistogram.append(count);
+
+        endpointList.append(QJsonObject
+        {
+            {u"endpoint"_s, it.key()},
+            {u"requests"_s, endpointStatistics.requestCount},
+            {u"failed"_s, endpointStatistics.failedRequestCount},
+            {u"totalDuration"_s, endpointStatistics.totalDuration},
+            {u"maxDuration"_s, endpointStatistics.maxDuration},
+            {u"latencyHistogram"_s, latencyHistogram}
+        });
+    }
+
+    setResult(QJsonObject
+    {
+        {u"latencyBuckets"_s, latencyBuckets},
+        {u"endpoints"_s, endpointList}
+    });
+}
@@ -32,13 +32,15 @@
 
 #include "apicontroller.h"
 
+class APIMetrics;
+
 class AppController : public APIController
 {
     Q_OBJECT
     Q_DISABLE_COPY_MOVE(AppController)
 
 public:
-    using APIController::APIController;
+    AppController(const APIMetrics *apiMetrics, IApplication *app, QObject *parent = nullptr);
 
 private slots:
     void webapiVersionAction();
@@ -54,9 +56,16 @@ private slots:
     void getFreeSpaceAtPathAction();
     void cookiesAction();
     void setCookiesAction();
+    void bandwidthRulesAction();
+    void setBandwidthRulesAction();
     void rotateAPIKeyAction();
     void deleteAPIKeyAction();
 
     void networkInterfaceListAction();
     void networkInterfaceAddressListAction();
+    void downloadStatisticsAction();
+    void metricsAction();
+
+private:
+    const APIMetrics *m_apiMetrics = nullptr;
 };
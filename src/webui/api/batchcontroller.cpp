@@ -0,0 +1,237 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "batchcontroller.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+
+#include "base/global.h"
+#include "apierror.h"
+#include "webui/websession.h"
+
+namespace
+{
+    const int MAX_BATCH_SIZE = 1000;
+
+    const QString KEY_ENTRY_SCOPE = u"scope"_s;
+    const QString KEY_ENTRY_ACTION = u"action"_s;
+    const QString KEY_ENTRY_PARAMS = u"params"_s;
+
+    const QString KEY_RESULT_STATUS = u"status"_s;
+    const QString KEY_RESULT_DATA = u"result"_s;
+    const QString KEY_RESULT_ERROR = u"error"_s;
+
+    const QString PARAM_HASHES = u"hashes"_s;
+
+    // Torrent actions that do the same to each of the given torrents, so adjacent calls
+    // that differ only in "hashes" can be carried out as a single call
+    const QSet<QString> MERGEABLE_TORRENTS_ACTIONS
+    {
+        u"addTags"_s,
+        u"reannounce"_s,
+        u"recheck"_s,
+        u"removeTags"_s,
+        u"setAutoManagement"_s,
+        u"setCategory"_s,
+        u"setDownloadLimit"_s,
+        u"setForceStart"_s,
+        u"setShareLimits"_s,
+        u"setSuperSeeding"_s,
+        u"setTags"_s,
+        u"setUploadLimit"_s,
+        u"start"_s,
+        u"stop"_s
+    };
+
+    struct BatchEntry
+    {
+        QString scope;
+        QString action;
+        StringMap params;
+    };
+
+    bool canMerge(const BatchEntry &left, const BatchEntry &right)
+    {
+        if ((left.scope != u"torrents") || !MERGEABLE_TORRENTS_ACTIONS.contains(left.action))
+            return false;
+        if ((left.scope != right.scope) || (left.action != right.action))
+            return false;
+
+        const QString leftHashes = left.params.value(PARAM_HASHES);
+        const QString rightHashes = right.params.value(PARAM_HASHES);
+        if (leftHashes.isEmpty() || rightHashes.isEmpty() || (leftHashes == u"all") || (rightHashes == u"all"))
+            return false;
+
+        StringMap leftParams = left.params;
+        leftParams.remove(PARAM_HASHES);
+        StringMap rightParams = right.params;
+        rightParams.remove(PARAM_HASHES);
+        return leftParams == rightParams;
+    }
+
+    int toHTTPStatus(const APIErrorType errorType)
+    {
+        switch (errorType)
+        {
+        case APIErrorType::AccessDenied:
+            return 403;
+        case APIErrorType::BadData:
+            return 415;
+        case APIErrorType::BadParams:
+            return 400;
+        case APIErrorType::Conflict:
+            return 409;
+        case APIErrorType::NotFound:
+            return 404;
+        case APIErrorType::Unauthorized:
+            return 401;
+        }
+
+        Q_UNREACHABLE();
+        return 500;
+    }
+
+    QJsonObject serializeResult(const APIResult &apiResult)
+    {
+        if (!std::holds_alternative<RegularAPIResult>(apiResult))
+        {
+            return {{KEY_RESULT_STATUS, 400}
+                , {KEY_RESULT_ERROR, BatchController::tr("Endpoint is not supported in batch")}};
+        }
+
+        const auto result = std::get<RegularAPIResult>(apiResult);
+        if (result.data.isNull())
+            return {{KEY_RESULT_STATUS, 204}};
+
+        QJsonObject serializedResult {{KEY_RESULT_STATUS, ((result.status == APIStatus::Async) ? 202 : 200)}};
+        switch (result.data.userType())
+        {
+        case QMetaType::QJsonDocument:
+            {
+                const auto jsonDocument = result.data.toJsonDocument();
+                serializedResult[KEY_RESULT_DATA] = jsonDocument.isArray()
+                    ? QJsonValue(jsonDocument.array()) : QJsonValue(jsonDocument.object());
+            }
+            break;
+        case QMetaType::QByteArray:
+            serializedResult[KEY_RESULT_DATA] = QString::fromUtf8(result.data.toByteArray());
+            break;
+        case QMetaType::QString:
+        default:
+            serializedResult[KEY_RESULT_DATA] = result.data.toString();
+            break;
+        }
+
+        return serializedResult;
+    }
+}
+
+BatchController::BatchController(WebSession *session, IApplication *app, QObject *parent)
+    : APIController(app, parent)
+    , m_session {session}
+{
+    Q_ASSERT(m_session);
+}
+
+// Executes the given list of WebAPI requests in order and returns their results.
+// Results are listed in the same order and have the following fields:
+//  - "status": HTTP status code the request would be answered with
+//  - "result": response data (if any)
+//  - "error": error message (if any)
+// Adjacent per-torrent requests that differ only in "hashes" are executed at once.
+// POST param:
+//   - requests (JSON array): objects containing "scope", "action" and optional "params" object
+void BatchController::executeAction()
+{
+    requireParams({u"requests"_s});
+
+    QJsonParseError jsonError;
+    const auto requestsJsonDocument = QJsonDocument::fromJson(params()[u"requests"_s].toUtf8(), &jsonError);
+    if (jsonError.error != QJsonParseError::NoError)
+        throw APIError(APIErrorType::BadParams, jsonError.errorString());
+    if (!requestsJsonDocument.isArray())
+        throw APIError(APIErrorType::BadParams, tr("`requests` must be an array"));
+
+    const QJsonArray requestsJsonArray = requestsJsonDocument.array();
+    if (requestsJsonArray.size() > MAX_BATCH_SIZE)
+        throw APIError(APIErrorType::BadParams, tr("Too many requests. Maximum: %1").arg(MAX_BATCH_SIZE));
+
+    QList<BatchEntry> entries;
+    entries.reserve(requestsJsonArray.size());
+    for (const QJsonValue &requestJsonVal : requestsJsonArray)
+    {
+        const QJsonObject requestJsonObj = requestJsonVal.toObject();
+        BatchEntry entry {.scope = requestJsonObj.value(KEY_ENTRY_SCOPE).toString()
+                , .action = requestJsonObj.value(KEY_ENTRY_ACTION).toString()};
+        if (entry.scope.isEmpty() || entry.action.isEmpty())
+            throw APIError(APIErrorType::BadParams, tr("Items of `requests` must contain `scope` and `action`"));
+
+        const QJsonObject paramsJsonObj = requestJsonObj.value(KEY_ENTRY_PARAMS).toObject();
+        for (auto it = paramsJsonObj.constBegin(); it != paramsJsonObj.constEnd(); ++it)
+            entry.params.insert(it.key(), it.value().toVariant().toString());
+
+        entries.append(entry);
+    }
+
+    QJsonArray results;
+    for (qsizetype i = 0; i < entries.size();)
+    {
+        BatchEntry mergedEntry = entries[i];
+        qsizetype groupEnd = i + 1;
+        while ((groupEnd < entries.size()) && canMerge(entries[i], entries[groupEnd]))
+        {
+            mergedEntry.params[PARAM_HASHES] += u'|' + entries[groupEnd].params[PARAM_HASHES];
+            ++groupEnd;
+        }
+
+        QJsonObject result;
+        try
+        {
+            // authentication and nested batches are not allowed
+            APIController *controller = ((mergedEntry.scope != u"auth") && (mergedEntry.scope != u"batch"))
+                ? m_session->getAPIController(mergedEntry.scope) : nullptr;
+            if (!controller)
+                throw APIError(APIErrorType::NotFound, tr("Endpoint does not exist"));
+
+            result = serializeResult(controller->run(mergedEntry.action, mergedEntry.params));
+        }
+        catch (const APIError &error)
+        {
+            result = {{KEY_RESULT_STATUS, toHTTPStatus(error.type())}, {KEY_RESULT_ERROR, error.message()}};
+        }
+
+        for (; i < groupEnd; ++i)
+            results.append(result);
+    }
+
+    setResult(results);
+}
@@ -159,11 +159,18 @@ void SearchController::statusAction()
     for (const int searchId : searchIds)
     {
         const std::shared_ptr<SearchHandler> &searchHandler = m_searchHandlers[searchId];
+
+        QJsonObject pluginResults;
+        const QHash<QString, int> resultCountByPlugin = searchHandler->resultCountByPlugin();
+        for (auto iter = resultCountByPlugin.cbegin(); iter != resultCountByPlugin.cend(); ++iter)
+            pluginResults.insert(iter.key(), iter.value());
+
         statusArray << QJsonObject
         {
             {u"id"_s, searchId},
             {u"status"_s, searchHandler->isActive() ? u"Running"_s : u"Stopped"_s},
-            {u"total"_s, searchHandler->results().size()}
+            {u"total"_s, searchHandler->results().size()},
+            {u"pluginResults"_s, pluginResults}
         };
     }
 
@@ -39,54 +39,6 @@
 #include "base/utils/datetime.h"
 #include "base/utils/string.h"
 
-namespace
-{
-    QString torrentStateToString(const BitTorrent::TorrentState state)
-    {
-        switch (state)
-        {
-        case BitTorrent::TorrentState::Error:
-            return u"error"_s;
-        case BitTorrent::TorrentState::MissingFiles:
-            return u"missingFiles"_s;
-        case BitTorrent::TorrentState::Uploading:
-            return u"uploading"_s;
-        case BitTorrent::TorrentState::StoppedUploading:
-            return u"stoppedUP"_s;
-        case BitTorrent::TorrentState::QueuedUploading:
-            return u"queuedUP"_s;
-        case BitTorrent::TorrentState::StalledUploading:
-            return u"stalledUP"_s;
-        case BitTorrent::TorrentState::CheckingUploading:
-            return u"checkingUP"_s;
-        case BitTorrent::TorrentState::ForcedUploading:
-            return u"forcedUP"_s;
-        case BitTorrent::TorrentState::Downloading:
-            return u"downloading"_s;
-        case BitTorrent::TorrentState::DownloadingMetadata:
-            return u"metaDL"_s;
-        case BitTorrent::TorrentState::ForcedDownloadingMetadata:
-            return u"forcedMetaDL"_s;
-        case BitTorrent::TorrentState::StoppedDownloading:
-            return u"stoppedDL"_s;
-        case BitTorrent::TorrentState::QueuedDownloading:
-            return u"queuedDL"_s;
-        case BitTorrent::TorrentState::StalledDownloading:
-            return u"stalledDL"_s;
-        case BitTorrent::TorrentState::CheckingDownloading:
-            return u"checkingDL"_s;
-        case BitTorrent::TorrentState::ForcedDownloading:
-            return u"forcedDL"_s;
-        case BitTorrent::TorrentState::CheckingResumeData:
-            return u"checkingResumeData"_s;
-        case BitTorrent::TorrentState::Moving:
-            return u"moving"_s;
-        default:
-            return u"unknown"_s;
-        }
-    }
-}
-
 QVariantMap serialize(const BitTorrent::Torrent &torrent)
 {
     const auto adjustQueuePosition = [](const int position) -> int
@@ -138,7 +90,7 @@ QVariantMap serialize(const BitTorrent::Torrent &torrent)
         {KEY_TORRENT_LEECHS, torrent.leechsCount()},
         {KEY_TORRENT_NUM_INCOMPLETE, torrent.totalLeechersCount()},
 
-        {KEY_TORRENT_STATE, torrentStateToString(torrent.state())},
+        {KEY_TORRENT_STATE, BitTorrent::torrentStateToString(torrent.state())},
         {KEY_TORRENT_ETA, torrent.eta()},
         {KEY_TORRENT_SEQUENTIAL_DOWNLOAD, torrent.isSequentialDownload()},
         {KEY_TORRENT_FIRST_LAST_PIECE_PRIO, torrent.hasFirstLastPiecePriority()},
@@ -30,6 +30,7 @@
 
 #include <QFuture>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QMetaObject>
 
@@ -44,6 +45,7 @@
 #include "base/bittorrent/torrentinfo.h"
 #include "base/bittorrent/trackerentrystatus.h"
 #include "base/global.h"
+#include "base/http/responsestream.h"
 #include "base/net/geoipmanager.h"
 #include "base/net/reverseresolution.h"
 #include "base/preferences.h"
@@ -53,6 +55,8 @@
 
 namespace
 {
+    const int MAINDATA_STREAM_HEARTBEAT_INTERVAL = 15'000;  // milliseconds
+
     // Sync main data keys
     const QString KEY_SYNC_MAINDATA_QUEUEING = u"queueing"_s;
     const QString KEY_SYNC_MAINDATA_REFRESH_INTERVAL = u"refresh_interval"_s;
@@ -99,7 +103,11 @@ namespace
     const QString KEY_TRANSFER_ALLTIME_DL = u"alltime_dl"_s;
     const QString KEY_TRANSFER_ALLTIME_UL = u"alltime_ul"_s;
     const QString KEY_TRANSFER_AVERAGE_TIME_QUEUE = u"average_time_queue"_s;
+    const QString KEY_TRANSFER_BULK_IO_AVERAGE_TIME = u"bulk_io_average_time"_s;
+    const QString KEY_TRANSFER_BULK_IO_QUEUED_JOBS = u"bulk_io_queued_jobs"_s;
     const QString KEY_TRANSFER_GLOBAL_RATIO = u"global_ratio"_s;
+    const QString KEY_TRANSFER_IO_AVERAGE_TIME = u"session_io_average_time"_s;
+    const QString KEY_TRANSFER_IO_QUEUED_JOBS = u"session_io_queued_jobs"_s;
     const QString KEY_TRANSFER_QUEUED_IO_JOBS = u"queued_io_jobs"_s;
     const QString KEY_TRANSFER_QUEUED_TRACKER_ANNOUNCES = u"queued_tracker_announces"_s;
     const QString KEY_TRANSFER_READ_CACHE_HITS = u"read_cache_hits"_s;
@@ -200,6 +208,12 @@ namespace
         // Tracker statistics
         map[KEY_TRANSFER_QUEUED_TRACKER_ANNOUNCES] = sessionStatus.queuedTrackerAnnounces;
 
+        // Session I/O statistics
+        map[KEY_TRANSFER_IO_QUEUED_JOBS] = sessionStatus.ioQueuedJobs;
+        map[KEY_TRANSFER_IO_AVERAGE_TIME] = sessionStatus.ioAverageJobTime;
+        map[KEY_TRANSFER_BULK_IO_QUEUED_JOBS] = sessionStatus.bulkIOQueuedJobs;
+        map[KEY_TRANSFER_BULK_IO_AVERAGE_TIME] = sessionStatus.bulkIOAverageJobTime;
+
         return map;
     }
 
@@ -450,6 +464,12 @@ namespace
     }
 }
 
+SyncController::~SyncController()
+{
+    if (m_maindataStream)
+        m_maindataStream->close();
+}
+
 void SyncController::updateFreeDiskSpace(const qint64 freeDiskSpace)
 {
     m_freeDiskSpace = freeDiskSpace;
@@ -526,34 +546,18 @@ void SyncController::updateFreeDiskSpace(const qint64 freeDiskSpace)
 //   - rid (int): last response id
 void SyncController::maindataAction()
 {
-    if (m_maindataAcceptedID < 0)
+    // Polling and streaming share the same sync state so they can't be mixed within a session
+    if (m_maindataStream)
     {
-        makeMaindataSnapshot();
-
-        const auto *btSession = BitTorrent::Session::instance();
-        connect(btSession, &BitTorrent::Session::categoryAdded, this, &SyncController::onCategoryAdded);
-        connect(btSession, &BitTorrent::Session::categoryRemoved, this, &SyncController::onCategoryRemoved);
-        connect(btSession, &BitTorrent::Session::categoryOptionsChanged, this, &SyncController::onCategoryOptionsChanged);
-        connect(btSession, &BitTorrent::Session::subcategoriesSupportChanged, this, &SyncController::onSubcategoriesSupportChanged);
-        connect(btSession, &BitTorrent::Session::tagAdded, this, &SyncController::onTagAdded);
-        connect(btSession, &BitTorrent::Session::tagRemoved, this, &SyncController::onTagRemoved);
-        connect(btSession, &BitTorrent::Session::torrentAdded, this, &SyncController::onTorrentAdded);
-        connect(btSession, &BitTorrent::Session::torrentAboutToBeRemoved, this, &SyncController::onTorrentAboutToBeRemoved);
-        connect(btSession, &BitTorrent::Session::torrentCategoryChanged, this, &SyncController::onTorrentCategoryChanged);
-        connect(btSession, &BitTorrent::Session::torrentMetadataReceived, this, &SyncController::onTorrentMetadataReceived);
-        connect(btSession, &BitTorrent::Session::torrentStopped, this, &SyncController::onTorrentStopped);
-        connect(btSession, &BitTorrent::Session::torrentStarted, this, &SyncController::onTorrentStarted);
-        connect(btSession, &BitTorrent::Session::torrentSavePathChanged, this, &SyncController::onTorrentSavePathChanged);
-        connect(btSession, &BitTorrent::Session::torrentSavingModeChanged, this, &SyncController::onTorrentSavingModeChanged);
-        connect(btSession, &BitTorrent::Session::torrentTagAdded, this, &SyncController::onTorrentTagAdded);
-        connect(btSession, &BitTorrent::Session::torrentTagRemoved, this, &SyncController::onTorrentTagRemoved);
-        connect(btSession, &BitTorrent::Session::torrentsUpdated, this, &SyncController::onTorrentsUpdated);
-        connect(btSession, &BitTorrent::Session::trackersAdded, this, &SyncController::onTorrentTrackersChanged);
-        connect(btSession, &BitTorrent::Session::trackersRemoved, this, &SyncController::onTorrentTrackersChanged);
-        connect(btSession, &BitTorrent::Session::trackersReset, this, &SyncController::onTorrentTrackersChanged);
-        connect(btSession, &BitTorrent::Session::trackerEntryStatusesUpdated, this, &SyncController::onTorrentTrackerEntryStatusesUpdated);
+        if (!m_maindataStream->isClosed())
+            throw APIError(APIErrorType::Conflict, tr("Main data is being streamed in this session"));
+
+        m_maindataStream.reset();
     }
 
+    if (m_maindataAcceptedID < 0)
+        startMaindataTracking();
+
     const int acceptedID = params()[u"rid"_s].toInt();
     bool fullUpdate = true;
     if ((acceptedID > 0) && (m_maindataLastSentID > 0))
@@ -576,6 +580,59 @@ void SyncController::maindataAction()
     m_maindataLastSentID = id;
 }
 
+// Pushes the same data as maindataAction() as server-sent events.
+// The first event is a full update, each subsequent event contains the changes
+// accumulated since the previous one. Events are sent when session statistics are refreshed,
+// unless the client is still receiving the previous event, in which case the changes
+// are coalesced into the next one. Only one stream per session is served, opening a new
+// one closes the previous stream, and sync/maindata can't be polled while it is open.
+// Event "id" field matches "rid" of the data.
+void SyncController::maindataStreamAction()
+{
+    setEventStreamResult([this](std::shared_ptr<Http::ResponseStream> stream)
+    {
+        if (m_maindataStream)
+            m_maindataStream->close();
+        m_maindataStream = std::move(stream);
+
+        if (m_maindataAcceptedID < 0)
+            startMaindataTracking();
+
+        sendMaindataStreamEvent(true);
+
+        connect(BitTorrent::Session::instance(), &BitTorrent::Session::statsUpdated
+                , this, &SyncController::onSessionStatsUpdated, Qt::UniqueConnection);
+    });
+}
+
+void SyncController::startMaindataTracking()
+{
+    makeMaindataSnapshot();
+
+    const auto *btSession = BitTorrent::Session::instance();
+    connect(btSession, &BitTorrent::Session::categoryAdded, this, &SyncController::onCategoryAdded);
+    connect(btSession, &BitTorrent::Session::categoryRemoved, this, &SyncController::onCategoryRemoved);
+    connect(btSession, &BitTorrent::Session::categoryOptionsChanged, this, &SyncController::onCategoryOptionsChanged);
+    connect(btSession, &BitTorrent::Session::subcategoriesSupportChanged, this, &SyncController::onSubcategoriesSupportChanged);
+    connect(btSession, &BitTorrent::Session::tagAdded, this, &SyncController::onTagAdded);
+    connect(btSession, &BitTorrent::Session::tagRemoved, this, &SyncController::onTagRemoved);
+    connect(btSession, &BitTorrent::Session::torrentAdded, this, &SyncController::onTorrentAdded);
+    connect(btSession, &BitTorrent::Session::torrentAboutToBeRemoved, this, &SyncController::onTorrentAboutToBeRemoved);
+    connect(btSession, &BitTorrent::Session::torrentCategoryChanged, this, &SyncController::onTorrentCategoryChanged);
+    connect(btSession, &BitTorrent::Session::torrentMetadataReceived, this, &SyncController::onTorrentMetadataReceived);
+    connect(btSession, &BitTorrent::Session::torrentStopped, this, &SyncController::onTorrentStopped);
+    connect(btSession, &BitTorrent::Session::torrentStarted, this, &SyncController::onTorrentStarted);
+    connect(btSession, &BitTorrent::Session::torrentSavePathChanged, this, &SyncController::onTorrentSavePathChanged);
+    connect(btSession, &BitTorrent::Session::torrentSavingModeChanged, this, &SyncController::onTorrentSavingModeChanged);
+    connect(btSession, &BitTorrent::Session::torrentTagAdded, this, &SyncController::onTorrentTagAdded);
+    connect(btSession, &BitTorrent::Session::torrentTagRemoved, this, &SyncController::onTorrentTagRemoved);
+    connect(btSession, &BitTorrent::Session::torrentsUpdated, this, &SyncController::onTorrentsUpdated);
+    connect(btSession, &BitTorrent::Session::trackersAdded, this, &SyncController::onTorrentTrackersChanged);
+    connect(btSession, &BitTorrent::Session::trackersRemoved, this, &SyncController::onTorrentTrackersChanged);
+    connect(btSession, &BitTorrent::Session::trackersReset, this, &SyncController::onTorrentTrackersChanged);
+    connect(btSession, &BitTorrent::Session::trackerEntryStatusesUpdated, this, &SyncController::onTorrentTrackerEntryStatusesUpdated);
+}
+
 void SyncController::makeMaindataSnapshot()
 {
     m_knownTrackers.clear();
@@ -828,6 +885,54 @@ QJsonObject SyncController::generateMaindataSyncData(const int id, const bool fu
     return syncData;
 }
 
+void SyncController::sendMaindataStreamEvent(const bool fullUpdate)
+{
+    const int id = (m_maindataLastSentID % 1000000) + 1;  // cycle between 1 and 1000000
+    const QJsonObject syncData = generateMaindataSyncData(id, fullUpdate);
+    // don't bother client with "rid" only events
+    if (!fullUpdate && (syncData.size() == 1))
+    {
+        // keep intermediate proxies from dropping idle connection
+        if (m_maindataStreamIdleTimer.hasExpired(MAINDATA_STREAM_HEARTBEAT_INTERVAL))
+        {
+            m_maindataStream->write(":\n\n");
+            m_maindataStreamIdleTimer.start();
+            emit maindataStreamEventSent();
+        }
+        return;
+    }
+
+    const QByteArray event = "id: " + QByteArray::number(id)
+        + "\ndata: " + QJsonDocument(syncData).toJson(QJsonDocument::Compact) + "\n\n";
+    m_maindataStream->write(event);
+    m_maindataStreamIdleTimer.start();
+    emit maindataStreamEventSent();
+
+    // Data is considered to be accepted by client as soon as it is sent
+    // since stream delivers events in order and without gaps
+    m_maindataLastSentID = id;
+    m_maindataAcceptedID = id;
+    m_maindataSyncBuf = {};
+}
+
+void SyncController::onSessionStatsUpdated()
+{
+    if (!m_maindataStream)
+        return;
+
+    if (m_maindataStream->isClosed())
+    {
+        m_maindataStream.reset();
+        return;
+    }
+
+    // Client hasn't received previous event yet, let the changes accumulate
+    if (m_maindataStream->pendingDataSize() > 0)
+        return;
+
+    sendMaindataStreamEvent(false);
+}
+
 // GET param:
 //   - hash (string): torrent hash (ID)
 //   - rid (int): last response id
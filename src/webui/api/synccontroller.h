@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <memory>
+
+#include <QElapsedTimer>
 #include <QSet>
 #include <QVariantMap>
 
@@ -48,16 +51,28 @@ class SyncController : public APIController
 
     using APIController::APIController;
 
+public:
+    ~SyncController() override;
+
 public slots:
     void updateFreeDiskSpace(qint64 freeDiskSpace);
 
+signals:
+    // Session is considered to be active while it's receiving stream events
+    void maindataStreamEventSent();
+
 private slots:
     void maindataAction();
+    void maindataStreamAction();
     void torrentPeersAction();
 
 private:
+    void startMaindataTracking();
     void makeMaindataSnapshot();
     QJsonObject generateMaindataSyncData(int id, bool fullUpdate);
+    void sendMaindataStreamEvent(bool fullUpdate);
+
+    void onSessionStatsUpdated();
 
     void onCategoryAdded(const QString &categoryName);
     void onCategoryRemoved(const QString &categoryName);
@@ -118,4 +133,7 @@ private:
     MaindataSyncBuf m_maindataSyncBuf;
     int m_maindataLastSentID = 0;
     int m_maindataAcceptedID = -1;
+
+    std::shared_ptr<Http::ResponseStream> m_maindataStream;
+    QElapsedTimer m_maindataStreamIdleTimer;
 };
@@ -246,7 +246,7 @@ void TorrentCreatorController::torrentFileAction()
     if (task->isFailed())
         throw APIError(APIErrorType::Conflict, tr("Torrent creation failed."));
 
-    const auto readResult = Utils::IO::readFile(task->result().torrentFilePath, Preferences::instance()->getTorrentFileSizeLimit());
+    const auto readResult = Utils::IO::readFile(task->result().torrentFilePath, Preferences::instance()->snapshot()->torrentFileSizeLimit);
     if (!readResult)
         throw APIError(APIErrorType::Conflict, readResult.error().message);
 
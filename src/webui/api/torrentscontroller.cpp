@@ -57,6 +57,7 @@
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/net/downloadmanager.h"
+#include "base/path.h"
 #include "base/preferences.h"
 #include "base/search/searchdownloadhandler.h"
 #include "base/search/searchpluginmanager.h"
@@ -132,6 +133,7 @@ const QString KEY_PROP_SSL_PRIVATEKEY = u"ssl_private_key"_s;
 const QString KEY_PROP_SSL_DHPARAMS = u"ssl_dh_params"_s;
 const QString KEY_PROP_HAS_METADATA = u"has_metadata"_s;
 const QString KEY_PROP_PROGRESS = u"progress"_s;
+const QString KEY_PROP_FILES_MEMORY_USAGE = u"files_memory_usage"_s;
 const QString KEY_PROP_FILES = u"files"_s;
 const QString KEY_PROP_TRACKERS = u"trackers"_s;
 
@@ -145,6 +147,16 @@ const QString KEY_FILE_PRIORITY = u"priority"_s;
 const QString KEY_FILE_IS_SEED = u"is_seed"_s;
 const QString KEY_FILE_PIECE_RANGE = u"piece_range"_s;
 const QString KEY_FILE_AVAILABILITY = u"availability"_s;
+const QString KEY_FILE_REMAINING = u"remaining"_s;
+const QString KEY_FILE_IS_FOLDER = u"is_folder"_s;
+const QString KEY_FILE_FILES_COUNT = u"files_count"_s;
+
+// File tree keys
+const QString KEY_FILE_TREE_RID = u"rid"_s;
+const QString KEY_FILE_TREE_FULL_UPDATE = u"full_update"_s;
+const QString KEY_FILE_TREE_TOTAL = u"total"_s;
+const QString KEY_FILE_TREE_NODES = u"nodes"_s;
+const QString KEY_FILE_TREE_NODES_REMOVED = u"nodes_removed"_s;
 
 // Torrent info
 const QString KEY_TORRENTINFO_FILE_LENGTH = u"length"_s;
@@ -163,6 +175,8 @@ namespace
     using Utils::String::parseDouble;
 
     const QSet<QString> SUPPORTED_WEB_SEED_SCHEMES {u"http"_s, u"https"_s, u"ftp"_s};
+    const qsizetype MAX_FILE_TREE_SNAPSHOTS = 32;
+    const qsizetype MAX_FILE_TREE_INDEXES = 8;
 
     template <typename Func>
     void applyToTorrents(const QStringList &idList, Func func)
@@ -372,6 +386,83 @@ namespace
         return fileList;
     }
 
+    // Direct child of a folder, folder values are aggregated over all files inside it
+    struct FileTreeNode
+    {
+        QString name;
+        int fileIndex = -1;
+        int filesCount = 0;
+        qlonglong size = 0;
+        qlonglong wantedSize = 0;
+        qreal wantedProgress = 0;
+        qlonglong remaining = 0;
+        qreal availability = 0;
+        bool hasAvailability = false;
+        BitTorrent::DownloadPriority priority = BitTorrent::DownloadPriority::Normal;
+    };
+
+    FileTreeNode makeFileTreeNode(const BitTorrent::Torrent *torrent, const QString &name, const bool isFolder
+            , const QList<int> &fileIndexes, const QList<BitTorrent::DownloadPriority> &priorities
+            , const QList<qreal> &filesProgress, const QList<qreal> &fileAvailability)
+    {
+        Q_ASSERT(!fileIndexes.isEmpty());
+
+        FileTreeNode node {.name = name, .fileIndex = (isFolder ? -1 : fileIndexes.first())
+                , .filesCount = static_cast<int>(fileIndexes.size()), .priority = priorities[fileIndexes.first()]};
+        for (const int index : fileIndexes)
+        {
+            const qlonglong fileSize = torrent->fileSize(index);
+            node.size += fileSize;
+            if (node.priority != priorities[index])
+                node.priority = BitTorrent::DownloadPriority::Mixed;
+
+            // Same as in GUI, ignored files don't affect folder progress and availability
+            if (priorities[index] == BitTorrent::DownloadPriority::Ignored)
+                continue;
+
+            const qreal progress = filesProgress[index];
+            node.wantedSize += fileSize;
+            node.wantedProgress += progress * fileSize;
+            node.remaining += static_cast<qlonglong>(fileSize * (1 - progress));
+
+            const qreal availability = fileAvailability.value(index, -1);
+            if (availability >= 0)
+            {
+                node.availability += availability * fileSize;
+                node.hasAvailability = true;
+            }
+        }
+
+        return node;
+    }
+
+    QJsonObject serializeFileTreeNode(const FileTreeNode &node, const bool withAvailability)
+    {
+        const bool isFolder = (node.fileIndex < 0);
+        QJsonObject result
+        {
+            {KEY_FILE_NAME, node.name},
+            {KEY_FILE_IS_FOLDER, isFolder},
+            {KEY_FILE_SIZE, node.size},
+            {KEY_FILE_PROGRESS, ((node.wantedSize > 0) ? (node.wantedProgress / node.wantedSize) : 1.0)},
+            {KEY_FILE_PRIORITY, static_cast<int>(node.priority)},
+            {KEY_FILE_REMAINING, node.remaining}
+        };
+
+        if (isFolder)
+            result.insert(KEY_FILE_FILES_COUNT, node.filesCount);
+        else
+            result.insert(KEY_FILE_INDEX, node.fileIndex);
+
+        if (withAvailability)
+        {
+            const bool hasAvailability = (node.wantedSize > 0) && node.hasAvailability;
+            result.insert(KEY_FILE_AVAILABILITY, (hasAvailability ? (node.availability / node.wantedSize) : -1));
+        }
+
+        return result;
+    }
+
     QList<BitTorrent::TorrentID> toTorrentIDs(const QStringList &idStrings)
     {
         QList<BitTorrent::TorrentID> idList;
@@ -563,7 +654,12 @@ namespace
 TorrentsController::TorrentsController(IApplication *app, QObject *parent)
     : APIController(app, parent)
 {
-    connect(BitTorrent::Session::instance(), &BitTorrent::Session::metadataDownloaded, this, &TorrentsController::onMetadataDownloaded);
+    const auto *btSession = BitTorrent::Session::instance();
+    connect(btSession, &BitTorrent::Session::metadataDownloaded, this, &TorrentsController::onMetadataDownloaded);
+    connect(btSession, &BitTorrent::Session::torrentMetadataReceived, this, &TorrentsController::invalidateFileTreeIndex);
+    connect(btSession, &BitTorrent::Session::torrentAboutToBeRemoved, this, &TorrentsController::invalidateFileTreeIndex);
+    connect(btSession, &BitTorrent::Session::torrentContentFileRenamed, this, &TorrentsController::invalidateFileTreeIndex);
+    connect(btSession, &BitTorrent::Session::torrentContentFolderRenamed, this, &TorrentsController::invalidateFileTreeIndex);
 }
 
 void TorrentsController::countAction()
@@ -746,6 +842,7 @@ void TorrentsController::infoAction()
 //   - "infohash_v2": Torrent v2 infohash (or empty string for v1 torrents)
 //   - "hash": Torrent TorrentID (infohashv1 for v1 torrents, truncated infohashv2 for v2/hybrid torrents)
 //   - "name": Torrent name
+//   - "files_memory_usage": Memory used to keep track of torrent files, in bytes
 void TorrentsController::propertiesAction()
 {
     requireParams({u"hash"_s});
@@ -812,7 +909,8 @@ void TorrentsController::propertiesAction()
         {KEY_PROP_DOWNLOAD_PATH, torrent->downloadPath().toString()},
         {KEY_PROP_COMMENT, torrent->comment()},
         {KEY_PROP_HAS_METADATA, torrent->hasMetadata()},
-        {KEY_PROP_PROGRESS, torrent->progress()}
+        {KEY_PROP_PROGRESS, torrent->progress()},
+        {KEY_PROP_FILES_MEMORY_USAGE, torrent->filesMemoryUsage()}
     };
 
     setResult(ret);
@@ -1008,6 +1106,166 @@ void TorrentsController::filesAction()
     setResult(fileList);
 }
 
+// Returns the direct children of a torrent folder in JSON format.
+// Folder nodes are aggregated over all the files inside them.
+// The return value is a JSON-formatted dictionary with the following fields:
+//   - "rid": Response ID, pass it back to receive only the changes of the same view
+//   - "full_update": Whether "nodes" contains the whole page or only the changed nodes
+//   - "total": Number of children of the folder
+//   - "nodes": List of nodes, each with "name", "is_folder", "size", "progress", "priority",
+//        "remaining", optional "availability" and either "index" (files) or "files_count" (folders)
+//   - "nodes_removed": Names of the nodes removed since the previous response (if not full update)
+// GET params:
+//   - hash (string): torrent hash
+//   - path (string): folder path, empty means the torrent root
+//   - offset (int): index of the first child to return
+//   - limit (int): maximum number of children to return (if greater than 0, otherwise - unlimited)
+//   - availability (bool): include availability of the nodes, it is expensive to calculate
+//   - rid (int): last response ID
+void TorrentsController::fileTreeAction()
+{
+    requireParams({u"hash"_s});
+
+    const auto id = BitTorrent::TorrentID::fromString(params()[u"hash"_s]);
+    const BitTorrent::Torrent *const torrent = BitTorrent::Session::instance()->getTorrent(id);
+    if (!torrent)
+        throw APIError(APIErrorType::NotFound);
+
+    const QString folderPath = Path(params()[u"path"_s]).data();
+    const int offset = params()[u"offset"_s].toInt();
+    const int limit = params()[u"limit"_s].toInt();
+    const bool withAvailability = parseBool(params()[u"availability"_s]).value_or(false);
+    const int rid = params()[u"rid"_s].toInt();
+    if (offset < 0)
+        throw APIError(APIErrorType::BadParams, tr("'offset' parameter is invalid"));
+
+    qsizetype total = 0;
+    QList<FileTreeNode> page;
+    if (torrent->hasMetadata())
+    {
+        const FileTreeIndex &index = fileTreeIndex(torrent);
+        const auto folderIt = index.folders.constFind(folderPath);
+        if (folderIt == index.folders.cend())
+        {
+            if (!folderPath.isEmpty())
+                throw APIError(APIErrorType::NotFound, tr("Folder \"%1\" doesn't exist").arg(folderPath));
+        }
+        else
+        {
+            // Only the nodes of the requested page are calculated
+            const QList<FileTreeIndex::Child> &children = folderIt.value();
+            total = children.size();
+            const qsizetype pageEnd = (limit > 0) ? std::min(total, (static_cast<qsizetype>(offset) + limit)) : total;
+            if (offset < pageEnd)
+            {
+                const QList<BitTorrent::DownloadPriority> priorities = torrent->filePriorities();
+                const QList<qreal> filesProgress = torrent->filesProgress();
+                const QList<qreal> fileAvailability = withAvailability
+                        ? torrent->fetchAvailableFileFractions().takeResult() : QList<qreal>();
+
+                page.reserve(pageEnd - offset);
+                for (qsizetype i = offset; i < pageEnd; ++i)
+                {
+                    const FileTreeIndex::Child &child = children[i];
+                    page.append(makeFileTreeNode(torrent, child.name, child.isFolder, child.fileIndexes
+                            , priorities, filesProgress, fileAvailability));
+                }
+            }
+        }
+    }
+
+    // Each page of each folder view is tracked separately, so the client can keep several views up to date
+    const QString snapshotKey = u"%1|%2|%3|%4|%5"_s.arg(id.toString(), folderPath, QString::number(offset)
+            , QString::number(limit), (withAvailability ? u"1"_s : u"0"_s));
+    const auto snapshotIt = m_fileTreeSnapshots.constFind(snapshotKey);
+    const bool isFullUpdate = (rid == 0) || (snapshotIt == m_fileTreeSnapshots.cend()) || (snapshotIt->rid != rid);
+
+    FileTreeSnapshot snapshot {.rid = ++m_fileTreeRevision};
+    snapshot.nodes.reserve(page.size());
+    QJsonArray changedNodes;
+    for (const FileTreeNode &node : page)
+    {
+        const QJsonObject serializedNode = serializeFileTreeNode(node, withAvailability);
+        if (isFullUpdate || (snapshotIt->nodes.value(node.name) != serializedNode))
+            changedNodes.append(serializedNode);
+        snapshot.nodes.insert(node.name, serializedNode);
+    }
+
+    QJsonObject result
+    {
+        {KEY_FILE_TREE_RID, snapshot.rid},
+        {KEY_FILE_TREE_FULL_UPDATE, isFullUpdate},
+        {KEY_FILE_TREE_TOTAL, total},
+        {KEY_FILE_TREE_NODES, changedNodes}
+    };
+
+    if (!isFullUpdate)
+    {
+        QJsonArray removedNodes;
+        for (auto it = snapshotIt->nodes.cbegin(); it != snapshotIt->nodes.cend(); ++it)
+        {
+            if (!snapshot.nodes.contains(it.key()))
+                removedNodes.append(it.key());
+        }
+        result.insert(KEY_FILE_TREE_NODES_REMOVED, removedNodes);
+    }
+
+    if ((m_fileTreeSnapshots.size() >= MAX_FILE_TREE_SNAPSHOTS) && !m_fileTreeSnapshots.contains(snapshotKey))
+        m_fileTreeSnapshots.clear();
+    m_fileTreeSnapshots.insert(snapshotKey, std::move(snapshot));
+
+    setResult(result);
+}
+
+const TorrentsController::FileTreeIndex &TorrentsController::fileTreeIndex(const BitTorrent::Torrent *torrent)
+{
+    const BitTorrent::TorrentID id = torrent->id();
+    if (const auto indexIt = m_fileTreeIndexes.constFind(id); indexIt != m_fileTreeIndexes.cend())
+        return indexIt.value();
+
+    if (m_fileTreeIndexes.size() >= MAX_FILE_TREE_INDEXES)
+        m_fileTreeIndexes.clear();
+
+    FileTreeIndex index;
+    // position of each child within its folder, keyed by the child path
+    QHash<QString, qsizetype> childPositions;
+    const PathList filePaths = torrent->filePaths();
+    for (int fileIndex = 0; fileIndex < filePaths.size(); ++fileIndex)
+    {
+        const QString filePath = filePaths[fileIndex].data();
+        qsizetype folderEnd = 0;
+        while (true)
+        {
+            const QString folderPath = filePath.first(folderEnd);
+            const qsizetype nameBegin = (folderEnd > 0) ? (folderEnd + 1) : 0;
+            const qsizetype separatorPos = filePath.indexOf(u'/', nameBegin);
+            const bool isFolder = (separatorPos >= 0);
+            const qsizetype childEnd = isFolder ? separatorPos : filePath.size();
+
+            QList<FileTreeIndex::Child> &children = index.folders[folderPath];
+            const QString childPath = filePath.first(childEnd);
+            auto positionIt = childPositions.find(childPath);
+            if (positionIt == childPositions.end())
+            {
+                positionIt = childPositions.insert(childPath, children.size());
+                children.append({.name = filePath.sliced(nameBegin, (childEnd - nameBegin)), .isFolder = isFolder});
+            }
+            children[positionIt.value()].fileIndexes.append(fileIndex);
+
+            if (!isFolder)
+                break;
+            folderEnd = separatorPos;
+        }
+    }
+
+    return *m_fileTreeIndexes.insert(id, std::move(index));
+}
+
+void TorrentsController::invalidateFileTreeIndex(const BitTorrent::Torrent *torrent)
+{
+    m_fileTreeIndexes.remove(torrent->id());
+}
+
 // Returns an array of hashes (of each pieces respectively) for a torrent in JSON format.
 // The return value is a JSON-formatted array of strings (hex strings).
 void TorrentsController::pieceHashesAction()
@@ -1254,24 +1512,29 @@ void TorrentsController::addAction()
     }
 
     // process uploaded .torrent files
+    QList<std::pair<BitTorrent::TorrentDescriptor, BitTorrent::AddTorrentParams>> uploadedTorrents;
+    uploadedTorrents.reserve(torrents.size());
     for (auto it = torrents.constBegin(); it != torrents.constEnd(); ++it)
     {
-        if (const auto loadResult = BitTorrent::TorrentDescriptor::load(it.value()))
-        {
-            const BitTorrent::TorrentDescriptor &torrentDescr = loadResult.value();
-            if (BitTorrent::Session::instance()->addTorrent(torrentDescr, addTorrentParams))
-            {
-                addedTorrentIDs.append(torrentDescr.infoHash().toTorrentID());
-            }
-            else
-            {
-                ++failure;
-            }
-        }
+        if (auto loadResult = BitTorrent::TorrentDescriptor::load(it.value()))
+            uploadedTorrents.emplaceBack(std::move(loadResult.value()), addTorrentParams);
         else
-        {
             throw APIError(APIErrorType::BadData, tr("Error: '%1' is not a valid torrent file.").arg(it.key()));
-        }
+    }
+
+    if (uploadedTorrents.size() == 1)
+    {
+        const BitTorrent::TorrentDescriptor &torrentDescr = uploadedTorrents[0].first;
+        if (BitTorrent::Session::instance()->addTorrent(torrentDescr, addTorrentParams))
+            addedTorrentIDs.append(torrentDescr.infoHash().toTorrentID());
+        else
+            ++failure;
+    }
+    else if (!uploadedTorrents.isEmpty())
+    {
+        // torrents are added in background so the result of adding them isn't known yet
+        BitTorrent::Session::instance()->addTorrents(uploadedTorrents);
+        pending += static_cast<int>(uploadedTorrents.size());
     }
 
     if (!addedTorrentIDs.isEmpty() || (pending > 0))
@@ -2425,7 +2688,7 @@ void TorrentsController::onSearchPluginTorrentDownloaded(const QString &source,
         cacheMagnetURI(source, parseResult.value());
     }
     // path to .torrent file
-    else if (const auto readResult = Utils::IO::readFile(Path(data), Preferences::instance()->getTorrentFileSizeLimit()))
+    else if (const auto readResult = Utils::IO::readFile(Path(data), Preferences::instance()->snapshot()->torrentFileSizeLimit))
     {
         cacheTorrentFile(source, readResult.value());
     }
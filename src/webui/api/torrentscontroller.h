@@ -29,6 +29,7 @@
 #pragma once
 
 #include <QHash>
+#include <QJsonObject>
 #include <QSet>
 
 #include "base/bittorrent/torrentdescriptor.h"
@@ -39,6 +40,7 @@ class QByteArray;
 namespace BitTorrent
 {
     class InfoHash;
+    class Torrent;
     class TorrentID;
     class TorrentInfo;
 }
@@ -66,6 +68,7 @@ private slots:
     void editWebSeedAction();
     void removeWebSeedsAction();
     void filesAction();
+    void fileTreeAction();
     void pieceHashesAction();
     void pieceStatesAction();
     void pieceAvailabilityAction();
@@ -121,6 +124,30 @@ private slots:
     void downloadFileAction();
 
 private:
+    struct FileTreeSnapshot
+    {
+        int rid = 0;
+        QHash<QString, QJsonObject> nodes;
+    };
+
+    // Files of a torrent grouped by folder, so that a folder view doesn't need to go through all the files
+    struct FileTreeIndex
+    {
+        struct Child
+        {
+            QString name;
+            bool isFolder = false;
+            // files inside the child, in torrent order
+            QList<int> fileIndexes;
+        };
+
+        // children of each folder keyed by folder path, in order of their first file
+        QHash<QString, QList<Child>> folders;
+    };
+
+    const FileTreeIndex &fileTreeIndex(const BitTorrent::Torrent *torrent);
+    void invalidateFileTreeIndex(const BitTorrent::Torrent *torrent);
+
     void onDownloadFinished(const Net::DownloadResult &result);
     void onMetadataDownloaded(const BitTorrent::TorrentInfo &info);
     void onSearchPluginTorrentDownloaded(const QString &source, const QString &data);
@@ -130,4 +157,7 @@ private:
     QHash<QString, BitTorrent::InfoHash> m_torrentSourceCache;
     QHash<BitTorrent::TorrentID, BitTorrent::TorrentDescriptor> m_torrentMetadataCache;
     QSet<QString> m_requestedTorrentSource;
+    QHash<QString, FileTreeSnapshot> m_fileTreeSnapshots;
+    int m_fileTreeRevision = 0;
+    QHash<BitTorrent::TorrentID, FileTreeIndex> m_fileTreeIndexes;
 };
@@ -28,6 +28,7 @@
 
 #include "transfercontroller.h"
 
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
 
@@ -35,6 +36,7 @@
 #include "base/bittorrent/peerinfo.h"
 #include "base/bittorrent/session.h"
 #include "base/bittorrent/sessionstatus.h"
+#include "base/bittorrent/transferhistory.h"
 #include "base/global.h"
 #include "base/utils/string.h"
 #include "apierror.h"
@@ -54,6 +56,11 @@ const QString KEY_TRANSFER_DL_LIMIT = u"dl_limit"_s;
 const QString KEY_TRANSFER_ALT_UP_LIMIT = u"alt_up_limit"_s;
 const QString KEY_TRANSFER_ALT_DL_LIMIT = u"alt_dl_limit"_s;
 
+const QString KEY_HISTORY_SERIES = u"series"_s;
+const QString KEY_HISTORY_AVAILABLE_SERIES = u"available_series"_s;
+const QString KEY_HISTORY_INTERVAL = u"interval"_s;
+const QString KEY_HISTORY_SAMPLES = u"samples"_s;
+
 // Returns the global transfer information in JSON format.
 // The return value is a JSON-formatted dictionary.
 // The dictionary keys are:
@@ -190,3 +197,53 @@ void TransferController::banPeersAction()
 
     setResult(QString());
 }
+
+// Returns recorded transfer rates of a series
+// GET params:
+//   - series (string): "session" (default), "payload" or "category:<name>"
+//   - resolution (string): "second", "minute" (default) or "hour"
+//   - since (int): timestamp (in seconds since epoch) of the oldest sample to return
+// The dictionary keys are:
+//   - "series": Series name
+//   - "available_series": Names of all recorded series
+//   - "interval": Interval of samples (in seconds)
+//   - "samples": Array of [timestamp, download rate, upload rate] arrays
+void TransferController::historyAction()
+{
+    const QString series = params().value(u"series"_s, u"session"_s);
+    const QString resolutionParam = params().value(u"resolution"_s, u"minute"_s);
+
+    BitTorrent::TransferHistory::Resolution resolution = BitTorrent::TransferHistory::Resolution::Minute;
+    if (resolutionParam == u"second")
+        resolution = BitTorrent::TransferHistory::Resolution::Second;
+    else if (resolutionParam == u"hour")
+        resolution = BitTorrent::TransferHistory::Resolution::Hour;
+    else if (resolutionParam != u"minute")
+        throw APIError(APIErrorType::BadParams, tr("Invalid resolution"));
+
+    qint64 since = 0;
+    if (const QString sinceParam = params()[u"since"_s]; !sinceParam.isEmpty())
+    {
+        bool ok = false;
+        since = sinceParam.toLongLong(&ok);
+        if (!ok)
+            throw APIError(APIErrorType::BadParams, tr("Invalid since"));
+    }
+
+    const BitTorrent::TransferHistory &history = BitTorrent::Session::instance()->transferHistory();
+    const QStringList seriesNames = history.seriesNames();
+    if (!seriesNames.contains(series))
+        throw APIError(APIErrorType::NotFound);
+
+    const QList<BitTorrent::TransferHistory::Sample> samples = history.samples(series, resolution, since);
+    QJsonArray samplesArray;
+    for (const BitTorrent::TransferHistory::Sample &sample : samples)
+        samplesArray.append(QJsonArray {sample.time, sample.rates.download, sample.rates.upload});
+
+    setResult(QJsonObject {
+        {KEY_HISTORY_SERIES, series},
+        {KEY_HISTORY_AVAILABLE_SERIES, QJsonArray::fromStringList(seriesNames)},
+        {KEY_HISTORY_INTERVAL, BitTorrent::TransferHistory::resolutionSeconds(resolution)},
+        {KEY_HISTORY_SAMPLES, samplesArray}
+    });
+}
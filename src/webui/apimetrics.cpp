@@ -0,0 +1,55 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "apimetrics.h"
+
+#include <algorithm>
+
+#include "base/global.h"
+
+void APIMetrics::record(const QString &scope, const QString &action, const qint64 duration, const bool isFailed)
+{
+    EndpointStatistics &stats = m_statistics[{scope, action}];
+    ++stats.requestCount;
+    if (isFailed)
+        ++stats.failedRequestCount;
+    stats.totalDuration += duration;
+    stats.maxDuration = std::max(stats.maxDuration, duration);
+
+    const auto bucketIter = std::ranges::lower_bound(LATENCY_BUCKETS, duration);
+    ++stats.latencyHistogram[std::distance(LATENCY_BUCKETS.cbegin(), bucketIter)];
+}
+
+QHash<QString, APIMetrics::EndpointStatistics> APIMetrics::statistics() const
+{
+    QHash<QString, EndpointStatistics> result;
+    result.reserve(m_statistics.size());
+    for (auto it = m_statistics.cbegin(); it != m_statistics.cend(); ++it)
+        result.insert(u"%1/%2"_s.arg(it.key().first, it.key().second), it.value());
+    return result;
+}
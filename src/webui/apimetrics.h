@@ -0,0 +1,64 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include <QHash>
+#include <QString>
+
+// Collects request count and processing latency of WebAPI endpoints
+class APIMetrics
+{
+    Q_DISABLE_COPY_MOVE(APIMetrics)
+
+public:
+    // Upper bounds (inclusive) of latency histogram buckets, in microseconds.
+    // Extra bucket is used for longer durations.
+    static constexpr std::array<qint64, 10> LATENCY_BUCKETS {1'000, 2'500, 5'000, 10'000, 25'000, 50'000, 100'000, 250'000, 500'000, 1'000'000};
+
+    struct EndpointStatistics
+    {
+        qint64 requestCount = 0;
+        qint64 failedRequestCount = 0;
+        qint64 totalDuration = 0;  // microseconds
+        qint64 maxDuration = 0;  // microseconds
+        std::array<qint64, LATENCY_BUCKETS.size() + 1> latencyHistogram {};
+    };
+
+    APIMetrics() = default;
+
+    void record(const QString &scope, const QString &action, qint64 duration, bool isFailed);
+    // Keys are endpoint names in "scope/action" format
+    QHash<QString, EndpointStatistics> statistics() const;
+
+private:
+    QHash<std::pair<QString, QString>, EndpointStatistics> m_statistics;
+};
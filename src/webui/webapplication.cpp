@@ -29,17 +29,23 @@
 
 #include "webapplication.h"
 
+#include <exception>
+
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
 #include <QJsonDocument>
+#include <QLocale>
+#include <QMessageAuthenticationCode>
 #include <QMetaObject>
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QNetworkCookie>
 #include <QRegularExpression>
+#include <QScopeGuard>
 #include <QThread>
+#include <QThreadPool>
 #include <QUrl>
 
 #include "base/algorithm.h"
@@ -56,11 +62,13 @@
 #include "base/utils/io.h"
 #include "base/utils/misc.h"
 #include "base/utils/password.h"
+#include "base/utils/prometheus.h"
 #include "base/utils/random.h"
 #include "base/utils/string.h"
 #include "api/apierror.h"
 #include "api/appcontroller.h"
 #include "api/authcontroller.h"
+#include "api/batchcontroller.h"
 #include "api/clientdatacontroller.h"
 #include "api/logcontroller.h"
 #include "api/rsscontroller.h"
@@ -84,9 +92,26 @@ const QString BASIC_AUTH = u"Basic"_s;
 const QString BEARER_AUTH = u"Bearer"_s;
 
 const QString API_PATH = u"/api/v2/"_s;
+const QString METRICS_PATH = u"/metrics"_s;
+
+const std::chrono::seconds VERIFIED_CREDENTIALS_TTL = 1min;
+const int MAX_DEFERRED_REQUESTS = 1024;
+const int MAX_DEFERRED_REQUESTS_PER_CLIENT = 32;
 
 namespace
 {
+    QByteArray generateDigestKey()
+    {
+        QByteArray key;
+        key.reserve(32);
+        for (int i = 0; i < 8; ++i)
+        {
+            const quint32 value = Utils::Random::rand();
+            key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+        return key;
+    }
+
     QStringMap parseCookie(const QStringView cookieStr)
     {
         // [rfc6265] 4.2.1. Syntax
@@ -108,7 +133,7 @@ namespace
 
     std::tuple<QString, QString> parseAPIEndpoint(const QString &endpoint)
     {
-        const QRegularExpression apiEndpointPattern {u"^(?<scope>[A-Za-z_][A-Za-z_0-9]*)/(?<action>[A-Za-z_][A-Za-z_0-9]*)$"_s};
+        static const QRegularExpression apiEndpointPattern {u"^(?<scope>[A-Za-z_][A-Za-z_0-9]*)/(?<action>[A-Za-z_][A-Za-z_0-9]*)$"_s};
         if (const QRegularExpressionMatch match = apiEndpointPattern.match(endpoint); match.hasMatch())
             return std::make_tuple(match.captured(u"scope"), match.captured(u"action"));
 
@@ -173,10 +198,14 @@ WebApplication::WebApplication(IApplication *app, QObject *parent)
     , m_cacheID {QString::number(Utils::Random::rand(), 36)}
     , m_trRegex {u"QBT_TR\\((([^\\)]|\\)(?!QBT_TR))+)\\)QBT_TR\\[CONTEXT=([a-zA-Z_][a-zA-Z0-9_]*)\\]"_s}
     , m_authController {new AuthController(this, app, this)}
+    , m_credentialsVerifier {new QThreadPool(this)}
+    , m_basicAuthDigestKey {generateDigestKey()}
     , m_torrentCreationManager {new BitTorrent::TorrentCreationManager(app, this)}
     , m_clientDataStorage {new ClientDataStorage(this)}
 {
-    declarePublicAPI(u"auth/login"_s);
+    m_credentialsVerifier->setObjectName("WebApplication m_credentialsVerifier");
+
+    declarePublicAPI(u"auth"_s, u"login"_s);
 
     configure();
     connect(Preferences::instance(), &Preferences::changed, this, &WebApplication::configure);
@@ -184,6 +213,18 @@ WebApplication::WebApplication(IApplication *app, QObject *parent)
 
 WebApplication::~WebApplication()
 {
+    m_credentialsVerifier->clear();
+    m_credentialsVerifier->waitForDone();
+
+    for (const QList<DeferredRequest> &deferredRequests : asConst(m_deferredRequests))
+    {
+        for (const DeferredRequest &deferredRequest : deferredRequests)
+        {
+            if (deferredRequest.responseWriter)
+                deferredRequest.responseWriter->setResponse({.status = {.code = 503, .text = u"Service Unavailable"_s}});
+        }
+    }
+
     // cleanup sessions data
     qDeleteAll(m_sessions);
 }
@@ -308,12 +349,22 @@ const Http::Environment &WebApplication::env() const
 
 void WebApplication::setUsername(const QString &username)
 {
+    if (username == m_username)
+        return;
+
     m_username = username;
+    ++m_credentialsVersion;
+    m_verifiedCredentials.clear();
 }
 
 void WebApplication::setPasswordHash(const QByteArray &passwordHash)
 {
+    if (passwordHash == m_passwordHash)
+        return;
+
     m_passwordHash = passwordHash;
+    ++m_credentialsVersion;
+    m_verifiedCredentials.clear();
 }
 
 void WebApplication::processAPIRequest(const QString &endpoint, const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter)
@@ -374,6 +425,20 @@ void WebApplication::processAPIRequest(const QString &endpoint, const Http::Head
     for (const Http::UploadedFile &torrent : request().files)
         data[torrent.filename] = torrent.data;
 
+    // Only existing endpoints are accounted so arbitrary requests cannot bloat the metrics
+    const bool isMetered = controller->hasAction(action);
+    QElapsedTimer processingTimer;
+    processingTimer.start();
+    [[maybe_unused]] const auto metricsGuard = qScopeGuard([this, &apiScope = scope, &apiAction = action, isMetered
+            , &processingTimer, exceptionCount = std::uncaught_exceptions()]
+    {
+        if (isMetered)
+        {
+            const bool isFailed = (std::uncaught_exceptions() > exceptionCount);
+            m_apiMetrics.record(apiScope, apiAction, (processingTimer.nsecsElapsed() / 1000), isFailed);
+        }
+    });
+
     try
     {
         const APIResult apiResult = controller->run(action, params, data);
@@ -384,6 +449,15 @@ void WebApplication::processAPIRequest(const QString &endpoint, const Http::Head
             return;
         }
 
+        if (std::holds_alternative<EventStreamAPIResult>(apiResult))
+        {
+            const auto result = std::get<EventStreamAPIResult>(apiResult);
+            Http::HeaderMap headers = commonHeaders;
+            headers.insert(Http::HEADER_CONTENT_TYPE, Http::CONTENT_TYPE_EVENT_STREAM);
+            result.handler(responseWriter.openStream(headers));
+            return;
+        }
+
         Http::Response response {.headers = commonHeaders};
 
         if (m_sessionStateChange == SessionStateChange::Start)
@@ -607,9 +681,9 @@ void WebApplication::configure()
         m_apiKey = apiKey;
 }
 
-void WebApplication::declarePublicAPI(const QString &apiPath)
+void WebApplication::declarePublicAPI(const QString &scope, const QString &action)
 {
-    m_publicAPIs << apiPath;
+    m_publicAPIs.insert({scope, action});
 }
 
 void WebApplication::sendFile(const Path &path, const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter)
@@ -708,9 +782,15 @@ void WebApplication::processRequest(const Http::Request &request, const Http::En
         m_clientAddress = resolveClientAddress();
 
         if (isUsingApiKey)
+        {
             apiKeySessionInitialize(authData);
-        else
-            cookieSessionInitialize(authScheme, authData);
+        }
+        else if (!cookieSessionInitialize(authScheme, authData))
+        {
+            // request is processed again once credentials are verified
+            verifyBasicAuth(authData, request, env, responseWriter);
+            return;
+        }
 
         if (!isUsingApiKey)
             setSessionCookie(commonHeaders);
@@ -724,6 +804,15 @@ void WebApplication::processRequest(const Http::Request &request, const Http::En
 
             processAPIRequest(endpoint, commonHeaders, responseWriter);
         }
+        else if (request.path == METRICS_PATH)
+        {
+            if (!session())
+                throw ForbiddenHTTPError();
+            if ((m_request.method != Http::HEADER_REQUEST_METHOD_GET) && (m_request.method != Http::HEADER_REQUEST_METHOD_HEAD))
+                throw MethodNotAllowedHTTPError();
+
+            sendMetrics(commonHeaders, responseWriter);
+        }
         else
         {
             if (isUsingApiKey)
@@ -742,6 +831,44 @@ void WebApplication::processRequest(const Http::Request &request, const Http::En
     }
 }
 
+void WebApplication::sendMetrics(const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter)
+{
+    using Utils::Prometheus::MetricType;
+    Utils::Prometheus::TextWriter writer;
+
+    const QHash<QString, APIMetrics::EndpointStatistics> statistics = m_apiMetrics.statistics();
+    QStringList endpoints = statistics.keys();
+    endpoints.sort();
+
+    writer.addMetric("qbittorrent_webui_request_duration_seconds", MetricType::Histogram, "Processing time of WebAPI requests");
+    for (const QString &endpoint : asConst(endpoints))
+    {
+        const APIMetrics::EndpointStatistics &endpointStatistics = statistics[endpoint];
+
+        qint64 cumulativeCount = 0;
+        for (std::size_t i = 0; i < APIMetrics::LATENCY_BUCKETS.size(); ++i)
+        {
+            cumulativeCount += endpointStatistics.latencyHistogram[i];
+            const QString upperBound = QString::number((APIMetrics::LATENCY_BUCKETS[i] / 1e6), 'g', QLocale::FloatingPointShortest);
+            writer.addSample("qbittorrent_webui_request_duration_seconds_bucket", cumulativeCount
+                , {{u"endpoint"_s, endpoint}, {u"le"_s, upperBound}});
+        }
+        writer.addSample("qbittorrent_webui_request_duration_seconds_bucket", endpointStatistics.requestCount
+            , {{u"endpoint"_s, endpoint}, {u"le"_s, u"+Inf"_s}});
+        writer.addSample("qbittorrent_webui_request_duration_seconds_sum", (endpointStatistics.totalDuration / 1e6), {{u"endpoint"_s, endpoint}});
+        writer.addSample("qbittorrent_webui_request_duration_seconds_count", endpointStatistics.requestCount, {{u"endpoint"_s, endpoint}});
+    }
+
+    writer.addMetric("qbittorrent_webui_request_failures_total", MetricType::Counter, "Number of failed WebAPI requests");
+    for (const QString &endpoint : asConst(endpoints))
+        writer.addSample("qbittorrent_webui_request_failures_total", statistics[endpoint].failedRequestCount, {{u"endpoint"_s, endpoint}});
+
+    Http::Response response {.headers = commonHeaders};
+    response.headers.insert(Http::HEADER_CONTENT_TYPE, Http::CONTENT_TYPE_PROMETHEUS);
+    response.content = BitTorrent::Session::instance()->metrics() + writer.data();
+    responseWriter.setResponse(response);
+}
+
 QString WebApplication::clientId() const
 {
     return m_clientAddress.toString();
@@ -768,7 +895,7 @@ void WebApplication::setSessionCookie(Http::HeaderMap &headers)
     }
 }
 
-void WebApplication::cookieSessionInitialize(const QString &authScheme, const QString &authData)
+bool WebApplication::cookieSessionInitialize(const QString &authScheme, const QString &authData)
 {
     Q_ASSERT(!m_currentSession);
 
@@ -779,7 +906,7 @@ void WebApplication::cookieSessionInitialize(const QString &authScheme, const QS
         {
             Q_ASSERT(session->type() == WebSessionType::CookieBased);
             if (session->type() != WebSessionType::CookieBased) [[unlikely]]
-                return;
+                return true;
 
             if (!session->hasExpired(m_sessionTimeout))
             {
@@ -802,12 +929,26 @@ void WebApplication::cookieSessionInitialize(const QString &authScheme, const QS
         }
         else if (authScheme.compare(BASIC_AUTH, Qt::CaseInsensitive) == 0)
         {
-            if (!validateBasicAuth(authData))
-                throw UnauthorizedHTTPError();
+            const auto verifiedCredentialsIter = m_verifiedCredentials.find(basicAuthDigest(authData));
+            if ((verifiedCredentialsIter == m_verifiedCredentials.end()) || verifiedCredentialsIter->expiration.hasExpired())
+                return false;
 
-            sessionStart();
+            // reuse the session of the same credentials and client
+            WebSession *session = m_sessions.value(verifiedCredentialsIter->sessionId);
+            if (session && !session->hasExpired(m_sessionTimeout))
+            {
+                m_currentSession = session;
+                m_currentSession->updateTimestamp();
+            }
+            else
+            {
+                sessionStart();
+                verifiedCredentialsIter->sessionId = m_currentSession->id();
+            }
         }
     }
+
+    return true;
 }
 
 void WebApplication::apiKeySessionInitialize(const QString &apiKey)
@@ -861,7 +1002,7 @@ bool WebApplication::isAuthNeeded()
 
 bool WebApplication::isPublicAPI(const QString &scope, const QString &action) const
 {
-    return m_publicAPIs.contains(u"%1/%2"_s.arg(scope, action));
+    return m_publicAPIs.contains({scope, action});
 }
 
 void WebApplication::sessionStart()
@@ -889,7 +1030,12 @@ void WebApplication::sessionStartImpl(const QString &sessionId, const WebSession
     m_sessions[m_currentSession->id()] = m_currentSession;
     m_sessionStateChange = SessionStateChange::Start;
 
-    m_currentSession->registerAPIController(u"app"_s, [app = app(), parent = m_currentSession] { return new AppController(app, parent); });
+    m_currentSession->registerAPIController(u"app"_s
+            , [app = app(), parent = m_currentSession, apiMetrics = &m_apiMetrics]
+    {
+        return new AppController(apiMetrics, app, parent);
+    });
+    m_currentSession->registerAPIController(u"batch"_s, [app = app(), parent = m_currentSession] { return new BatchController(parent, app, parent); });
     m_currentSession->registerAPIController(u"log"_s, [app = app(), parent = m_currentSession] { return new LogController(app, parent); });
     m_currentSession->registerAPIController(u"rss"_s, [app = app(), parent = m_currentSession] { return new RSSController(app, parent); });
     m_currentSession->registerAPIController(u"search"_s, [app = app(), parent = m_currentSession] { return new SearchController(app, parent); });
@@ -911,6 +1057,7 @@ void WebApplication::sessionStartImpl(const QString &sessionId, const WebSession
         auto *syncController = new SyncController(app, parent);
         syncController->updateFreeDiskSpace(btSession->freeDiskSpace());
         connect(btSession, &BitTorrent::Session::freeDiskSpaceChecked, syncController, &SyncController::updateFreeDiskSpace);
+        connect(syncController, &SyncController::maindataStreamEventSent, parent, &WebSession::updateTimestamp);
         return syncController;
     });
 }
@@ -1063,17 +1210,22 @@ QHostAddress WebApplication::resolveClientAddress() const
     return m_env.clientAddress;
 }
 
-bool WebApplication::validateCredentials(const QStringView username, const QStringView password) const
+void WebApplication::checkBanned(const QStringView username) const
 {
-    const QString clientAddr = clientId();
-
     if (isBanned())
     {
         LogMsg(tr("WebAPI login failure. Reason: IP has been banned, IP: %1, username: %2")
-                .arg(clientAddr, username)
+                .arg(clientId(), username)
             , Log::WARNING);
         throw ForbiddenHTTPError(tr("Your IP address has been banned after too many failed authentication attempts."));
     }
+}
+
+bool WebApplication::validateCredentials(const QStringView username, const QStringView password) const
+{
+    const QString clientAddr = clientId();
+
+    checkBanned(username);
 
     const bool usernameEqual = Utils::Password::slowEquals(username.toUtf8(), m_username.toUtf8());
     const bool passwordEqual = Utils::Password::PBKDF2::verify(m_passwordHash, password);
@@ -1085,8 +1237,7 @@ bool WebApplication::validateCredentials(const QStringView username, const QStri
         return true;
     }
 
-    const auto *pref = Preferences::instance();
-    if (pref->getWebUIMaxAuthFailCount() > 0)
+    if (Preferences::instance()->snapshot()->webUIMaxAuthFailCount > 0)
         increaseFailedAttempts();
 
     LogMsg(tr("WebAPI login failure. Reason: invalid credentials, attempt count: %1, IP: %2, username: %3")
@@ -1095,18 +1246,151 @@ bool WebApplication::validateCredentials(const QStringView username, const QStri
     return false;
 }
 
-bool WebApplication::validateBasicAuth(const QStringView credentials) const
+QByteArray WebApplication::basicAuthDigest(const QString &credentials) const
+{
+    // credentials are bound to the client so that each client gets its own session
+    const QByteArray message = clientId().toLatin1() + '\n' + credentials.toLatin1();
+    return QMessageAuthenticationCode::hash(message, m_basicAuthDigestKey, QCryptographicHash::Sha256);
+}
+
+void WebApplication::verifyBasicAuth(const QString &credentials, const Http::Request &request, const Http::Environment &env, Http::ResponseWriter &responseWriter)
 {
     const QString decodedCredentials = QString::fromUtf8(QByteArray::fromBase64(credentials.toLatin1()));
-    const auto usernamePassword = QStringView(decodedCredentials);
-    if (const qsizetype idx = usernamePassword.indexOf(u':'); idx > 0)
+    const qsizetype idx = decodedCredentials.indexOf(u':');
+    if (idx <= 0)
+        throw UnauthorizedHTTPError();
+
+    const QString username = decodedCredentials.first(idx);
+    checkBanned(username);
+
+    const QString clientAddr = clientId();
+    const PendingVerifications pendingVerifications = m_pendingVerifications.value(clientAddr);
+    if ((m_deferredRequestsCount >= MAX_DEFERRED_REQUESTS)
+        || (pendingVerifications.requestsCount >= MAX_DEFERRED_REQUESTS_PER_CLIENT))
     {
-        const QStringView username = usernamePassword.first(idx);
-        const QStringView password = usernamePassword.sliced(idx + 1);
-        return validateCredentials(username, password);
+        throw TooManyRequestsHTTPError(tr("Too many requests are waiting for authentication."));
     }
 
-    return false;
+    const QByteArray digest = basicAuthDigest(credentials);
+    const bool isVerifying = m_deferredRequests.contains(digest);
+    if (!isVerifying)
+    {
+        // verifications in progress are counted as failed attempts
+        // so that the limit can't be bypassed by sending many guesses at once
+        const int maxAuthFailCount = Preferences::instance()->snapshot()->webUIMaxAuthFailCount;
+        if ((maxAuthFailCount > 0) && ((failedAttemptsCount() + pendingVerifications.jobsCount) >= maxAuthFailCount))
+        {
+            LogMsg(tr("WebAPI login failure. Reason: too many authentication attempts in progress, IP: %1, username: %2")
+                    .arg(clientAddr, username)
+                , Log::WARNING);
+            throw TooManyRequestsHTTPError(tr("Too many authentication attempts are in progress."));
+        }
+    }
+
+    m_deferredRequests[digest].append({.request = request, .env = env, .clientAddress = m_clientAddress, .responseWriter = &responseWriter});
+    ++m_deferredRequestsCount;
+    PendingVerifications &clientPendingVerifications = m_pendingVerifications[clientAddr];
+    ++clientPendingVerifications.requestsCount;
+    if (isVerifying)
+        return;  // the same credentials are being verified already
+
+    ++clientPendingVerifications.jobsCount;
+    m_credentialsVerifier->start([this, digest, username, password = decodedCredentials.sliced(idx + 1)
+            , expectedUsername = m_username, passwordHash = m_passwordHash, credentialsVersion = m_credentialsVersion]
+    {
+        const bool usernameEqual = Utils::Password::slowEquals(username.toUtf8(), expectedUsername.toUtf8());
+        const bool passwordEqual = Utils::Password::PBKDF2::verify(passwordHash, password);
+        QMetaObject::invokeMethod(this, [this, digest, username, credentialsVersion, isValid = (usernameEqual && passwordEqual)]
+        {
+            onBasicAuthVerified(digest, username, credentialsVersion, isValid);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void WebApplication::onBasicAuthVerified(const QByteArray &digest, const QString &username, const int credentialsVersion, const bool isValid)
+{
+    const QList<DeferredRequest> deferredRequests = m_deferredRequests.take(digest);
+    if (deferredRequests.isEmpty()) [[unlikely]]
+        return;
+
+    // credentials are bound to the client so all the requests come from the same one
+    m_clientAddress = deferredRequests.first().clientAddress;
+    const QString clientAddr = clientId();
+
+    m_deferredRequestsCount -= deferredRequests.size();
+    if (const auto iter = m_pendingVerifications.find(clientAddr); iter != m_pendingVerifications.end())
+    {
+        --iter->jobsCount;
+        iter->requestsCount -= deferredRequests.size();
+        if (iter->jobsCount <= 0)
+            m_pendingVerifications.erase(iter);
+    }
+
+    const auto sendError = [this, &deferredRequests](const HTTPError &error)
+    {
+        for (const DeferredRequest &deferredRequest : deferredRequests)
+        {
+            if (!deferredRequest.responseWriter)
+                continue;
+
+            Http::Response response {.status = error.status(), .headers = m_prebuiltHeaders};
+            response.headers.insert(Http::HEADER_CONTENT_TYPE, Http::CONTENT_TYPE_TXT);
+            response.content = (!error.message().isEmpty() ? error.message() : error.status().text).toUtf8();
+            deferredRequest.responseWriter->setResponse(response);
+        }
+    };
+
+    // credentials were changed meanwhile so the requests need to be verified again
+    if (credentialsVersion != m_credentialsVersion)
+    {
+        for (const DeferredRequest &deferredRequest : deferredRequests)
+        {
+            if (deferredRequest.responseWriter)
+                processRequest(deferredRequest.request, deferredRequest.env, *deferredRequest.responseWriter);
+        }
+        return;
+    }
+
+    // client could get banned by other attempts while these credentials were being verified
+    if (isBanned())
+    {
+        LogMsg(tr("WebAPI login failure. Reason: IP has been banned, IP: %1, username: %2")
+                .arg(clientAddr, username)
+            , Log::WARNING);
+        sendError(ForbiddenHTTPError(tr("Your IP address has been banned after too many failed authentication attempts.")));
+        return;
+    }
+
+    if (isValid)
+    {
+        Algorithm::removeIf(m_verifiedCredentials, [this](const QByteArray &, const VerifiedCredentials &verifiedCredentials)
+        {
+            return verifiedCredentials.expiration.hasExpired() && !m_sessions.contains(verifiedCredentials.sessionId);
+        });
+
+        m_verifiedCredentials[digest].expiration = QDeadlineTimer(VERIFIED_CREDENTIALS_TTL);
+        m_clientFailedLogins.remove(clientAddr);
+        LogMsg(tr("WebAPI login success. IP: %1").arg(clientAddr));
+
+        for (const DeferredRequest &deferredRequest : deferredRequests)
+        {
+            if (deferredRequest.responseWriter)
+                processRequest(deferredRequest.request, deferredRequest.env, *deferredRequest.responseWriter);
+        }
+        return;
+    }
+
+    for (qsizetype i = 0; i < deferredRequests.size(); ++i)
+    {
+        if (Preferences::instance()->snapshot()->webUIMaxAuthFailCount > 0)
+            increaseFailedAttempts();
+
+        LogMsg(tr("WebAPI login failure. Reason: invalid credentials, attempt count: %1, IP: %2, username: %3")
+                .arg(QString::number(failedAttemptsCount()), clientAddr, username)
+            , Log::WARNING);
+    }
+
+    sendError(UnauthorizedHTTPError());
 }
 
 bool WebApplication::isBanned() const
@@ -1132,15 +1416,16 @@ int WebApplication::failedAttemptsCount() const
 
 void WebApplication::increaseFailedAttempts() const
 {
-    Q_ASSERT(Preferences::instance()->getWebUIMaxAuthFailCount() > 0);
+    const std::shared_ptr<const Preferences::Snapshot> pref = Preferences::instance()->snapshot();
+    Q_ASSERT(pref->webUIMaxAuthFailCount > 0);
 
     FailedLogin &failedLogin = m_clientFailedLogins[clientId()];
     ++failedLogin.failedAttemptsCount;
 
-    if (failedLogin.failedAttemptsCount >= Preferences::instance()->getWebUIMaxAuthFailCount())
+    if (failedLogin.failedAttemptsCount >= pref->webUIMaxAuthFailCount)
     {
         // Max number of failed attempts reached
         // Start ban period
-        failedLogin.banTimer.setRemainingTime(Preferences::instance()->getWebUIBanDuration());
+        failedLogin.banTimer.setRemainingTime(pref->webUIBanDuration);
     }
 }
@@ -40,6 +40,7 @@
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 #include <QRegularExpression>
 #include <QSet>
 #include <QTranslator>
@@ -50,10 +51,12 @@
 #include "base/http/headermap.h"
 #include "base/http/irequesthandler.h"
 #include "base/http/request.h"
+#include "base/http/responsewriter.h"
 #include "base/path.h"
 #include "base/utils/net.h"
 #include "base/utils/version.h"
 #include "api/isessionmanager.h"
+#include "apimetrics.h"
 
 using namespace std::chrono_literals;
 using namespace Qt::Literals::StringLiterals;
@@ -61,6 +64,7 @@ using namespace Qt::Literals::StringLiterals;
 inline const Utils::Version<3, 2> API_VERSION {2, 16, 0};
 
 class QNetworkCookie;
+class QThreadPool;
 
 class APIController;
 class AuthController;
@@ -102,17 +106,19 @@ private:
     void processAPIRequest(const QString &endpoint, const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter);
     void configure();
 
-    void declarePublicAPI(const QString &apiPath);
+    void declarePublicAPI(const QString &scope, const QString &action);
 
     void sendFile(const Path &path, const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter);
     void sendWebUIFile(const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter);
+    void sendMetrics(const Http::HeaderMap &commonHeaders, Http::ResponseWriter &responseWriter);
 
     void translateDocument(QString &data) const;
 
     // Session management
     QString generateSid() const;
     void setSessionCookie(Http::HeaderMap &headers);
-    void cookieSessionInitialize(const QString &authScheme, const QString &authData);
+    // returns false if Basic auth credentials have to be verified first
+    bool cookieSessionInitialize(const QString &authScheme, const QString &authData);
     void apiKeySessionInitialize(const QString &apiKey);
     bool isAuthNeeded();
     bool isPublicAPI(const QString &scope, const QString &action) const;
@@ -122,7 +128,10 @@ private:
     bool validateHostHeader() const;
 
     bool validateCredentials(QStringView username, QStringView password) const override;
-    bool validateBasicAuth(QStringView credentials) const;
+    QByteArray basicAuthDigest(const QString &credentials) const;
+    void verifyBasicAuth(const QString &credentials, const Http::Request &request, const Http::Environment &env, Http::ResponseWriter &responseWriter);
+    void onBasicAuthVerified(const QByteArray &digest, const QString &username, int credentialsVersion, bool isValid);
+    void checkBanned(QStringView username) const;
     bool isBanned() const;
     int failedAttemptsCount() const;
     void increaseFailedAttempts() const;
@@ -148,18 +157,20 @@ private:
 
     SessionStateChange m_sessionStateChange = SessionStateChange::None;
 
-    QSet<QString> m_publicAPIs;
+    QSet<std::pair<QString, QString>> m_publicAPIs;
     const QHash<std::pair<QString, QString>, QString> m_allowedMethod =
     {
         // <<controller name, action name>, HTTP method>
         {{u"app"_s, u"deleteAPIKey"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"app"_s, u"rotateAPIKey"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"app"_s, u"sendTestEmail"_s}, Http::HEADER_REQUEST_METHOD_POST},
+        {{u"app"_s, u"setBandwidthRules"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"app"_s, u"setCookies"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"app"_s, u"setPreferences"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"app"_s, u"shutdown"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"auth"_s, u"login"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"auth"_s, u"logout"_s}, Http::HEADER_REQUEST_METHOD_POST},
+        {{u"batch"_s, u"execute"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"clientdata"_s, u"store"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"rss"_s, u"addFeed"_s}, Http::HEADER_REQUEST_METHOD_POST},
         {{u"rss"_s, u"addFolder"_s}, Http::HEADER_REQUEST_METHOD_POST},
@@ -258,6 +269,37 @@ private:
     QString m_username;
     QByteArray m_passwordHash;
 
+    // Basic auth credentials are verified asynchronously, verified ones are remembered for a short time
+    // so that scripts which don't keep cookies neither pay for verification nor start a new session each time
+    struct VerifiedCredentials
+    {
+        QDeadlineTimer expiration;
+        QString sessionId;
+    };
+
+    struct DeferredRequest
+    {
+        Http::Request request;
+        Http::Environment env;
+        QHostAddress clientAddress;
+        QPointer<Http::ResponseWriter> responseWriter;
+    };
+
+    QThreadPool *m_credentialsVerifier = nullptr;
+    const QByteArray m_basicAuthDigestKey;
+    int m_credentialsVersion = 0;
+    QHash<QByteArray, VerifiedCredentials> m_verifiedCredentials;
+    QHash<QByteArray, QList<DeferredRequest>> m_deferredRequests;
+    qsizetype m_deferredRequestsCount = 0;
+
+    // Number of credentials verification jobs and requests waiting for them per client
+    struct PendingVerifications
+    {
+        int jobsCount = 0;
+        qsizetype requestsCount = 0;
+    };
+    QHash<QString, PendingVerifications> m_pendingVerifications;
+
     // security related
     QList<QRegularExpression> m_serverDomains;
     bool m_isCSRFProtectionEnabled = true;
@@ -274,6 +316,7 @@ private:
 
     BitTorrent::TorrentCreationManager *m_torrentCreationManager = nullptr;
     ClientDataStorage *m_clientDataStorage = nullptr;
+    APIMetrics m_apiMetrics;
 
     struct FailedLogin
     {
@@ -94,7 +94,7 @@ void WebUI::configure()
         if (!m_httpServer)
         {
             m_webapp = new WebApplication(app(), this);
-            m_httpServer = new Http::Server(m_webapp, this);
+            m_httpServer = new Http::Server(m_webapp, pref->getWebUINetworkThreads(), this);
         }
         else
         {
@@ -0,0 +1,111 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/entry.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+#include <QList>
+#include <QObject>
+#include <QTest>
+
+#include "base/bittorrent/torrentinfo.h"
+
+namespace
+{
+    BitTorrent::TorrentInfo makeTorrentInfo(const QList<qlonglong> &fileSizes, const int pieceLength)
+    {
+        lt::entry::list_type files;
+        qlonglong totalSize = 0;
+        for (qsizetype i = 0; i < fileSizes.size(); ++i)
+        {
+            lt::entry file;
+            file["length"] = lt::entry::integer_type(fileSizes[i]);
+            file["path"] = lt::entry::list_type {lt::entry("file" + std::to_string(i))};
+            files.push_back(file);
+            totalSize += fileSizes[i];
+        }
+
+        const qlonglong piecesCount = (totalSize + pieceLength - 1) / pieceLength;
+
+        lt::entry torrent;
+        lt::entry &info = torrent["info"];
+        info["name"] = "test";
+        info["piece length"] = lt::entry::integer_type(pieceLength);
+        info["pieces"] = std::string((piecesCount * 20), '\0');
+        info["files"] = files;
+
+        std::vector<char> buffer;
+        lt::bencode(std::back_inserter(buffer), torrent);
+        return BitTorrent::TorrentInfo(lt::torrent_info(buffer, lt::from_span));
+    }
+}
+
+class BenchBittorrentTorrentInfo final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(BenchBittorrentTorrentInfo)
+
+public:
+    BenchBittorrentTorrentInfo() = default;
+
+private slots:
+    void benchmarkPieceFileIndexes_data() const
+    {
+        QTest::addColumn<QList<qlonglong>>("fileSizes");
+        QTest::addColumn<int>("pieceLength");
+
+        QTest::newRow("many tiny files") << QList<qlonglong>(100'000, 1000) << (4 * 1024 * 1024);
+        QTest::newRow("few huge files") << QList<qlonglong>(4, (4LL * 1024 * 1024 * 1024)) << (256 * 1024);
+    }
+
+    void benchmarkPieceFileIndexes() const
+    {
+        QFETCH(const QList<qlonglong>, fileSizes);
+        QFETCH(const int, pieceLength);
+
+        const BitTorrent::TorrentInfo info = makeTorrentInfo(fileSizes, pieceLength);
+        const int piecesCount = info.piecesCount();
+
+        std::size_t totalFiles = 0;
+        QBENCHMARK
+        {
+            for (int piece = 0; piece < piecesCount; ++piece)
+                totalFiles += info.pieceFileIndexes(piece).size();
+        }
+        QVERIFY(totalFiles >= static_cast<std::size_t>(piecesCount));
+    }
+};
+
+QTEST_APPLESS_MAIN(BenchBittorrentTorrentInfo)
+#include "benchbittorrenttorrentinfo.moc"
@@ -0,0 +1,160 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "base/bittorrent/compactpathlist.h"
+#include "base/global.h"
+#include "base/path.h"
+
+using BitTorrent::CompactPathList;
+
+class TestBittorrentCompactPathList final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentCompactPathList)
+
+public:
+    TestBittorrentCompactPathList() = default;
+
+private slots:
+    void testEmpty() const
+    {
+        const CompactPathList list;
+        QVERIFY(list.isEmpty());
+        QCOMPARE(list.size(), 0);
+        QVERIFY(list.toList().isEmpty());
+    }
+
+    void testAt() const
+    {
+        CompactPathList list;
+        list.append(Path(u"file.txt"_s));
+        list.append(Path(u"folder/file1.txt"_s));
+        list.append(Path(u"folder/sub/file2.txt"_s));
+        list.append(Path(u"folder/file3.txt"_s));
+
+        QCOMPARE(list.size(), 4);
+        QCOMPARE_EQ(list.at(0), Path(u"file.txt"_s));
+        QCOMPARE_EQ(list.at(1), Path(u"folder/file1.txt"_s));
+        QCOMPARE_EQ(list.at(2), Path(u"folder/sub/file2.txt"_s));
+        QCOMPARE_EQ(list.at(3), Path(u"folder/file3.txt"_s));
+    }
+
+    void testRoundTrip() const
+    {
+        const PathList paths {Path(u"a/b/c.txt"_s), Path(u"a/d.txt"_s), Path(u"e.txt"_s), Path(u"a/b/f.txt"_s)};
+
+        CompactPathList list;
+        list.reserve(paths.size());
+        for (const Path &path : paths)
+            list.append(path);
+
+        QCOMPARE_EQ(list.toList(), paths);
+        list.append(Path(u"g/h.txt"_s));
+        QCOMPARE_EQ(list.toList(), (PathList {Path(u"a/b/c.txt"_s), Path(u"a/d.txt"_s), Path(u"e.txt"_s)
+                , Path(u"a/b/f.txt"_s), Path(u"g/h.txt"_s)}));
+        QCOMPARE_EQ(list.at(4), Path(u"g/h.txt"_s));
+
+        list.clear();
+        QVERIFY(list.isEmpty());
+        QVERIFY(list.toList().isEmpty());
+    }
+
+    void testReplace() const
+    {
+        CompactPathList list;
+        list.append(Path(u"folder/file1.txt"_s));
+        list.append(Path(u"folder/file2.txt"_s));
+        list.append(Path(u"other/file3.txt"_s));
+
+        list.replace(0, Path(u"folder/renamed.txt"_s));
+        QCOMPARE_EQ(list.at(0), Path(u"folder/renamed.txt"_s));
+        QCOMPARE_EQ(list.at(1), Path(u"folder/file2.txt"_s));
+
+        // moving the only file out of a folder leaves the folder unused
+        list.replace(2, Path(u"moved/file3.txt"_s));
+        QCOMPARE_EQ(list.at(2), Path(u"moved/file3.txt"_s));
+
+        list.replace(1, Path(u"file2.txt"_s));
+        QCOMPARE_EQ(list.toList(), (PathList {Path(u"folder/renamed.txt"_s), Path(u"file2.txt"_s), Path(u"moved/file3.txt"_s)}));
+
+        list.replace(1, Path(u"folder/file2.txt"_s));
+        QCOMPARE_EQ(list.at(1), Path(u"folder/file2.txt"_s));
+    }
+
+    void testFindRootFolder() const
+    {
+        CompactPathList list;
+        QVERIFY(list.findRootFolder().isEmpty());
+
+        list.append(Path(u"root/a/b.txt"_s));
+        list.append(Path(u"root/c.txt"_s));
+        QCOMPARE_EQ(list.findRootFolder(), Path(u"root"_s));
+        QCOMPARE_EQ(list.findRootFolder(), Path::findRootFolder(list.toList()));
+
+        list.append(Path(u"other/d.txt"_s));
+        QVERIFY(list.findRootFolder().isEmpty());
+
+        // folders left unused by renames don't count
+        list.replace(2, Path(u"root/d.txt"_s));
+        QCOMPARE_EQ(list.findRootFolder(), Path(u"root"_s));
+
+        list.replace(2, Path(u"d.txt"_s));
+        QVERIFY(list.findRootFolder().isEmpty());
+    }
+
+    void testReplaceMany() const
+    {
+        CompactPathList list;
+        for (int i = 0; i < 100; ++i)
+            list.append(Path(u"folder%1/file%2.txt"_s.arg(i % 10).arg(i)));
+
+        // renames trigger compaction of both names and folders several times
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 100; ++i)
+                list.replace(i, Path(u"round%1/folder%2/file%3.txt"_s.arg(round).arg(i % 10).arg(i)));
+        }
+
+        QCOMPARE(list.size(), 100);
+        for (int i = 0; i < 100; ++i)
+            QCOMPARE_EQ(list.at(i), Path(u"round2/folder%1/file%2.txt"_s.arg(i % 10).arg(i)));
+
+        const qint64 memoryUsage = list.memoryUsage();
+        CompactPathList freshList;
+        for (int i = 0; i < 100; ++i)
+            freshList.append(Path(u"round2/folder%1/file%2.txt"_s.arg(i % 10).arg(i)));
+        // stale data is released on compaction so usage stays within a small factor of a fresh list
+        QVERIFY(memoryUsage < (freshList.memoryUsage() * 4));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestBittorrentCompactPathList)
+#include "testbittorrentcompactpathlist.moc"
@@ -0,0 +1,106 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/entry.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+#include <QList>
+#include <QObject>
+#include <QTest>
+
+#include "base/bittorrent/torrentinfo.h"
+
+namespace
+{
+    BitTorrent::TorrentInfo makeTorrentInfo(const QList<qlonglong> &fileSizes, const int pieceLength)
+    {
+        lt::entry::list_type files;
+        qlonglong totalSize = 0;
+        for (qsizetype i = 0; i < fileSizes.size(); ++i)
+        {
+            lt::entry file;
+            file["length"] = lt::entry::integer_type(fileSizes[i]);
+            file["path"] = lt::entry::list_type {lt::entry("file" + std::to_string(i))};
+            files.push_back(file);
+            totalSize += fileSizes[i];
+        }
+
+        const qlonglong piecesCount = (totalSize + pieceLength - 1) / pieceLength;
+
+        lt::entry torrent;
+        lt::entry &info = torrent["info"];
+        info["name"] = "test";
+        info["piece length"] = lt::entry::integer_type(pieceLength);
+        info["pieces"] = std::string((piecesCount * 20), '\0');
+        info["files"] = files;
+
+        std::vector<char> buffer;
+        lt::bencode(std::back_inserter(buffer), torrent);
+        return BitTorrent::TorrentInfo(lt::torrent_info(buffer, lt::from_span));
+    }
+}
+
+class TestBittorrentTorrentInfo final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentTorrentInfo)
+
+public:
+    TestBittorrentTorrentInfo() = default;
+
+private slots:
+    void testPieceFileIndexes() const
+    {
+        const BitTorrent::TorrentInfo info = makeTorrentInfo({10000, 0, 20000, 100, (16384 * 2)}, 16384);
+        QCOMPARE(info.piecesCount(), 4);
+
+        const auto toList = [](const std::span<const int> span) { return QList<int>(span.begin(), span.end()); };
+        QCOMPARE(toList(info.pieceFileIndexes(0)), QList<int>({0, 2}));
+        QCOMPARE(toList(info.pieceFileIndexes(1)), QList<int>({2, 3, 4}));
+        QCOMPARE(toList(info.pieceFileIndexes(2)), QList<int>({4}));
+        QCOMPARE(toList(info.pieceFileIndexes(3)), QList<int>({4}));
+        QCOMPARE(info.fileIndicesForPiece(1), QList<int>({2, 3, 4}));
+
+        // out of range
+        QVERIFY(info.pieceFileIndexes(-1).empty());
+        QVERIFY(info.pieceFileIndexes(4).empty());
+        QVERIFY(BitTorrent::TorrentInfo().pieceFileIndexes(0).empty());
+
+        // copies share the same table
+        const BitTorrent::TorrentInfo copy = info;
+        QCOMPARE(copy.pieceFileIndexes(1).data(), info.pieceFileIndexes(1).data());
+    }
+};
+
+QTEST_APPLESS_MAIN(TestBittorrentTorrentInfo)
+#include "testbittorrenttorrentinfo.moc"
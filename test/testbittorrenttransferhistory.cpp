@@ -0,0 +1,158 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2022  Mike Tzou (Chocobo1)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QTest>
+
+#include "base/bittorrent/transferhistory.h"
+#include "base/global.h"
+
+using BitTorrent::TransferHistory;
+
+namespace
+{
+    // aligned to an hour boundary
+    const qint64 BASE_TIME = 277778LL * 3600;
+    const qint64 BASE_MSECS = BASE_TIME * 1000;
+}
+
+class TestBittorrentTransferHistory final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentTransferHistory)
+
+public:
+    TestBittorrentTransferHistory() = default;
+
+private slots:
+    void testEmpty() const
+    {
+        const TransferHistory history;
+        QVERIFY(history.seriesNames().isEmpty());
+        QVERIFY(history.samples(u"session"_s, TransferHistory::Resolution::Second).isEmpty());
+    }
+
+    void testRecord() const
+    {
+        TransferHistory history;
+        history.record(u"session"_s, BASE_MSECS, (BASE_MSECS + 2000), {.download = 2000, .upload = 1000});
+        QCOMPARE(history.seriesNames(), QStringList {u"session"_s});
+
+        const QList<TransferHistory::Sample> seconds = history.samples(u"session"_s, TransferHistory::Resolution::Second, BASE_TIME);
+        QCOMPARE(seconds.size(), 2);
+        QCOMPARE(seconds[0].time, BASE_TIME);
+        QCOMPARE(seconds[0].rates.download, 1000);
+        QCOMPARE(seconds[0].rates.upload, 500);
+        QCOMPARE(seconds[1].time, (BASE_TIME + 1));
+        QCOMPARE(seconds[1].rates.download, 1000);
+        QCOMPARE(seconds[1].rates.upload, 500);
+
+        const QList<TransferHistory::Sample> minutes = history.samples(u"session"_s, TransferHistory::Resolution::Minute, BASE_TIME);
+        QCOMPARE(minutes.size(), 1);
+        QCOMPARE(minutes[0].time, BASE_TIME);
+        QCOMPARE(minutes[0].rates.download, (2000 / 60));
+
+        const QList<TransferHistory::Sample> hours = history.samples(u"session"_s, TransferHistory::Resolution::Hour, BASE_TIME);
+        QCOMPARE(hours.size(), 1);
+        QCOMPARE(hours[0].rates.upload, 0);
+    }
+
+    void testSpreadAcrossBuckets() const
+    {
+        TransferHistory history;
+        history.record(u"session"_s, (BASE_MSECS + 500), (BASE_MSECS + 1500), {.download = 1001, .upload = 0});
+        history.record(u"session"_s, (BASE_MSECS + 1500), (BASE_MSECS + 2000), {.download = 500, .upload = 0});
+
+        const QList<TransferHistory::Sample> seconds = history.samples(u"session"_s, TransferHistory::Resolution::Second, BASE_TIME);
+        QCOMPARE(seconds.size(), 2);
+        QCOMPARE(seconds[0].rates.download + seconds[1].rates.download, 1501);
+        QCOMPARE(seconds[0].rates.download, 500);
+    }
+
+    void testGap() const
+    {
+        TransferHistory history;
+        history.record(u"session"_s, BASE_MSECS, (BASE_MSECS + 1000), {.download = 100, .upload = 100});
+        history.record(u"session"_s, (BASE_MSECS + 2 * 3600 * 1000), (BASE_MSECS + 2 * 3600 * 1000 + 1000), {.download = 10, .upload = 10});
+
+        const QList<TransferHistory::Sample> seconds = history.samples(u"session"_s, TransferHistory::Resolution::Second);
+        QCOMPARE(seconds.size(), 3600);
+        QCOMPARE(seconds.last().time, (BASE_TIME + 2 * 3600));
+        QCOMPARE(seconds.last().rates.download, 10);
+        QCOMPARE(seconds.first().rates.download, 0);
+
+        const QList<TransferHistory::Sample> hours = history.samples(u"session"_s, TransferHistory::Resolution::Hour, BASE_TIME);
+        QCOMPARE(hours.size(), 3);
+        QCOMPARE(hours[0].rates.download, (100 / 3600));
+        QCOMPARE(hours[1].rates.download, 0);
+    }
+
+    void testSince() const
+    {
+        TransferHistory history;
+        history.record(u"session"_s, BASE_MSECS, (BASE_MSECS + 10'000), {.download = 10, .upload = 10});
+
+        const QList<TransferHistory::Sample> seconds = history.samples(u"session"_s, TransferHistory::Resolution::Second, (BASE_TIME + 7));
+        QCOMPARE(seconds.size(), 3);
+        QCOMPARE(seconds.first().time, (BASE_TIME + 7));
+    }
+
+    void testSerialization() const
+    {
+        TransferHistory history;
+        history.record(u"session"_s, BASE_MSECS, (BASE_MSECS + 90'000), {.download = 9000, .upload = 900});
+        history.record(u"category:linux"_s, BASE_MSECS, (BASE_MSECS + 1000), {.download = 5, .upload = 0});
+
+        TransferHistory restored;
+        QVERIFY(restored.deserialize(history.serialize()));
+        QCOMPARE(restored.seriesNames().size(), 2);
+
+        for (const TransferHistory::Resolution resolution
+             : {TransferHistory::Resolution::Second, TransferHistory::Resolution::Minute, TransferHistory::Resolution::Hour})
+        {
+            const QList<TransferHistory::Sample> expected = history.samples(u"session"_s, resolution);
+            const QList<TransferHistory::Sample> actual = restored.samples(u"session"_s, resolution);
+            QCOMPARE(actual.size(), expected.size());
+            for (qsizetype i = 0; i < expected.size(); ++i)
+            {
+                QCOMPARE(actual[i].time, expected[i].time);
+                QCOMPARE(actual[i].rates.download, expected[i].rates.download);
+                QCOMPARE(actual[i].rates.upload, expected[i].rates.upload);
+            }
+        }
+
+        QVERIFY(!restored.deserialize(QByteArray("garbage")));
+        QCOMPARE(restored.seriesNames().size(), 2);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestBittorrentTransferHistory)
+#include "testbittorrenttransferhistory.moc"
@@ -0,0 +1,82 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2022  Mike Tzou (Chocobo1)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QByteArray>
+#include <QObject>
+#include <QTest>
+
+#include "base/global.h"
+#include "base/utils/prometheus.h"
+
+class TestUtilsPrometheus final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestUtilsPrometheus)
+
+public:
+    TestUtilsPrometheus() = default;
+
+private slots:
+    void testTextWriter() const
+    {
+        Utils::Prometheus::TextWriter writer;
+        QVERIFY(writer.data().isEmpty());
+
+        writer.addMetric("test_requests_total", Utils::Prometheus::MetricType::Counter, "Number of requests");
+        writer.addSample("test_requests_total", qint64 {42});
+        writer.addSample("test_requests_total", qint64 {-1}, {{u"endpoint"_s, u"app/version"_s}, {u"method"_s, u"GET"_s}});
+        writer.addMetric("test_ratio", Utils::Prometheus::MetricType::Gauge, "Ratio");
+        writer.addSample("test_ratio", 0.25);
+
+        QCOMPARE(writer.data(), QByteArray(
+            "# HELP test_requests_total Number of requests\n"
+            "# TYPE test_requests_total counter\n"
+            "test_requests_total 42\n"
+            "test_requests_total{endpoint=\"app/version\",method=\"GET\"} -1\n"
+            "# HELP test_ratio Ratio\n"
+            "# TYPE test_ratio gauge\n"
+            "test_ratio 0.25\n"));
+    }
+
+    void testSanitizeName() const
+    {
+        QCOMPARE(Utils::Prometheus::sanitizeName("net.sent_bytes"), QByteArray("net_sent_bytes"));
+        QCOMPARE(Utils::Prometheus::sanitizeName("a-b c:d_1"), QByteArray("a_b_c:d_1"));
+        QCOMPARE(Utils::Prometheus::sanitizeName(""), QByteArray());
+    }
+
+    void testEscapeLabelValue() const
+    {
+        QCOMPARE(Utils::Prometheus::escapeLabelValue(u"plain"), QByteArray("plain"));
+        QCOMPARE(Utils::Prometheus::escapeLabelValue(u"a\"b\\c\nd"), QByteArray("a\\\"b\\\\c\\nd"));
+        QCOMPARE(Utils::Prometheus::escapeLabelValue(u"Linux ISOs/Ubuntu"), QByteArray("Linux ISOs/Ubuntu"));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestUtilsPrometheus)
+#include "testutilsprometheus.moc"
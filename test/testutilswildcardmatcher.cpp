@@ -0,0 +1,101 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2022  Mike Tzou (Chocobo1)
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QObject>
+#include <QStringList>
+#include <QTest>
+
+#include "base/global.h"
+#include "base/utils/wildcardmatcher.h"
+
+class TestUtilsWildcardMatcher final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestUtilsWildcardMatcher)
+
+public:
+    TestUtilsWildcardMatcher() = default;
+
+private slots:
+    void testEmpty() const
+    {
+        const Utils::WildcardMatcher matcher;
+        QVERIFY(matcher.isEmpty());
+        QVERIFY(!matcher.match(u"file.txt"));
+
+        QVERIFY(Utils::WildcardMatcher(QStringList()).isEmpty());
+        QVERIFY(!Utils::WildcardMatcher(QStringList {u"*.txt"_s}).isEmpty());
+    }
+
+    void testLiteral() const
+    {
+        const Utils::WildcardMatcher matcher {QStringList {u"Thumbs.db"_s, u"desktop.ini"_s}};
+        QVERIFY(matcher.match(u"Thumbs.db"));
+        QVERIFY(matcher.match(u"thumbs.DB"));
+        QVERIFY(matcher.match(u"Desktop.ini"));
+        QVERIFY(!matcher.match(u"Thumbs.db.bak"));
+        QVERIFY(!matcher.match(u"xThumbs.db"));
+    }
+
+    void testSuffix() const
+    {
+        const Utils::WildcardMatcher matcher {QStringList {u"*.txt"_s, u"*.!qB"_s}};
+        QVERIFY(matcher.match(u"readme.txt"));
+        QVERIFY(matcher.match(u"README.TXT"));
+        QVERIFY(matcher.match(u".txt"));
+        QVERIFY(matcher.match(u"file.!qb"));
+        QVERIFY(!matcher.match(u"readme.txt.exe"));
+        QVERIFY(!matcher.match(u"readmetxt"));
+
+        QVERIFY(Utils::WildcardMatcher(QStringList {u"*"_s}).match(u"anything"));
+    }
+
+    void testWildcards() const
+    {
+        const Utils::WildcardMatcher matcher {QStringList {u"sample?.mkv"_s, u"*sample*"_s, u"[ab]*.nfo"_s}};
+        QVERIFY(matcher.match(u"sample1.mkv"));
+        QVERIFY(!matcher.match(u"sample12.mkv"));
+        QVERIFY(matcher.match(u"Movie.SAMPLE.mkv"));
+        QVERIFY(matcher.match(u"a.nfo"));
+        QVERIFY(matcher.match(u"Best.nfo"));
+        QVERIFY(!matcher.match(u"c.nfo"));
+    }
+
+    void testMixed() const
+    {
+        const Utils::WildcardMatcher matcher {QStringList {u"Thumbs.db"_s, u"*.lnk"_s, u"~*.tmp"_s}};
+        QVERIFY(matcher.match(u"thumbs.db"));
+        QVERIFY(matcher.match(u"shortcut.LNK"));
+        QVERIFY(matcher.match(u"~file.tmp"));
+        QVERIFY(!matcher.match(u"file.tmp"));
+        QVERIFY(!matcher.match(u"video.mkv"));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestUtilsWildcardMatcher)
+#include "testutilswildcardmatcher.moc"